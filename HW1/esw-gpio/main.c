@@ -30,6 +30,9 @@
 
 #include "loggers_ext.h"
 #include "logger_fwrite.h"
+#include "log_async.h"
+#include "gpio_exti.h"
+#include "rtos_static.h"
 
 #include "em_cmu.h"
 #include "em_gpio.h"
@@ -59,7 +62,10 @@ INCBIN(Header, "header.bin");
 
 
 #define ESWGPIO_EXTI_INDEX      4 // External interrupt number 4.
-#define ESWGPIO_EXTI_IF         0x00000010UL // Interrupt flag for external interrupt number 4.
+
+#define ESWGPIO_HB_STACK_SIZE       1024    // Thread stacks, bytes
+#define ESWGPIO_BUZZER_STACK_SIZE   512
+#define ESWGPIO_BUTTON_STACK_SIZE   1024
 
 
 static void buzzer_loop (void *args);
@@ -67,8 +73,7 @@ static void button_loop (void *args);
 static osThreadId_t buttonThreadId;
 static const uint32_t buttonExtIntThreadFlag = 0x00000001;
 
-static void gpio_external_interrupt_init (GPIO_Port_TypeDef port, uint32_t pin, uint32_t exti_if, uint16_t exti_num);
-static void gpio_external_interrupt_enable (uint32_t if_exti);
+static void gpio_external_interrupt_init (GPIO_Port_TypeDef port, uint32_t pin, uint16_t exti_num);
 static uint16_t buttonPressed = 0;
 
 // Heartbeat thread, initialize GPIO and print heartbeat messages.
@@ -85,24 +90,32 @@ void hp_loop ()
     GPIO_PinModeSet(ESWGPIO_BUZZER_PORT, ESWGPIO_BUZZER_PIN, gpioModePushPull, 0);
     
     
-    const osThreadAttr_t buzzer_thread_attr = { .name = "buzz" };
-    osThreadNew(buzzer_loop, NULL, &buzzer_thread_attr);
+    RTOS_THREAD_STATIC(buzzerThread, ESWGPIO_BUZZER_STACK_SIZE);
+    const osThreadAttr_t buzzer_thread_attr = { .name = "buzz", RTOS_THREAD_MEM(buzzerThread) };
+    rtos_thread_new(buzzer_loop, NULL, &buzzer_thread_attr);
 
     
     // Configure button pin for external interrupts. 
-    gpio_external_interrupt_init(ESWGPIO_BUTTON_PORT, ESWGPIO_BUTTON_PIN, ESWGPIO_EXTI_IF, ESWGPIO_EXTI_INDEX);
+    gpio_external_interrupt_init(ESWGPIO_BUTTON_PORT, ESWGPIO_BUTTON_PIN, ESWGPIO_EXTI_INDEX);
     
     // Create thread for handling external interrupts.
-    const osThreadAttr_t button_thread_attr = { .name = "button" };
-    buttonThreadId = osThreadNew(button_loop, NULL, &button_thread_attr);
+    RTOS_THREAD_STATIC(buttonThread, ESWGPIO_BUTTON_STACK_SIZE);
+    const osThreadAttr_t button_thread_attr = { .name = "button", RTOS_THREAD_MEM(buttonThread) };
+    buttonThreadId = rtos_thread_new(button_loop, NULL, &button_thread_attr);
     
-    // Enanble external interrupts from button.
-    gpio_external_interrupt_enable(ESWGPIO_EXTI_IF);
+    // Enanble external interrupts from button, the interrupt resumes the button thread.
+    gpio_exti_register_flags(ESWGPIO_EXTI_INDEX, buttonThreadId, buttonExtIntThreadFlag);
+    gpio_exti_enable(ESWGPIO_EXTI_INDEX);
     
     for (;;)
     {
+        gpio_exti_stats_t exti;
+
         osDelay(ESWGPIO_HB_DELAY*osKernelGetTickFreq());
-        info1("Heartbeat");
+        gpio_exti_stats(&exti);
+        info1("Heartbeat, EXTI irqs %"PRIu32" spurious %"PRIu32", handler cycles mean %"PRIu32" max %"PRIu32,
+              exti.irqs, exti.spurious, exti.meanCycles, exti.maxCycles);
+        rtos_stack_report();
     }
 }
 
@@ -203,18 +216,23 @@ int main ()
 
     info1("ESW-GPIO "VERSION_STR" (%d.%d.%d)", VERSION_MAJOR, VERSION_MINOR, VERSION_PATCH);
 
+    // External interrupt dispatch, lines are registered by their users
+    gpio_exti_init();
+
     // Initialize OS kernel.
     osKernelInitialize();
 
     // Create a thread.
-    const osThreadAttr_t hp_thread_attr = { .name = "hb" };
-    osThreadNew(hp_loop, NULL, &hp_thread_attr);
+    RTOS_THREAD_STATIC(hbThread, ESWGPIO_HB_STACK_SIZE);
+    const osThreadAttr_t hp_thread_attr = { .name = "hb", RTOS_THREAD_MEM(hbThread) };
+    rtos_thread_new(hp_loop, NULL, &hp_thread_attr);
 
     if (osKernelReady == osKernelGetState())
     {
-        // Switch to a thread-safe logger
+        // Switch to a non-blocking logger, a low priority thread writes the records out
         logger_fwrite_init();
-        log_init(BASE_LOG_LEVEL, &logger_fwrite, NULL);
+        log_async_init(&logger_fwrite);
+        log_init(BASE_LOG_LEVEL, &log_async_write, NULL);
 
         // Start the kernel
         osKernelStart();
@@ -228,43 +246,16 @@ int main ()
 }
 
 /**
- * @brief Initialize GPIO port and pin for external interrupts and enable 
- * GPIO hardware interrupts (NVIC). 
+ * @brief Initialize GPIO port and pin for external interrupts, the interrupt is enabled with
+ * gpio_exti_enable().
  */
-static void gpio_external_interrupt_init (GPIO_Port_TypeDef port, uint32_t pin, uint32_t exti_if, uint16_t exti_num)
+static void gpio_external_interrupt_init (GPIO_Port_TypeDef port, uint32_t pin, uint16_t exti_num)
 {
     // Configure pin. Input with glitch filtering and pull-up.
     GPIO_PinModeSet(port, pin, gpioModeInputPullFilter, 1);
     
     // Configure external interrupts.
-    GPIO_IntDisable(exti_if); // Disable before config to avoid unwanted interrupt triggering.
+    gpio_exti_disable(exti_num); // Disable before config to avoid unwanted interrupt triggering.
     GPIO_ExtIntConfig(port, pin, exti_num, false, true, false); // Port, pin, EXTI number, rising edge, falling edge, enabled.
     GPIO_InputSenseSet(GPIO_INSENSE_INT, GPIO_INSENSE_INT);
 }
-
-static void gpio_external_interrupt_enable (uint32_t exti_if)
-{
-    GPIO_IntClear(exti_if);
-    
-    NVIC_EnableIRQ(GPIO_EVEN_IRQn);
-    NVIC_SetPriority(GPIO_EVEN_IRQn, 3);
-
-    GPIO_IntEnable(exti_if);
-}
-
-void GPIO_EVEN_IRQHandler (void)
-{
-    // Get all pending and enabled interrupts.
-    uint32_t pending = GPIO_IntGetEnabled();
-    
-    // Check if button interrupt is enabled
-    if (pending & ESWGPIO_EXTI_IF)
-    {
-        // Clear interrupt flag.
-        GPIO_IntClear(ESWGPIO_EXTI_IF);
-
-        // Trigger button thread to resume.
-        osThreadFlagsSet(buttonThreadId, buttonExtIntThreadFlag);
-    }
-    else ; // This was not a button interrupt.
-}
@@ -0,0 +1,263 @@
+/**
+ * @file gpio_exti.c
+ *
+ * @brief   Dispatcher for the GPIO external interrupts (EXTI lines 0...15).
+ *
+ * @details The handler reads the pending lines once, clears them with one write to GPIO_IFC
+ *          and serves them in a loop of count leading zeros and a table lookup, so a line
+ *          costs about the same whether it is the only one in use or one of many. An edge
+ *          that comes while its line is served sets the flag again and the handler runs
+ *          again, edges are not lost.
+ *
+ *          A table entry is written with interrupts disabled and the line is enabled after
+ *          it has been registered, the handler never sees a partly written entry.
+ *
+ * EFR32MG12 Wireless Gecko Reference Manual (GPIO p1105, EXTI p1114)
+ * https://www.silabs.com/documents/public/reference-manuals/efr32xg12-rm.pdf
+ *
+ * @author agent
+ * @license MIT
+ *
+ * Copyright agent, 2026
+ */
+
+#include "em_device.h"
+#include "em_core.h"
+#include "em_cmu.h"
+#include "em_gpio.h"
+
+#include "gpio_exti.h"
+#if GPIO_EXTI_STAMP
+#include "sample_time.h"
+#endif
+
+#define GPIO_EXTI_ODD_LINES     0xAAAAUL    // Odd lines raise GPIO_ODD_IRQn
+#define GPIO_EXTI_EVEN_LINES    0x5555UL    // Even lines raise GPIO_EVEN_IRQn
+
+typedef enum
+{
+    GPIO_EXTI_ACTION_NONE = 0,
+    GPIO_EXTI_ACTION_FLAGS,
+    GPIO_EXTI_ACTION_QUEUE,
+    GPIO_EXTI_ACTION_CALLBACK
+} gpio_exti_action_t;
+
+typedef struct
+{
+    union
+    {
+        osThreadId_t thread;
+        osMessageQueueId_t queue;
+        gpio_exti_cb_t cb;
+    } to;
+    uint32_t flags;     // Thread flags to set
+    uint8_t action;     // gpio_exti_action_t
+} gpio_exti_handler_t;
+
+static gpio_exti_handler_t handlers[GPIO_EXTI_LINES];
+
+// Updated by the handlers only, both run at the same priority
+static uint32_t irqCount;
+static uint32_t eventCount;
+static uint32_t spuriousCount;
+static uint32_t queueFullCount;
+static uint32_t cycleRuns;
+static uint32_t cycleTotal;
+static uint32_t cycleMax;
+
+/**
+ * @brief   Enable the GPIO clock and the cycle counter, clear the registration table.
+ */
+void gpio_exti_init (void)
+{
+    uint8_t line;
+
+    CMU_ClockEnable(cmuClock_GPIO, true);
+
+    // Cycle counter, enabling it again does not disturb other users
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+    for (line = 0; line < GPIO_EXTI_LINES; line++)
+    {
+        gpio_exti_unregister(line);
+    }
+}
+
+static int8_t gpio_exti_register (uint8_t line, const gpio_exti_handler_t * h)
+{
+    CORE_DECLARE_IRQ_STATE;
+
+    if (line >= GPIO_EXTI_LINES)
+    {
+        return -1;
+    }
+    CORE_ENTER_ATOMIC();
+    handlers[line] = *h;
+    CORE_EXIT_ATOMIC();
+    return 0;
+}
+
+/**
+ * @brief   Set thread flags of a thread on an edge of line (deferred interrupt handling).
+ *
+ * @return  -1 if line is not an EXTI line, 0 otherwise
+ */
+int8_t gpio_exti_register_flags (uint8_t line, osThreadId_t tID, uint32_t tFlags)
+{
+    gpio_exti_handler_t h = { .to.thread = tID, .flags = tFlags, .action = GPIO_EXTI_ACTION_FLAGS };
+
+    return gpio_exti_register(line, &h);
+}
+
+/**
+ * @brief   Put a gpio_exti_event_t into queue on an edge of line, the queue must be created
+ *          with that message size. Events that do not fit are counted and dropped.
+ *
+ * @return  -1 if line is not an EXTI line, 0 otherwise
+ */
+int8_t gpio_exti_register_queue (uint8_t line, osMessageQueueId_t queue)
+{
+    gpio_exti_handler_t h = { .to.queue = queue, .action = GPIO_EXTI_ACTION_QUEUE };
+
+    return gpio_exti_register(line, &h);
+}
+
+/**
+ * @brief   Call cb in interrupt context on an edge of line.
+ *
+ * @return  -1 if line is not an EXTI line, 0 otherwise
+ */
+int8_t gpio_exti_register_callback (uint8_t line, gpio_exti_cb_t cb)
+{
+    gpio_exti_handler_t h = { .to.cb = cb, .action = GPIO_EXTI_ACTION_CALLBACK };
+
+    return gpio_exti_register(line, &h);
+}
+
+void gpio_exti_unregister (uint8_t line)
+{
+    gpio_exti_handler_t h = { .action = GPIO_EXTI_ACTION_NONE };
+
+    gpio_exti_register(line, &h);
+}
+
+/**
+ * @brief   Enable interrupts from line, configured with GPIO_ExtIntConfig(). An edge from
+ *          before the call is discarded.
+ *
+ * @note    The EXTI number determines which ports and pins can be used (EFR32MG12 manual p1114,
+ *          GPIO application note p11-12) and the interrupt: odd numbers GPIO_ODD_IRQn, even
+ *          numbers GPIO_EVEN_IRQn.
+ */
+void gpio_exti_enable (uint8_t line)
+{
+    IRQn_Type irq = (line & 1) ? GPIO_ODD_IRQn : GPIO_EVEN_IRQn;
+
+    if (line >= GPIO_EXTI_LINES)
+    {
+        return;
+    }
+    GPIO_IntClear(GPIO_EXTI_FLAG(line));
+
+    NVIC_SetPriority(irq, GPIO_EXTI_IRQ_PRIORITY);
+    NVIC_EnableIRQ(irq);
+
+    GPIO_IntEnable(GPIO_EXTI_FLAG(line));
+}
+
+/**
+ * @brief   Disable interrupts from line, the interrupt stays enabled in NVIC for other lines.
+ */
+void gpio_exti_disable (uint8_t line)
+{
+    if (line < GPIO_EXTI_LINES)
+    {
+        GPIO_IntDisable(GPIO_EXTI_FLAG(line));
+    }
+}
+
+/**
+ * @brief   Handler counters since start, handler time since the previous call.
+ */
+void gpio_exti_stats (gpio_exti_stats_t * stats)
+{
+    CORE_DECLARE_IRQ_STATE;
+
+    CORE_ENTER_ATOMIC();
+    stats->irqs = irqCount;
+    stats->events = eventCount;
+    stats->spurious = spuriousCount;
+    stats->queueFull = queueFullCount;
+    stats->meanCycles = (cycleRuns > 0) ? cycleTotal / cycleRuns : 0;
+    stats->maxCycles = cycleMax;
+    cycleRuns = cycleTotal = cycleMax = 0;
+    CORE_EXIT_ATOMIC();
+}
+
+// Serve the pending lines of one interrupt, lines is the half that raises it
+static inline void gpio_exti_dispatch (uint32_t lines)
+{
+    uint32_t t0 = DWT->CYCCNT;
+#if GPIO_EXTI_STAMP
+    uint32_t stamp = sample_time_now();
+#else
+    uint32_t stamp = 0;
+#endif
+    uint32_t pending = GPIO_IntGetEnabled() & lines;
+    uint32_t cycles;
+
+    GPIO_IntClear(pending);
+    if (pending == 0)
+    {
+        spuriousCount++;
+    }
+    while (pending != 0)
+    {
+        uint32_t line = 31 - __CLZ(pending);
+        const gpio_exti_handler_t * h = &handlers[line];
+
+        pending &= ~GPIO_EXTI_FLAG(line);
+        switch (h->action)
+        {
+            case GPIO_EXTI_ACTION_FLAGS:
+                osThreadFlagsSet(h->to.thread, h->flags);
+                break;
+            case GPIO_EXTI_ACTION_QUEUE:
+            {
+                gpio_exti_event_t ev = { .stamp = stamp, .line = (uint8_t)line };
+
+                if (osMessageQueuePut(h->to.queue, &ev, 0, 0) != osOK)
+                {
+                    queueFullCount++;
+                }
+                break;
+            }
+            case GPIO_EXTI_ACTION_CALLBACK:
+                h->to.cb(stamp);
+                break;
+            default:
+                break;
+        }
+        eventCount++;
+    }
+    irqCount++;
+
+    cycles = DWT->CYCCNT - t0;
+    cycleRuns++;
+    cycleTotal += cycles;
+    if (cycles > cycleMax)
+    {
+        cycleMax = cycles;
+    }
+}
+
+void GPIO_ODD_IRQHandler (void)
+{
+    gpio_exti_dispatch(GPIO_EXTI_ODD_LINES);
+}
+
+void GPIO_EVEN_IRQHandler (void)
+{
+    gpio_exti_dispatch(GPIO_EXTI_EVEN_LINES);
+}
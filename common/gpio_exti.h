@@ -0,0 +1,70 @@
+/**
+ * @file gpio_exti.h
+ *
+ * @brief   Dispatcher for the GPIO external interrupts (EXTI lines 0...15).
+ *
+ * @details GPIO_ODD_IRQHandler() and GPIO_EVEN_IRQHandler() take the pending and enabled
+ *          lines of their half, clear them with one write and serve them highest line first,
+ *          found with count leading zeros. Each line has an entry in a registration table
+ *          with one action: set thread flags, put a gpio_exti_event_t into a message queue
+ *          or call a function in interrupt context. Handler time from entry to exit is
+ *          measured with the DWT cycle counter.
+ *
+ *          With GPIO_EXTI_STAMP=1 the handlers get sample_time_now() taken at interrupt
+ *          entry, otherwise the stamp is 0.
+ *
+ * EFR32MG12 Wireless Gecko Reference Manual (GPIO p1105, EXTI p1114)
+ * https://www.silabs.com/documents/public/reference-manuals/efr32xg12-rm.pdf
+ *
+ * @author agent
+ * @license MIT
+ *
+ * Copyright agent, 2026
+ */
+
+#ifndef GPIO_EXTI_H_
+#define GPIO_EXTI_H_
+
+#include <stdint.h>
+
+#include "cmsis_os2.h"
+
+#ifndef GPIO_EXTI_STAMP
+#define GPIO_EXTI_STAMP         0       // Set from the Makefile
+#endif
+
+#define GPIO_EXTI_LINES         16
+#define GPIO_EXTI_IRQ_PRIORITY  3
+#define GPIO_EXTI_FLAG(line)    (1UL << (line)) // Interrupt flag of an EXTI line
+
+// Called in interrupt context, it should only start work and return
+typedef void (*gpio_exti_cb_t)(uint32_t stamp);
+
+// Message put into a registered queue
+typedef struct
+{
+    uint32_t stamp;
+    uint8_t line;
+} gpio_exti_event_t;
+
+typedef struct
+{
+    uint32_t irqs;          // Handler runs
+    uint32_t events;        // Lines served
+    uint32_t spurious;      // Runs with no pending line
+    uint32_t queueFull;     // Events not put into a full queue
+    uint32_t meanCycles;    // Handler entry to exit, since the previous call
+    uint32_t maxCycles;
+} gpio_exti_stats_t;
+
+// Public functions
+void gpio_exti_init(void);
+int8_t gpio_exti_register_flags(uint8_t line, osThreadId_t tID, uint32_t tFlags);
+int8_t gpio_exti_register_queue(uint8_t line, osMessageQueueId_t queue);
+int8_t gpio_exti_register_callback(uint8_t line, gpio_exti_cb_t cb);
+void gpio_exti_unregister(uint8_t line);
+void gpio_exti_enable(uint8_t line);
+void gpio_exti_disable(uint8_t line);
+void gpio_exti_stats(gpio_exti_stats_t * stats);
+
+#endif // GPIO_EXTI_H_
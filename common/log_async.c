@@ -0,0 +1,227 @@
+/**
+ * @file log_async.c
+ *
+ * @brief   Non-blocking log output: records are copied into a ring buffer and written
+ *          out by a low priority drain thread.
+ *
+ * @details log_async_write() is the log_output_f given to log_init(). It reserves space in
+ *          the ring, copies the record and returns, so logging costs a copy instead of the
+ *          time to send the line over UART. It can be called from any thread and from
+ *          interrupts. When the ring is full the record is dropped and counted.
+ *
+ *          Records are a header word (length, committed flag) followed by the text padded
+ *          to a word. Writers reserve space by moving reserveHead with compare-and-swap
+ *          (GCC __atomic builtins, LDREX/STREX on the Cortex-M4) and publish the record
+ *          by storing the committed header. A record that would not fit before the end
+ *          of the buffer is preceded by a padding record to the end. The drain thread
+ *          hands committed records to the sink in order, clears them and moves tail;
+ *          it stops at a record that is still being written and is signalled again when
+ *          that record is committed.
+ *
+ * @author agent
+ * @license MIT
+ *
+ * Copyright agent, 2026
+ */
+
+#include <string.h>
+
+#include "cmsis_os2.h"
+
+#include "log_async.h"
+#include "rtos_static.h"
+
+#if (LOG_ASYNC_BUFFER_SIZE & (LOG_ASYNC_BUFFER_SIZE - 1)) != 0
+#error "LOG_ASYNC_BUFFER_SIZE must be a power of two"
+#endif
+
+#define LOG_ASYNC_MASK          (LOG_ASYNC_BUFFER_SIZE - 1)
+#define LOG_ASYNC_HDR_LEN       0x0000FFFFUL    // Text length in bytes
+#define LOG_ASYNC_HDR_COMMIT    0x00010000UL    // Record complete, can be sent
+#define LOG_ASYNC_HDR_PAD       0x00020000UL    // Padding to the end of the buffer, no text
+
+static uint32_t ringBuf[LOG_ASYNC_BUFFER_SIZE / sizeof(uint32_t)];
+static volatile uint32_t reserveHead;   // Bytes reserved by writers, free-running
+static volatile uint32_t tail;          // Bytes released by the drain thread, free-running
+static volatile bool wakePending;       // Drain thread has been signalled
+
+static volatile uint32_t dropped;       // Records dropped because the ring was full
+static volatile uint32_t highWater;     // Highest ring fill in bytes
+
+static log_output_f logSink;
+static osThreadId_t drainThreadId;
+
+static void log_async_drain_loop (void * args);
+
+/**
+ * @brief   Start the drain thread, call before osKernelStart().
+ *
+ * @param   sink Blocking output the records are written to, e.g. logger_fwrite.
+ *
+ * @return  -1 if the thread could not be created
+ *           0 otherwise
+ */
+int8_t log_async_init (log_output_f sink)
+{
+    RTOS_THREAD_STATIC(drainThread, LOG_ASYNC_STACK_SIZE);
+    const osThreadAttr_t drain_thread_attr = { .name = "log_drain", .priority = osPriorityLow, RTOS_THREAD_MEM(drainThread) };
+
+    logSink = sink;
+    drainThreadId = rtos_thread_new(log_async_drain_loop, NULL, &drain_thread_attr);
+    return (drainThreadId == NULL) ? -1 : 0;
+}
+
+static uint32_t record_size (uint32_t len)
+{
+    return sizeof(uint32_t) + ((len + sizeof(uint32_t) - 1) & ~(sizeof(uint32_t) - 1));
+}
+
+static void update_high_water (uint32_t fill)
+{
+    uint32_t hwm = __atomic_load_n(&highWater, __ATOMIC_RELAXED);
+
+    while ((fill > hwm) &&
+           !__atomic_compare_exchange_n(&highWater, &hwm, fill, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED));
+}
+
+/**
+ * @brief   Queue a log record, never blocks (any thread or interrupt).
+ *
+ * @return  len, 0 if the record was dropped
+ */
+int log_async_write (const char * ptr, int len)
+{
+    uint32_t head;
+    uint32_t pad;
+    uint32_t size;
+    uint32_t offset;
+
+    if (len <= 0)
+    {
+        return 0;
+    }
+    if (len > LOG_ASYNC_RECORD_MAX)
+    {
+        len = LOG_ASYNC_RECORD_MAX;
+    }
+    size = record_size(len);
+
+    // Reserve size bytes, plus padding if the record would wrap around the end
+    head = __atomic_load_n(&reserveHead, __ATOMIC_RELAXED);
+    do
+    {
+        offset = head & LOG_ASYNC_MASK;
+        pad = ((offset + size) > LOG_ASYNC_BUFFER_SIZE) ? (LOG_ASYNC_BUFFER_SIZE - offset) : 0;
+        if ((head + pad + size - __atomic_load_n(&tail, __ATOMIC_ACQUIRE)) > LOG_ASYNC_BUFFER_SIZE)
+        {
+            __atomic_fetch_add(&dropped, 1, __ATOMIC_RELAXED);
+            return 0;
+        }
+    }
+    while (!__atomic_compare_exchange_n(&reserveHead, &head, head + pad + size, true,
+                                        __ATOMIC_ACQ_REL, __ATOMIC_RELAXED));
+
+    update_high_water(head + pad + size - __atomic_load_n(&tail, __ATOMIC_RELAXED));
+
+    if (pad != 0)
+    {
+        __atomic_store_n(&ringBuf[offset / sizeof(uint32_t)], LOG_ASYNC_HDR_PAD | LOG_ASYNC_HDR_COMMIT,
+                         __ATOMIC_RELEASE);
+        offset = 0;
+    }
+    memcpy(&ringBuf[offset / sizeof(uint32_t) + 1], ptr, len);
+    __atomic_store_n(&ringBuf[offset / sizeof(uint32_t)], (uint32_t)len | LOG_ASYNC_HDR_COMMIT,
+                     __ATOMIC_RELEASE);
+
+    if ((drainThreadId != NULL) && !__atomic_exchange_n(&wakePending, true, __ATOMIC_ACQ_REL))
+    {
+        osThreadFlagsSet(drainThreadId, LOG_ASYNC_THREAD_FLAG);
+    }
+    return len;
+}
+
+/**
+ * @brief   Send the oldest record to the sink and free it (drain thread).
+ *
+ * @return  false if the ring is empty or the oldest record is still being written
+ */
+static bool drain_one (void)
+{
+    uint32_t t = tail;
+    uint32_t offset = t & LOG_ASYNC_MASK;
+    uint32_t hdr;
+    uint32_t size;
+
+    if (t == __atomic_load_n(&reserveHead, __ATOMIC_ACQUIRE))
+    {
+        return false;
+    }
+    hdr = __atomic_load_n(&ringBuf[offset / sizeof(uint32_t)], __ATOMIC_ACQUIRE);
+    if ((hdr & LOG_ASYNC_HDR_COMMIT) == 0)
+    {
+        return false;
+    }
+
+    if (hdr & LOG_ASYNC_HDR_PAD)
+    {
+        size = LOG_ASYNC_BUFFER_SIZE - offset;
+    }
+    else
+    {
+        size = record_size(hdr & LOG_ASYNC_HDR_LEN);
+        logSink((const char *)&ringBuf[offset / sizeof(uint32_t) + 1], hdr & LOG_ASYNC_HDR_LEN);
+    }
+
+    // Text left behind could look like a committed header to a later lap
+    memset(&ringBuf[offset / sizeof(uint32_t)], 0, size);
+    __atomic_store_n(&tail, t + size, __ATOMIC_RELEASE);
+    return true;
+}
+
+static void log_async_drain_loop (void * args)
+{
+    for (;;)
+    {
+        // Cleared before looking at the ring, a record committed after this signals again
+        __atomic_store_n(&wakePending, false, __ATOMIC_SEQ_CST);
+        while (drain_one());
+        osThreadFlagsWait(LOG_ASYNC_THREAD_FLAG, osFlagsWaitAny, osWaitForever);
+    }
+}
+
+/**
+ * @brief   Wait until everything queued has been written out.
+ *
+ * @param   timeout Kernel ticks to wait.
+ *
+ * @return  false if records were still queued after timeout
+ */
+bool log_async_flush (uint32_t timeout)
+{
+    while (__atomic_load_n(&tail, __ATOMIC_ACQUIRE) != __atomic_load_n(&reserveHead, __ATOMIC_ACQUIRE))
+    {
+        if (timeout == 0)
+        {
+            return false;
+        }
+        osDelay(1);
+        timeout--;
+    }
+    return true;
+}
+
+/**
+ * @brief   Records dropped because the ring was full.
+ */
+uint32_t log_async_dropped (void)
+{
+    return dropped;
+}
+
+/**
+ * @brief   Highest ring fill seen, in bytes.
+ */
+uint32_t log_async_high_water (void)
+{
+    return highWater;
+}
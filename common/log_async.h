@@ -0,0 +1,37 @@
+/**
+ * @file log_async.h
+ *
+ * @brief   Non-blocking log output: records are copied into a ring buffer and written
+ *          out by a low priority drain thread.
+ *
+ * @author agent
+ * @license MIT
+ *
+ * Copyright agent, 2026
+ */
+
+#ifndef LOG_ASYNC_H_
+#define LOG_ASYNC_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "loggers_ext.h"
+
+#ifndef LOG_ASYNC_BUFFER_SIZE
+#define LOG_ASYNC_BUFFER_SIZE   2048    // Ring buffer bytes, power of two
+#endif
+
+#define LOG_ASYNC_RECORD_MAX    256     // Longer records are truncated
+#define LOG_ASYNC_THREAD_FLAG   0x01
+#define LOG_ASYNC_STACK_SIZE    1024    // Drain thread, bytes, the sink runs on it
+
+// Public functions
+int8_t log_async_init(log_output_f sink);
+int log_async_write(const char * ptr, int len);
+bool log_async_flush(uint32_t timeout);
+
+uint32_t log_async_dropped(void);
+uint32_t log_async_high_water(void);
+
+#endif // LOG_ASYNC_H_
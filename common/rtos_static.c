@@ -0,0 +1,99 @@
+/**
+ * @file rtos_static.c
+ *
+ * @brief   Thread list and stack high-water report, see rtos_static.h.
+ *
+ * @author agent
+ * @license MIT
+ *
+ * Copyright agent, 2026
+ */
+
+#include <stdio.h>
+#include <inttypes.h>
+
+#include "cmsis_os2.h"
+#include "em_core.h"
+
+#include "rtos_static.h"
+
+#include "loglevels.h"
+#define __MODUUL__ "rtos"
+#define __LOG_LEVEL__ (LOG_LEVEL_main & BASE_LOG_LEVEL)
+#include "log.h"
+
+#define RTOS_REPORT_LINE_MAX    200
+
+typedef struct
+{
+    osThreadId_t id;
+    uint32_t stackSize;     // Bytes
+} rtos_thread_t;
+
+static rtos_thread_t threads[RTOS_STATIC_MAX_THREADS];
+static volatile uint32_t threadCount;
+
+/**
+ * @brief   osThreadNew() that lists the thread for rtos_stack_report(), any thread.
+ *
+ * @return  NULL if the thread could not be created, with RTOS_STATIC=1 if attr has no memory
+ */
+osThreadId_t rtos_thread_new (osThreadFunc_t func, void * argument, const osThreadAttr_t * attr)
+{
+    osThreadId_t id = osThreadNew(func, argument, attr);
+    CORE_DECLARE_IRQ_STATE;
+
+    if (id == NULL)
+    {
+        err1("Thread %s not created", ((attr != NULL) && (attr->name != NULL)) ? attr->name : "-");
+        return NULL;
+    }
+
+    CORE_ENTER_ATOMIC();
+    if (threadCount < RTOS_STATIC_MAX_THREADS)
+    {
+        threads[threadCount].id = id;
+        threads[threadCount].stackSize = (attr != NULL) ? attr->stack_size : 0;
+        threadCount++;
+    }
+    CORE_EXIT_ATOMIC();
+    return id;
+}
+
+/**
+ * @brief   Log the stack bytes used at most and the stack size of every listed thread,
+ *          warn about those with less than RTOS_STACK_MARGIN bytes never used.
+ */
+void rtos_stack_report (void)
+{
+    char line[RTOS_REPORT_LINE_MAX];
+    uint32_t n = threadCount;
+    uint32_t len = 0;
+    uint32_t i;
+
+    line[0] = '\0';
+    for (i = 0; i < n; i++)
+    {
+        const char * name = osThreadGetName(threads[i].id);
+        uint32_t space = osThreadGetStackSpace(threads[i].id);
+        uint32_t size = threads[i].stackSize;
+        uint32_t used = (size > space) ? size - space : 0;
+
+        if (name == NULL)
+        {
+            name = "-";
+        }
+        if (space < RTOS_STACK_MARGIN)
+        {
+            warn1("Stack of %s nearly full, %"PRIu32" of %"PRIu32" bytes left", name, space, size);
+        }
+        if (len < sizeof(line))
+        {
+            int w = snprintf(&line[len], sizeof(line) - len, "%s%s %"PRIu32"/%"PRIu32, (i > 0) ? ", " : "",
+                             name, used, size);
+
+            len += (w > 0) ? (uint32_t)w : 0;
+        }
+    }
+    info1("Stack used/size %s", line);
+}
@@ -0,0 +1,77 @@
+/**
+ * @file rtos_static.h
+ *
+ * @brief   Statically allocated RTOS objects and thread stack high-water marks.
+ *
+ * @details With RTOS_STATIC=1 threads, mutexes and semaphores are created with control
+ *          blocks and stacks in .bss, so their RAM is in the map file and startup does not
+ *          allocate. The memory is declared next to the code creating the object and passed
+ *          in its attributes:
+ *
+ *              RTOS_THREAD_STATIC(hbThread, HB_STACK_SIZE);
+ *              const osThreadAttr_t attr = { .name = "heartbeat", RTOS_THREAD_MEM(hbThread) };
+ *
+ *          The build sets configSUPPORT_DYNAMIC_ALLOCATION=0 and leaves the FreeRTOS heap
+ *          out, an object created without memory fails at startup. With RTOS_STATIC=0 the
+ *          objects come from the heap, threads still get the stack size given here.
+ *
+ *          Threads created with rtos_thread_new() are listed for rtos_stack_report(), which
+ *          logs the stack size and the most of it used since the thread started per thread.
+ *          The kernel fills new stacks with a known value, osThreadGetStackSpace() finds the
+ *          deepest word overwritten (INCLUDE_uxTaskGetStackHighWaterMark=1).
+ *
+ * @author agent
+ * @license MIT
+ *
+ * Copyright agent, 2026
+ */
+
+#ifndef RTOS_STATIC_H_
+#define RTOS_STATIC_H_
+
+#include <stdint.h>
+
+#include "cmsis_os2.h"
+
+#ifndef RTOS_STATIC
+#define RTOS_STATIC             0       // Set from the Makefile
+#endif
+
+#define RTOS_STATIC_MAX_THREADS 8       // Threads listed in the stack report
+#define RTOS_STACK_MARGIN       128     // Bytes, less left is reported as a warning
+
+// Stack bytes rounded up to the 8 byte alignment of the stack pointer
+#define RTOS_STACK_BYTES(bytes) ((((bytes) + 7) / 8) * 8)
+
+#if RTOS_STATIC
+
+#include "FreeRTOS.h"
+
+#define RTOS_THREAD_STATIC(name, stackBytes) \
+    static StaticTask_t name##Cb; \
+    static uint64_t name##Stack[RTOS_STACK_BYTES(stackBytes) / sizeof(uint64_t)]
+
+#define RTOS_THREAD_MEM(name) \
+    .cb_mem = &name##Cb, .cb_size = sizeof(name##Cb), .stack_mem = name##Stack, .stack_size = sizeof(name##Stack)
+
+// Mutexes and semaphores share the control block type
+#define RTOS_SYNC_STATIC(name)  static StaticSemaphore_t name##Cb
+#define RTOS_SYNC_MEM(name)     .cb_mem = &name##Cb, .cb_size = sizeof(name##Cb)
+
+#else
+
+#define RTOS_THREAD_STATIC(name, stackBytes) \
+    enum { name##StackSize = RTOS_STACK_BYTES(stackBytes) }
+
+#define RTOS_THREAD_MEM(name)   .stack_size = name##StackSize
+
+#define RTOS_SYNC_STATIC(name)  enum { name##Cb }
+#define RTOS_SYNC_MEM(name)     .attr_bits = 0
+
+#endif // RTOS_STATIC
+
+// Public functions
+osThreadId_t rtos_thread_new(osThreadFunc_t func, void * argument, const osThreadAttr_t * attr);
+void rtos_stack_report(void);
+
+#endif // RTOS_STATIC_H_
@@ -0,0 +1,239 @@
+/**
+ * @file acq_ldma.c
+ *
+ * @brief   MMA8653FC register burst read with I2C0 and LDMA.
+ *
+ * @details The I2C address phase (START, write address, register address, repeated START,
+ *          read address) is stepped through in the I2C0 interrupt. The data bytes are then
+ *          moved from I2C0->RXDATA to memory by LDMA with automatic ACK. Only the last byte
+ *          is taken by the CPU, because it must be NACKed before the STOP condition.
+ *
+ *          The bus is taken from i2c_handler with i2c_bus_claim(), so blocking and
+ *          asynchronous transactions of i2c_handler wait until the burst is done.
+ *
+ * @note    AUTOACK is cleared in the LDMA done interrupt, while the sensor is still shifting
+ *          out the last byte (9 SCL cycles, 90 us at 100 kHz). LDMA and I2C0 interrupts must
+ *          not be delayed longer than that.
+ *
+ * EFR32MG12 Wireless Gecko Reference Manual (I2C p501, LDMA p266)
+ * https://www.silabs.com/documents/public/reference-manuals/efr32xg12-rm.pdf
+ *
+ * @author agent
+ * @license MIT
+ *
+ * Copyright agent, 2026
+ */
+
+#include "em_cmu.h"
+#include "em_i2c.h"
+#include "em_ldma.h"
+
+#include "i2c_handler.h"
+#include "mma8653fc_reg.h"
+#include "acq_ldma.h"
+
+typedef enum
+{
+    ACQ_LDMA_IDLE,
+    ACQ_LDMA_ADDR_W,    // Waiting ACK for write address
+    ACQ_LDMA_REG,       // Waiting ACK for register address
+    ACQ_LDMA_ADDR_R,    // Waiting ACK for read address
+    ACQ_LDMA_DATA,      // LDMA is receiving
+    ACQ_LDMA_LAST,      // Waiting last byte
+    ACQ_LDMA_STOP       // Waiting STOP condition
+} acq_ldma_state_t;
+
+#define ACQ_LDMA_I2C_ERRORS     (I2C_IF_ARBLOST | I2C_IF_BUSERR | I2C_IF_BUSHOLD)
+
+static volatile acq_ldma_state_t state = ACQ_LDMA_IDLE;
+static volatile int8_t result;
+static uint8_t regAddress;
+static uint8_t * dstBuf;
+static uint16_t dstLen;
+static mma_acq_done_f doneCb;
+
+static LDMA_TransferCfg_t ldmaCfg;
+static LDMA_Descriptor_t ldmaDesc;
+
+static int8_t acq_ldma_start(uint8_t regAddr, uint8_t * dst, uint16_t len, mma_acq_done_f done);
+static void acq_ldma_i2c_irq(void);
+static void acq_ldma_finish(int8_t res);
+
+const mma_acq_channel_t acq_ldma_channel = { .start = acq_ldma_start };
+
+/**
+ * @brief   Initialize LDMA. I2C must be initialized separately with i2c_init().
+ */
+void acq_ldma_init (void)
+{
+    LDMA_Init_t init = LDMA_INIT_DEFAULT;
+    LDMA_TransferCfg_t cfg = LDMA_TRANSFER_CFG_PERIPHERAL(ldmaPeripheralSignal_I2C0_RXDATAV);
+    LDMA_Descriptor_t desc = LDMA_DESCRIPTOR_SINGLE_P2M_BYTE(&I2C0->RXDATA, NULL, 1);
+
+    CMU_ClockEnable(cmuClock_LDMA, true);
+    init.ldmaInitIrqPriority = I2C_IRQ_PRIORITY;
+    LDMA_Init(&init);
+
+    ldmaCfg = cfg;
+    ldmaDesc = desc;
+}
+
+/**
+ * @brief   Start reading len registers from regAddr into dst.
+ *
+ * @return  -1 if I2C0 is busy or len is too short
+ *           0 if transfer was started
+ */
+static int8_t acq_ldma_start (uint8_t regAddr, uint8_t * dst, uint16_t len, mma_acq_done_f done)
+{
+    if (len < 2)
+    {
+        return -1;
+    }
+    if (i2c_bus_claim(acq_ldma_i2c_irq) != 0)
+    {
+        return -1;
+    }
+
+    regAddress = regAddr;
+    dstBuf = dst;
+    dstLen = len;
+    doneCb = done;
+    result = 0;
+
+    // Empty buffers and clear stale flags, same as I2C_TransferInit().
+    I2C0->CMD = I2C_CMD_CLEARPC | I2C_CMD_CLEARTX;
+    if (I2C0->IF & I2C_IF_RXDATAV)
+    {
+        (void)I2C0->RXDATA;
+    }
+    I2C_IntClear(I2C0, _I2C_IF_MASK);
+    I2C_IntEnable(I2C0, I2C_IF_ACK | I2C_IF_NACK | I2C_IF_MSTOP | ACQ_LDMA_I2C_ERRORS);
+
+    state = ACQ_LDMA_ADDR_W;
+    I2C0->CMD = I2C_CMD_START;
+    I2C0->TXDATA = MMA8653FC_SLAVE_ADDRESS_WRITE;
+    return 0;
+}
+
+/**
+ * @brief   I2C0 interrupt while the bus is claimed, steps through the address phase.
+ */
+static void acq_ldma_i2c_irq (void)
+{
+    uint32_t pending = I2C_IntGetEnabled(I2C0);
+
+    if (pending & ACQ_LDMA_I2C_ERRORS)
+    {
+        I2C0->CMD = I2C_CMD_ABORT;
+        LDMA_StopTransfer(ACQ_LDMA_CHANNEL);
+        acq_ldma_finish(-1);
+        return;
+    }
+
+    if (pending & I2C_IF_NACK)
+    {
+        // Sensor did not respond, end the transfer.
+        I2C_IntClear(I2C0, I2C_IF_NACK);
+        LDMA_StopTransfer(ACQ_LDMA_CHANNEL);
+        result = -1;
+        state = ACQ_LDMA_STOP;
+        I2C0->CMD = I2C_CMD_STOP;
+    }
+    else if (pending & I2C_IF_ACK)
+    {
+        I2C_IntClear(I2C0, I2C_IF_ACK);
+        switch (state)
+        {
+            case ACQ_LDMA_ADDR_W:
+                I2C0->TXDATA = regAddress;
+                state = ACQ_LDMA_REG;
+                break;
+
+            case ACQ_LDMA_REG:
+                // Hand the data bytes over to LDMA before the sensor starts sending.
+                I2C0->CTRL |= I2C_CTRL_AUTOACK;
+                ldmaDesc.xfer.dstAddr = (uint32_t)dstBuf;
+                ldmaDesc.xfer.xferCnt = dstLen - 2; // All but the last byte, xferCnt is count-1
+                LDMA_StartTransfer(ACQ_LDMA_CHANNEL, &ldmaCfg, &ldmaDesc);
+
+                I2C0->CMD = I2C_CMD_START;
+                I2C0->TXDATA = MMA8653FC_SLAVE_ADDRESS_READ;
+                state = ACQ_LDMA_ADDR_R;
+                break;
+
+            case ACQ_LDMA_ADDR_R:
+                // Data is flowing, nothing to do until LDMA is done.
+                I2C_IntDisable(I2C0, I2C_IF_ACK);
+                state = ACQ_LDMA_DATA;
+                break;
+
+            default:
+                break;
+        }
+    }
+
+    if ((pending & I2C_IF_RXDATAV) && (state == ACQ_LDMA_LAST))
+    {
+        I2C_IntDisable(I2C0, I2C_IF_RXDATAV);
+        dstBuf[dstLen - 1] = I2C0->RXDATA;
+        I2C0->CMD = I2C_CMD_NACK;
+        I2C0->CMD = I2C_CMD_STOP;
+        state = ACQ_LDMA_STOP;
+    }
+
+    if (pending & I2C_IF_MSTOP)
+    {
+        I2C_IntClear(I2C0, I2C_IF_MSTOP);
+        if (state == ACQ_LDMA_STOP)
+        {
+            acq_ldma_finish(result);
+        }
+    }
+}
+
+/**
+ * @brief   Release the bus and report the result.
+ *
+ * @param   res 0 if the burst was read, -1 otherwise
+ */
+static void acq_ldma_finish (int8_t res)
+{
+    mma_acq_done_f cb = doneCb;
+
+    I2C0->CTRL &= ~I2C_CTRL_AUTOACK;
+    I2C_IntDisable(I2C0, _I2C_IEN_MASK);
+    I2C_IntClear(I2C0, _I2C_IF_MASK);
+    state = ACQ_LDMA_IDLE;
+    i2c_bus_release();
+
+    cb(res);
+}
+
+void LDMA_IRQHandler (void)
+{
+    uint32_t pending = LDMA_IntGetEnabled();
+
+    if (pending & (1 << ACQ_LDMA_CHANNEL))
+    {
+        LDMA_IntClear(1 << ACQ_LDMA_CHANNEL);
+
+        // All but the last byte are in, the last one must be NACKed by hand.
+        I2C0->CTRL &= ~I2C_CTRL_AUTOACK;
+        state = ACQ_LDMA_LAST;
+        I2C_IntEnable(I2C0, I2C_IF_RXDATAV);
+    }
+
+    if (pending & LDMA_IF_ERROR)
+    {
+        LDMA_IntClear(LDMA_IF_ERROR);
+
+        // Bus fault on the descriptor or the buffer, the burst is lost
+        if (state != ACQ_LDMA_IDLE)
+        {
+            I2C0->CMD = I2C_CMD_ABORT;
+            LDMA_StopTransfer(ACQ_LDMA_CHANNEL);
+            acq_ldma_finish(-1);
+        }
+    }
+}
@@ -0,0 +1,23 @@
+/**
+ * @file acq_ldma.h
+ *
+ * @author agent
+ * @license MIT
+ *
+ * Copyright agent, 2026
+ */
+
+#ifndef ACQ_LDMA_H_
+#define ACQ_LDMA_H_
+
+#include "mma_acq.h"
+
+#define ACQ_LDMA_CHANNEL    0
+
+// Acquisition channel reading MMA8653FC registers with I2C0 and LDMA
+extern const mma_acq_channel_t acq_ldma_channel;
+
+// Public functions
+void acq_ldma_init(void);
+
+#endif // ACQ_LDMA_H_
@@ -39,6 +39,8 @@
 
 #include "retargetserial.h"
 
+#include "em_device.h"
+
 #include "cmsis_os2.h"
 
 #include "platform.h"
@@ -48,117 +50,376 @@
 
 #include "loggers_ext.h"
 #include "logger_fwrite.h"
+#include "log_async.h"
 
 #include "i2c_handler.h"
 #include "mma8653fc_reg.h"
 #include "gpio_handler.h"
 #include "mma8653fc_driver.h"
+#include "mma_acq.h"
+#include "mma_motion.h"
+#include "sample_window.h"
+#include "sample_stream.h"
+#include "flash_log.h"
+#include "sample_time.h"
+#include "dsp_stats.h"
+#include "fft.h"
+#include "scratch_arena.h"
+#include "stage_trace.h"
+#include "tickless_idle.h"
+#include "rtos_static.h"
+#if MMA_ACQ_LDMA
+#include "acq_ldma.h"
+#endif
 #include "app_main.h"
 
 #include "loglevels.h"
 #define __MODUUL__ "main"
 #define __LOG_LEVEL__ (LOG_LEVEL_main & BASE_LOG_LEVEL)
 #include "log.h"
+#include "blog.h"
 
 // Include the information header binary
 #include "incbin.h"
 INCBIN(Header, "header.bin");
 
+#define HB_THREAD_STACK_SIZE        1536    // Bytes, log formatting
+
 #define DATA_READY_THREAD_FLAG      0x01
+#define DATA_READY_THREAD_STACK_SIZE 1536   // Sensor setup, sample batch buffers
+#define DATA_READY_BATCH            4       // Samples collected per data ready thread wake-up
+#define DATA_READY_TIMEOUT_MS       1000    // Process a partial batch after this long
 static osThreadId_t dataReadyThreadId;
+static uint32_t sampleOdrMhz;   // Read once after configuration, not per batch over I2C
+
+#define ANALYSIS_THREAD_FLAG        0x01
+#define ANALYSIS_THREAD_STACK_SIZE  1536
+static osThreadId_t analysisThreadId;
+
+// Per window analysis buffers of the longest window, given back after each window
+#define ANALYSIS_ARENA_SIZE         (SCRATCH_ARENA_BYTES(3 * sizeof(dsp_stats_t)) + \
+                                     SCRATCH_ARENA_BYTES(3 * sizeof(fft_result_t)) + \
+                                     SCRATCH_ARENA_BYTES(SAMPLE_WINDOW_LENGTH * sizeof(float)))
+static uint64_t analysisArenaMem[ANALYSIS_ARENA_SIZE / sizeof(uint64_t)];
+static scratch_arena_t analysisArena;
 
-float calc_signal_energy(float buf[], uint32_t num_elements);
+// Sensor configuration, 6.25 Hz, +-2g, low power, data ready interrupt on INT1 (active low, push-pull)
+static const mma_config_t sensorConfig = MMA8653FC_CONFIG(
+    MMA8653FC_CTRL_REG1_DR_6HZ, MMA8653FC_XYZ_DATA_CFG_2G_RANGE, MMA8653FC_CTRL_REG2_POWMOD_LOWPOW,
+    MMA8653FC_CTRL_REG3_POLARITY_LOW, MMA8653FC_CTRL_REG3_PINMODE_PP,
+    MMA8653FC_CTRL_REG4_DRDY_INT_MASK, MMA8653FC_CTRL_REG5_DRDY_INTSEL_MASK);
 
 // Heartbeat loop - periodically print 'Heartbeat'
 static void hb_loop (void *args)
 {
+    sample_time_stats_t odr;
+    gpio_exti_stats_t exti;
+#if TICKLESS_IDLE
+    tickless_stats_t sleep;
+#endif
+#if MMA_MOTION
+    mma_motion_stats_t motion;
+#endif
+
     for (;;)
     {
         osDelay(10000);
-        info1("Heartbeat");
+        blog_info1("Heartbeat, acq hwm %"PRIu32" ovr %"PRIu32" err %"PRIu32" retrig %"PRIu32", win swap %"PRIu32
+                   " miss %"PRIu32", log hwm %"PRIu32" drop %"PRIu32,
+                   mma_acq_high_water(), mma_acq_overruns(), mma_acq_errors(), mma_acq_retriggers(),
+                   sample_window_swaps(), sample_window_missed(),
+                   log_async_high_water(), log_async_dropped());
+        blog_info1("Window %u samples, scratch peak %"PRIu32" of %"PRIu32" bytes, failed %"PRIu32,
+                   sample_window_length(), scratch_arena_peak(&analysisArena), scratch_arena_size(&analysisArena),
+                   scratch_arena_failures(&analysisArena));
+        sample_time_stats(&odr);
+        blog_info1("ODR %"PRIu32" mHz (set %"PRIu32"), jitter rms %"PRIu32" pp %"PRIu32" us, gaps %"PRIu32" dup %"PRIu32,
+                   odr.odrMhz, sampleOdrMhz, odr.jitterRmsUs, odr.jitterPpUs, odr.gaps, odr.duplicates);
+        gpio_exti_stats(&exti);
+        blog_info1("EXTI irqs %"PRIu32" spurious %"PRIu32" queue full %"PRIu32", handler cycles mean %"PRIu32" max %"PRIu32,
+                   exti.irqs, exti.spurious, exti.queueFull, exti.meanCycles, exti.maxCycles);
+#if TICKLESS_IDLE
+        tickless_stats(&sleep);
+        blog_info1("Ticks %"PRIu32" suppressed %"PRIu32", sleeps %"PRIu32" EM2 %"PRIu32" asleep %"PRIu32" s"
+                   ", wake latency mean %"PRIu32" max %"PRIu32" us",
+                   sleep.ticks, sleep.suppressed, sleep.sleeps, sleep.em2Sleeps, sleep.sleepCounts / TICKLESS_CLOCK_HZ,
+                   sleep.wakeLatencyMeanUs, sleep.wakeLatencyMaxUs);
+#endif
+#if MMA_MOTION
+        mma_motion_stats(&motion);
+        blog_info1("Motion onsets %"PRIu32" sleeps %"PRIu32" acquiring %"PRIu32" %%, onset latency mean %"PRIu32" max %"PRIu32" ms"
+                   ", discarded %"PRIu32" checks %"PRIu32,
+                   motion.onsets, motion.sleeps, motion.acquiringPct, motion.latencyMeanMs, motion.latencyMaxMs,
+                   motion.discarded, motion.checks);
+#endif
+#if SAMPLE_STREAM
+        blog_info1("Stream frames %"PRIu32" dropped samples %"PRIu32, sample_stream_frames(), sample_stream_dropped());
+#endif
+#if FLASH_LOG
+        blog_info1("Flash pages %"PRIu32" dropped samples %"PRIu32" errors %"PRIu32,
+                   flash_log_pages(), flash_log_dropped(), flash_log_errors());
+#endif
+#if STAGE_TRACE
+        stage_trace_dump();
+#endif
+        rtos_stack_report();
+    }
+}
+
+/**
+ * @brief   Drains the acquisition ring, converts the collected samples to counts in one
+ *          block per axis and stores them in the window being filled. Full windows are
+ *          analyzed in the analysis thread.
+ */
+static void process_samples (void)
+{
+    xyz_rawdata_t data;
+    uint16_t rawX[MMA_ACQ_RING_SLOTS], rawY[MMA_ACQ_RING_SLOTS], rawZ[MMA_ACQ_RING_SLOTS];
+    int16_t x[MMA_ACQ_RING_SLOTS], y[MMA_ACQ_RING_SLOTS], z[MMA_ACQ_RING_SLOTS];
+    uint8_t resolution = MMA8653FC_RESOLUTION_NORMAL;
+    uint32_t i, n = 0;
+#if STAGE_TRACE
+    uint32_t t0[MMA_ACQ_RING_SLOTS];
+#endif
+
+    while ((n < MMA_ACQ_RING_SLOTS) && mma_acq_get(&data))
+    {
+        // Actual sample timing against the configured rate, a read without new data is not a sample
+        if (data.status & MMA8653FC_STATUS_ZYXDR_MASK)
+        {
+            sample_time_update(data.stamp, sampleOdrMhz);
+        }
+
+        // Status check
+        if (data.status == 15) // Data is ready and no overflow has occured
+        {
+            rawX[n] = data.out_x;
+            rawY[n] = data.out_y;
+            rawZ[n] = data.out_z;
+            resolution = data.resolution;
+#if STAGE_TRACE
+            t0[n] = mma_acq_trace_t0();
+#endif
+            n++;
+        }
+        else
+        {
+            // Either overflow or data not ready
+        }
+    }
+
+    // Convert to engineering value
+    convert_block_to_count(rawX, x, n);
+    convert_block_to_count(rawY, y, n);
+    convert_block_to_count(rawZ, z, n);
+
+    // Store values in the window, dropped if analysis is behind
+    for (i = 0; i < n; i++)
+    {
+#if SAMPLE_STREAM
+        sample_stream_add(x[i], y[i], z[i], resolution, sampleOdrMhz);
+#endif
+#if FLASH_LOG
+        flash_log_add(x[i], y[i], z[i], resolution, sampleOdrMhz);
+#endif
+#if STAGE_TRACE
+        sample_window_trace_t0(t0[i]);
+        if (sample_window_put(x[i], y[i], z[i], resolution))
+        {
+            STAGE_TRACE_MARK(STAGE_TRACE_WINDOW, t0[i]);
+        }
+#else
+        sample_window_put(x[i], y[i], z[i], resolution);
+#endif
+    }
+}
+
+/**
+ * @brief   Logs a Q16 energy value with 3 decimals.
+ */
+static void log_energy (char axis, int64_t energy)
+{
+    uint32_t frac = (uint32_t)(((energy & ((1 << SIGNAL_STATS_Q) - 1)) * 1000) >> SIGNAL_STATS_Q);
+
+    blog_info2("%c %"PRIu32",%03"PRIu32, axis, (uint32_t)(energy >> SIGNAL_STATS_Q), frac);
+}
+
+/**
+ * @brief   Logs the spectrum summary of one axis.
+ */
+static void log_spectrum (char axis, const fft_result_t * res, uint32_t n, uint32_t sampleRateMhz)
+{
+    blog_info2("%c f %"PRIu32" mHz, bands %"PRIu32" %"PRIu32" %"PRIu32" %"PRIu32, axis,
+               fft_bin_to_mhz(res->dominantBin, n, sampleRateMhz), (uint32_t)res->bandEnergy[0],
+               (uint32_t)res->bandEnergy[1], (uint32_t)res->bandEnergy[2], (uint32_t)res->bandEnergy[3]);
+}
+
+/**
+ * @brief   Analyzes full sample windows. Runs at a lower priority than data acquisition,
+ *          so a slow analysis can not delay sample collection. Intermediate buffers are
+ *          sized for the window and taken from the analysis arena.
+ */
+static void analysis_loop (void *args)
+{
+    sample_window_t * w;
+    uint32_t n, rateMhz;
+    dsp_stats_t * range;
+    fft_result_t * spectrum;
+    float * work;
+    uint32_t cycles, maxCycles = 0;
+
+    // Cycle counter for measuring the cost of spectral analysis. It is not reset, other
+    // users (stage trace) share it, the cost is the unsigned difference of two readings.
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+    for (;;)
+    {
+        w = sample_window_wait(osWaitForever);
+        if (w == NULL)
+        {
+            continue;
+        }
+        n = w->count;
+
+        // Signal energy is accumulated while the window is filled
+        blog_info2("Signal energy, window %"PRIu32, w->seq);
+        log_energy('x', signal_stats_q_energy(&w->xStats));
+        log_energy('y', signal_stats_q_energy(&w->yStats));
+        log_energy('z', signal_stats_q_energy(&w->zStats));
+
+        range = scratch_arena_alloc(&analysisArena, 3 * sizeof(dsp_stats_t));
+        spectrum = scratch_arena_alloc(&analysisArena, 3 * sizeof(fft_result_t));
+        work = scratch_arena_alloc(&analysisArena, n * sizeof(float));
+        if ((range == NULL) || (spectrum == NULL) || (work == NULL) || !fft_length_valid(n))
+        {
+            err1("Window %"PRIu32" of %"PRIu32" samples not analyzed", w->seq, n);
+            scratch_arena_reset(&analysisArena);
+            sample_window_release(w);
+            continue;
+        }
+
+        // Peak values of all axes in one block pass (DSP instructions on Cortex-M4)
+        dsp_stats_xyz(w->x, w->y, w->z, n, range);
+        blog_info2("range x %d..%d y %d..%d z %d..%d", range[0].min, range[0].max,
+                   range[1].min, range[1].max, range[2].min, range[2].max);
+
+        // Spectrum of all axes, dominant frequency and band energies
+        cycles = DWT->CYCCNT;
+        fft_analyze(w->x, n, work, &spectrum[0]);
+        fft_analyze(w->y, n, work, &spectrum[1]);
+        fft_analyze(w->z, n, work, &spectrum[2]);
+        cycles = DWT->CYCCNT - cycles;
+        if (cycles > maxCycles)
+        {
+            maxCycles = cycles;
+        }
+
+        rateMhz = sampleOdrMhz;
+#if SAMPLE_TIME_CORRECT
+        // Frequencies from the measured rate once it is known
+        if (sample_time_odr_mhz() != 0)
+        {
+            rateMhz = sample_time_odr_mhz();
+        }
+#endif
+        log_spectrum('x', &spectrum[0], n, rateMhz);
+        log_spectrum('y', &spectrum[1], n, rateMhz);
+        log_spectrum('z', &spectrum[2], n, rateMhz);
+        blog_info2("fft %"PRIu32" x3 %"PRIu32" cycles (max %"PRIu32")", n, cycles, maxCycles);
+#if STAGE_TRACE
+        STAGE_TRACE_MARK(STAGE_TRACE_PUBLISH, w->traceT0);
+#endif
+
+        // Give the buffers back and the window to acquisition
+        scratch_arena_reset(&analysisArena);
+        sample_window_release(w);
     }
 }
 
 /**
  * @brief   Configures I2C, GPIO and sensor, wakes up on MMA8653FC data ready interrupt, fetches
- *          a batch of sensor data and analyzes data.
+ *          a batch of sensor data and fills analysis windows.
+ *
+ * @note    The data ready interrupt starts a burst read (LDMA with MMA_ACQ_LDMA, interrupt driven
+ *          I2C otherwise) into the acquisition ring. The thread is woken once per DATA_READY_BATCH
+ *          samples.
  */
 static void mma_data_ready_loop (void *args)
 {
-    #define DATA_STREAM_LENGTH  12
-    uint8_t whoami, scnt = 0;
-    xyz_rawdata_t data;
-    
-    uint16_t x_stream[DATA_STREAM_LENGTH];
-    uint16_t y_stream[DATA_STREAM_LENGTH];
-    uint16_t z_stream[DATA_STREAM_LENGTH];
-    float x_energy, y_energy, z_energy;
+    uint8_t whoami;
     
     // Initialize and enable I2C.
     i2c_init();
     i2c_enable();
     
     sensor_reset(); //Vb aitab
-    // To configure sensor put sensor in standby mode.
-    set_sensor_standby();
-    
-    // TODO Configure sensor for xyz data acquisition.
-    configure_xyz_data(MMA8653FC_CTRL_REG1_DR_6HZ, MMA8653FC_XYZ_DATA_CFG_2G_RANGE, MMA8653FC_CTRL_REG2_POWMOD_LOWPOW);
-    
-    // TODO Configure sensor to generate interrupt when new data becomes ready.
-    configure_interrupt(MMA8653FC_CTRL_REG3_POLARITY_LOW, MMA8653FC_CTRL_REG3_PINMODE_PP, MMA8653FC_CTRL_REG4_DRDY_INT_EN, MMA8653FC_CTRL_REG5_DRDY_INTSEL_INT1);
+
+    // Configure sensor for xyz data acquisition and data ready interrupt on INT1, sensor is left in standby.
+    mma_apply_config(&sensorConfig);
+#if MMA_FAST_READ
+    // 8 bit samples, 4 byte bursts instead of 7
+    mma_set_read_mode(MMA8653FC_CTRL_REG1_FAST_READ);
+#endif
     
-    // Configure GPIO for external interrupts and enable external interrupts.
+#if MMA_ACQ_LDMA
+    // Data ready interrupt starts LDMA burst reads into the acquisition ring.
+    acq_ldma_init();
+    mma_acq_init(&acq_ldma_channel, dataReadyThreadId, DATA_READY_THREAD_FLAG, DATA_READY_BATCH);
+#else
+    // Data ready interrupt starts interrupt driven I2C burst reads into the acquisition ring.
+    mma_acq_init(&mma_acq_i2c_channel, dataReadyThreadId, DATA_READY_THREAD_FLAG, DATA_READY_BATCH);
+#endif
+    mma_acq_set_read_mode(mma_get_read_mode());
+    sampleOdrMhz = mma_get_data_rate_mhz();
+#if MMA_MOTION
+    // Acquire while moving, the sensor is armed for motion after a while without
+    mma_motion_init(dataReadyThreadId, DATA_READY_THREAD_FLAG);
+#endif
+
+    // Read Who-am-I registry
+    whoami = read_whoami();
+    info1("WHO AM I - %u", whoami);
+
+    // Configure GPIO for external interrupts, data ready starts the acquisition in interrupt context.
     gpio_external_interrupt_init();
-    gpio_external_interrupt_enable(dataReadyThreadId, DATA_READY_THREAD_FLAG);
+#if MMA_MOTION
+    gpio_exti_register_callback(GPIO_EXTI_NUM, mma_motion_irq);
+#else
+    gpio_exti_register_callback(GPIO_EXTI_NUM, mma_acq_trigger);
+#endif
+    gpio_exti_enable(GPIO_EXTI_NUM);
     
     // Activate sensor.
     set_sensor_active();
-    
-    // Read Who-am-I registry
-    whoami = read_whoami();
-    info1("WHO AM I - %u", whoami);
+    info1("Sensor set up with %"PRIu32" I2C transactions", mma_get_transaction_count());
     
     for (;;)
     {
-        // Wait for data ready interrupt signal from MMA8653FC sensor
-        osThreadFlagsClear(DATA_READY_THREAD_FLAG);
-        osThreadFlagsWait(DATA_READY_THREAD_FLAG, osFlagsWaitAny, osWaitForever);
-	info1("Interrupt labi");
-        // Get raw data
-        data = get_xyz_data();
-        
-        // Status check
-        if (data.status == 15) // Data is ready and no overflow has occured
+        uint32_t timeout = DATA_READY_TIMEOUT_MS * osKernelGetTickFreq() / 1000;
+
+#if MMA_MOTION
+        if (mma_motion_state() == MMA_MOTION_ARMED)
         {
-            
-            if(scnt < DATA_STREAM_LENGTH)
-            {
-                // Convert to engineering value and store values in local buffer
-                x_stream[scnt] = convert_to_count(data.out_x);
-                y_stream[scnt] = convert_to_count(data.out_y);
-                z_stream[scnt] = convert_to_count(data.out_z);
-                scnt++;
-            }
-            else
-            {
-                // Signal analysis once the buffer is full
-                x_energy = calc_signal_energy(x_stream, scnt);
-                y_energy = calc_signal_energy(y_stream, scnt);
-                z_energy = calc_signal_energy(z_stream, scnt);
-                
-                info2("Signal energy");
-                info2("x %i,%i", (int32_t)x_energy, abs((int32_t)(x_energy*1000) - (((int32_t)x_energy) * 1000)));
-                info2("y %i,%i", (int32_t)y_energy, abs((int32_t)(y_energy*1000) - (((int32_t)y_energy) * 1000)));
-                info2("z %i,%i", (int32_t)z_energy, abs((int32_t)(z_energy*1000) - (((int32_t)z_energy) * 1000)));
-                scnt = 0;
-            }
-             
+            // Motion sets the thread flag
+            timeout = osWaitForever;
         }
-        else
+#endif
+        // Wake up once per batch of samples (or on timeout) and process everything collected
+        if (mma_acq_wait(timeout) > 0)
         {
-            // Either overflow or data not ready
+            process_samples();
         }
+#if MMA_MOTION
+        mma_motion_poll();
+        if (mma_motion_state() == MMA_MOTION_ACQUIRING)
+        {
+            mma_acq_poll();
+        }
+#else
+        // A trigger lost to a busy bus or a failed transfer leaves INT1 held, read the sample
+        mma_acq_poll();
+#endif
     }
 }
 
@@ -179,25 +440,64 @@ int main ()
     // Configure debug output.
     RETARGET_SerialInit();
     log_init(BASE_LOG_LEVEL, &logger_fwrite_boot, NULL);
+    blog_init(&logger_fwrite_boot);
 
     info1("Digi-sensor-demo "VERSION_STR" (%d.%d.%d)", VERSION_MAJOR, VERSION_MINOR, VERSION_PATCH);
 
+    // Free-running timebase for sample timestamps
+    sample_time_init();
+
+    // External interrupt dispatch, lines are registered by their users
+    gpio_exti_init();
+
+#if STAGE_TRACE
+    // Sample path latency tracing, dumped with the heartbeat
+    stage_trace_init();
+#endif
+
     // Initialize OS kernel.
     osKernelInitialize();
 
     // Create a thread.
-    const osThreadAttr_t app_thread_attr = { .name = "heartbeat" , .priority = osPriorityNormal2 };
-    osThreadNew(hb_loop, NULL, &app_thread_attr);
+    RTOS_THREAD_STATIC(hbThread, HB_THREAD_STACK_SIZE);
+    const osThreadAttr_t app_thread_attr = { .name = "heartbeat" , .priority = osPriorityNormal2, RTOS_THREAD_MEM(hbThread) };
+    rtos_thread_new(hb_loop, NULL, &app_thread_attr);
 
     // Create thread to receive data ready event and read data from sensor.
-    const osThreadAttr_t data_ready_thread_attr = { .name = "data_ready_thread" };
-    dataReadyThreadId = osThreadNew(mma_data_ready_loop, NULL, &data_ready_thread_attr);
+    RTOS_THREAD_STATIC(dataReadyThread, DATA_READY_THREAD_STACK_SIZE);
+    const osThreadAttr_t data_ready_thread_attr = { .name = "data_ready_thread", RTOS_THREAD_MEM(dataReadyThread) };
+    dataReadyThreadId = rtos_thread_new(mma_data_ready_loop, NULL, &data_ready_thread_attr);
+
+    // Create thread to analyze full sample windows, below data acquisition priority.
+    RTOS_THREAD_STATIC(analysisThread, ANALYSIS_THREAD_STACK_SIZE);
+    const osThreadAttr_t analysis_thread_attr = { .name = "analysis_thread", .priority = osPriorityBelowNormal,
+                                                  RTOS_THREAD_MEM(analysisThread) };
+    analysisThreadId = rtos_thread_new(analysis_loop, NULL, &analysis_thread_attr);
+    sample_window_init(analysisThreadId, ANALYSIS_THREAD_FLAG);
+    scratch_arena_init(&analysisArena, analysisArenaMem, sizeof(analysisArenaMem));
     
     if (osKernelReady == osKernelGetState())
     {
-        // Switch to a thread-safe logger
+        // Switch to a non-blocking logger, a low priority thread writes the records out
+#if SAMPLE_STREAM
+        // Raw samples and log output share the serial port in frames
+        sample_stream_init();
+        log_async_init(&sample_stream_log);
+#else
         logger_fwrite_init();
-        log_init(BASE_LOG_LEVEL, &logger_fwrite, NULL);
+        log_async_init(&logger_fwrite);
+#endif
+        log_init(BASE_LOG_LEVEL, &log_async_write, NULL);
+        blog_init(&log_async_write);
+
+#if FLASH_LOG
+        // Readout goes where the log goes
+#if SAMPLE_STREAM
+        flash_log_init(&sample_stream_log);
+#else
+        flash_log_init(&logger_fwrite);
+#endif
+#endif
 
         // Start the kernel
         osKernelStart();
@@ -209,47 +509,3 @@ int main ()
 
     for(;;);
 }
-
-/**
- * @brief 
- * Calculate energy of measured signal. 
- * 
- * @details 
- * Energy is calculated by subtracting bias from every sample and then adding 
- * together the square values of all samples. Energy is small if there is no 
- * signal (just measurement noise) and larger when a signal is present. 
- *
- * Disclaimer: The signal measured by the ADC is an elecrical signal, and its
- * unit would be joule, but since I don't know the exact load that the signal
- * is driving I can't account for the load. And so the energy I calculate here  
- * just indicates the presence or absence of a signal (and its relative 
- * strength), not the actual electrical energy in joules. 
- * Such a calculation can be done to all sorts of signals. There is probably
- * a more correct scientific term than energy for the result of this calculation
- * but I don't know what it is.
- *
- * Read about signal energy 
- * https://www.gaussianwaves.com/2013/12/power-and-energy-of-a-signal/
- *
- * @return Energy value.
- */
-float calc_signal_energy(float buf[], uint32_t num_elements)
-{
-    static uint32_t i;
-    static float signal_bias, signal_energy, res;
-
-    signal_bias = signal_energy = res = 0;
-
-    for (i = 0; i < num_elements; i++)
-    {
-        signal_bias += buf[i];
-    }
-    signal_bias /= num_elements;
-
-    for (i = 0; i < num_elements; i++)
-    {
-        res = buf[i] - signal_bias; // Subtract bias
-        signal_energy += res * res;
-    }
-    return signal_energy;
-}
@@ -0,0 +1,87 @@
+/**
+ * @file blog.c
+ *
+ * @brief   Binary log records with deferred formatting, see blog.h.
+ *
+ * @author agent
+ * @license MIT
+ *
+ * Copyright agent, 2026
+ */
+
+#include "blog.h"
+
+#if LOG_BINARY
+
+#include <stdarg.h>
+
+#include "cmsis_os2.h"
+
+// Start of the format strings, defined by the linker
+extern const char __start_blog_fmt[];
+
+// Keeps the section, and __start_blog_fmt, in programs without blog_ calls (benchmarks, tests)
+static const char blogFmtEmpty[] __attribute__((section("blog_fmt"), used)) = "";
+
+static log_output_f blogOutput;
+
+/**
+ * @brief   Set the output records are written to, records are dropped until this is called.
+ */
+void blog_init (log_output_f output)
+{
+    blogOutput = output;
+}
+
+static uint32_t put_varint (uint8_t * buf, uint32_t len, uint32_t v)
+{
+    while (v >= 0x80)
+    {
+        buf[len++] = (uint8_t)(v | 0x80);
+        v >>= 7;
+    }
+    buf[len++] = (uint8_t)v;
+    return len;
+}
+
+/**
+ * @brief   Encode and output one record, called by the blog_ macros.
+ *
+ * @param   level Log level bit.
+ * @param   fmt Format string in the blog_fmt section.
+ * @param   nargs Number of arguments, each an integer of at most 32 bits.
+ */
+void blog_write (uint16_t level, const char * fmt, uint32_t nargs, ...)
+{
+    uint8_t rec[BLOG_RECORD_MAX];
+    uint32_t len = 3;
+    uint32_t ms;
+    va_list args;
+
+    if (blogOutput == NULL)
+    {
+        return;
+    }
+
+    ms = (uint32_t)((uint64_t)osKernelGetTickCount() * 1000 / osKernelGetTickFreq());
+
+    rec[0] = BLOG_SYNC;
+    rec[2] = (uint8_t)__builtin_ctz(level);
+    len = put_varint(rec, len, (uint32_t)(fmt - __start_blog_fmt));
+    len = put_varint(rec, len, ms);
+
+    va_start(args, nargs);
+    while (nargs-- > 0)
+    {
+        // 32 bit integers are passed as int, zigzag keeps small negative values short
+        int32_t v = (int32_t)va_arg(args, int);
+
+        len = put_varint(rec, len, ((uint32_t)v << 1) ^ (uint32_t)(v >> 31));
+    }
+    va_end(args);
+
+    rec[1] = (uint8_t)(len - 2);
+    blogOutput((const char *)rec, len);
+}
+
+#endif // LOG_BINARY
@@ -0,0 +1,87 @@
+/**
+ * @file blog.h
+ *
+ * @brief   Binary log records with deferred formatting.
+ *
+ * @details blog_info1() ... blog_err1() take the same arguments as the lll macros. With
+ *          LOG_BINARY=0 (the default) they are the lll macros. With LOG_BINARY=1 the format
+ *          string is placed in the blog_fmt section and never read on the target, a record
+ *          carries its offset in the section and the arguments. The host tool
+ *          digi-sensor-blog (host/blog_decode.c) formats the records with the strings from
+ *          the ELF file.
+ *
+ *          Every argument is sent as a 32 bit value, only integer conversions (d i u x X o c
+ *          with h, hh, l length modifiers) can be used. Arguments are checked against the
+ *          format at compile time.
+ *
+ *          Record: BLOG_SYNC, payload length, level bit, then varints: format offset,
+ *          timestamp ms and the zigzag encoded arguments. Text output (boot messages, other
+ *          log calls) passes through the same stream and never contains BLOG_SYNC.
+ *
+ *          The including file defines __MODUUL__ and __LOG_LEVEL__ and includes log.h first.
+ *
+ * @author agent
+ * @license MIT
+ *
+ * Copyright agent, 2026
+ */
+
+#ifndef BLOG_H_
+#define BLOG_H_
+
+#include <stdint.h>
+
+#include "loggers_ext.h"
+
+#ifndef LOG_BINARY
+#define LOG_BINARY              0   // Set from the Makefile
+#endif
+
+#define BLOG_SYNC               0xFE
+#define BLOG_MAX_ARGS           8
+#define BLOG_RECORD_MAX         (3 + 3 + 5 + (BLOG_MAX_ARGS * 5))
+
+#if LOG_BINARY
+
+// Number of arguments after the format string
+#define BLOG_NARGS_(f, a1, a2, a3, a4, a5, a6, a7, a8, n, ...) n
+#define BLOG_NARGS(...)         BLOG_NARGS_(__VA_ARGS__, 8, 7, 6, 5, 4, 3, 2, 1, 0, err)
+#define BLOG_FMT_(...)          BLOG_FMT__(__VA_ARGS__, 0)
+#define BLOG_FMT__(f, ...)      f
+#define BLOG_WRITE_(lvl, p, n, f, ...) blog_write((lvl), (p), (n), ##__VA_ARGS__)
+
+#define BLOG_(lvl, ...) do { if ((__LOG_LEVEL__) & (lvl)) {                                       \
+        static const char blogFmt[] __attribute__((section("blog_fmt"), used)) =                    \
+            __MODUUL__ ": " BLOG_FMT_(__VA_ARGS__);                                                 \
+        if (0) { blog_check(__VA_ARGS__); }                                                         \
+        BLOG_WRITE_((lvl), blogFmt, BLOG_NARGS(__VA_ARGS__), __VA_ARGS__); } } while (0)
+
+#define blog_debug1(...)        BLOG_(LOG_DEBUG1, __VA_ARGS__)
+#define blog_info2(...)         BLOG_(LOG_INFO2, __VA_ARGS__)
+#define blog_info1(...)         BLOG_(LOG_INFO1, __VA_ARGS__)
+#define blog_warn1(...)         BLOG_(LOG_WARN1, __VA_ARGS__)
+#define blog_err1(...)          BLOG_(LOG_ERR1, __VA_ARGS__)
+
+// Public functions
+void blog_init(log_output_f output);
+void blog_write(uint16_t level, const char * fmt, uint32_t nargs, ...);
+
+// Only for format checking, never called
+static inline void __attribute__((format(printf, 1, 2))) blog_check (const char * fmt, ...)
+{
+    (void)fmt;
+}
+
+#else
+
+#define blog_debug1(...)        debug1(__VA_ARGS__)
+#define blog_info2(...)         info2(__VA_ARGS__)
+#define blog_info1(...)         info1(__VA_ARGS__)
+#define blog_warn1(...)         warn1(__VA_ARGS__)
+#define blog_err1(...)          err1(__VA_ARGS__)
+
+#define blog_init(output)       ((void)0)
+
+#endif // LOG_BINARY
+
+#endif // BLOG_H_
@@ -0,0 +1,112 @@
+/**
+ * @file dsp_stats.c
+ *
+ * @brief   Sum, sum of squares, min and max over blocks of int16 samples.
+ *
+ * @details On Cortex-M4 (__ARM_FEATURE_DSP) two samples are processed per 32-bit word
+ *          with the DSP extension:
+ *            SMLAD  sum   += x0 + x1          (dual MAC with 1, 1)
+ *            SMLALD sumSq += x0*x0 + x1*x1    (dual MAC, 64-bit accumulator)
+ *            SSUB16 + SEL                     (packed min and max)
+ *          The portable C loop is used on other targets and for the odd last sample.
+ *          Both give the same result bit for bit, all arithmetic is exact integer.
+ *
+ *          At most SIGNAL_STATS_MAX_N samples per block, the sum is 32 bits wide.
+ *
+ * ARMv7-M Architecture Reference Manual (SMLAD A7.7.135, SMLALD A7.7.137, SEL A7.7.117)
+ * https://developer.arm.com/documentation/ddi0403/latest
+ *
+ * @author agent
+ * @license MIT
+ *
+ * Copyright agent, 2026
+ */
+
+#include <string.h>
+
+#include "dsp_stats.h"
+
+#ifndef DSP_STATS_SIMD         // The host test builds the SIMD path with emulated intrinsics
+#if defined(__ARM_FEATURE_DSP) && (__ARM_FEATURE_DSP == 1)
+#include "em_device.h"  // CMSIS SIMD intrinsics
+#define DSP_STATS_SIMD  1
+#else
+#define DSP_STATS_SIMD  0
+#endif
+#endif
+
+/**
+ * @brief   Calculate statistics of n samples.
+ *
+ * @param   buf Samples, any alignment.
+ * @param   n Number of samples, min and max are 0 if n is 0.
+ * @param   out Result.
+ */
+void dsp_stats_block (const int16_t buf[], uint32_t n, dsp_stats_t * out)
+{
+    int32_t sum = 0;
+    int64_t sumSq = 0;
+    int16_t min = INT16_MAX;
+    int16_t max = INT16_MIN;
+    uint32_t i = 0;
+
+#if DSP_STATS_SIMD
+    if (n >= 2)
+    {
+        uint32_t pmin = 0x7FFF7FFF; // Packed min/max, one sample per halfword
+        uint32_t pmax = 0x80008000;
+        uint32_t pair;
+
+        for (; i + 2 <= n; i += 2)
+        {
+            memcpy(&pair, &buf[i], sizeof(pair)); // Single LDR, unaligned access is allowed
+            sum = (int32_t)__SMLAD(pair, 0x00010001, (uint32_t)sum);
+            sumSq = (int64_t)__SMLALD(pair, pair, (uint64_t)sumSq);
+
+            // SEL picks halfwords by the GE flags of the preceding SSUB16, keep the pairs together.
+            (void)__SSUB16(pair, pmin);
+            pmin = __SEL(pmin, pair);
+            (void)__SSUB16(pair, pmax);
+            pmax = __SEL(pair, pmax);
+        }
+
+        // Fold the two lanes
+        min = (int16_t)pmin;
+        if ((int16_t)(pmin >> 16) < min)
+        {
+            min = (int16_t)(pmin >> 16);
+        }
+        max = (int16_t)pmax;
+        if ((int16_t)(pmax >> 16) > max)
+        {
+            max = (int16_t)(pmax >> 16);
+        }
+    }
+#endif
+
+    for (; i < n; i++)
+    {
+        int16_t x = buf[i];
+
+        sum += x;
+        sumSq += (int32_t)x * x;
+        min = (x < min) ? x : min;
+        max = (x > max) ? x : max;
+    }
+
+    out->acc.n = n;
+    out->acc.sum = sum;
+    out->acc.sumSq = sumSq;
+    out->min = (n > 0) ? min : 0;
+    out->max = (n > 0) ? max : 0;
+}
+
+/**
+ * @brief   Calculate statistics of a window of x, y and z samples.
+ */
+void dsp_stats_xyz (const int16_t x[], const int16_t y[], const int16_t z[], uint32_t n, dsp_stats_t out[3])
+{
+    dsp_stats_block(x, n, &out[0]);
+    dsp_stats_block(y, n, &out[1]);
+    dsp_stats_block(z, n, &out[2]);
+}
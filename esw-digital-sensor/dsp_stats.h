@@ -0,0 +1,28 @@
+/**
+ * @file dsp_stats.h
+ *
+ * @author agent
+ * @license MIT
+ *
+ * Copyright agent, 2026
+ */
+
+#ifndef DSP_STATS_H_
+#define DSP_STATS_H_
+
+#include <stdint.h>
+
+#include "signal_stats.h"
+
+typedef struct
+{
+    signal_stats_q_t acc;   // n, sum and sum of squares, see signal_stats_q_energy()
+    int16_t min;
+    int16_t max;
+} dsp_stats_t;
+
+// Public functions
+void dsp_stats_block(const int16_t buf[], uint32_t n, dsp_stats_t * out);
+void dsp_stats_xyz(const int16_t x[], const int16_t y[], const int16_t z[], uint32_t n, dsp_stats_t out[3]);
+
+#endif // DSP_STATS_H_
@@ -0,0 +1,144 @@
+/**
+ * @file fft.c
+ *
+ * @brief   Power spectrum of a window of real samples, band energies and dominant frequency.
+ *
+ * @details The mean is removed and a Hann window applied. The N real samples are packed
+ *          into N/2 complex values (even samples real, odd samples imaginary), transformed
+ *          with an in-place radix-2 FFT and split into the N/2 + 1 bins of the real
+ *          spectrum. This takes about half the work of a complex N point FFT.
+ *
+ *          Twiddle factors, window and bit reversal indices are generated for FFT_LENGTH
+ *          by fft_tables_gen at build time and are const, so they stay in flash. A shorter
+ *          power of two N uses every (FFT_LENGTH / N)th twiddle and window value, its bit
+ *          reversal is the FFT_LENGTH one shifted right by log2(FFT_LENGTH / N).
+ *
+ * @author agent
+ * @license MIT
+ *
+ * Copyright agent, 2026
+ */
+
+#include "fft.h"
+#include "fft_tables.h"
+
+#if FFT_TABLES_LENGTH != FFT_LENGTH
+#error "fft_tables.h was generated for a different FFT_LENGTH, regenerate it (make clean)"
+#endif
+
+/**
+ * @brief   Check that n samples can be analyzed.
+ *
+ * @return  true if n is a power of two from 2 * FFT_BANDS to FFT_LENGTH
+ */
+bool fft_length_valid (uint32_t n)
+{
+    return (n >= 2 * FFT_BANDS) && (n <= FFT_LENGTH) && ((n & (n - 1)) == 0);
+}
+
+/**
+ * @brief   Analyze n samples.
+ *
+ * @param   in Samples.
+ * @param   n Number of samples, fft_length_valid(n) must hold.
+ * @param   work Scratch buffer of n values, contents are overwritten.
+ * @param   res Result.
+ */
+void fft_analyze (const int16_t in[], uint32_t n, float work[], fft_result_t * res)
+{
+    float mean = 0.0f;
+    uint32_t half = n / 2;
+    uint32_t binsPerBand = half / FFT_BANDS;
+    uint32_t stride = FFT_LENGTH / n;   // Table step for length n
+    uint32_t shift = 0;                 // log2(stride)
+    uint32_t i, k, size, start;
+
+    while ((stride >> shift) > 1)
+    {
+        shift++;
+    }
+
+    for (i = 0; i < n; i++)
+    {
+        mean += (float)in[i];
+    }
+    mean /= n;
+
+    // Remove bias, apply window and pack sample pairs as complex values in bit reversed order.
+    for (i = 0; i < half; i++)
+    {
+        uint32_t j = fftBitRev[i] >> shift;
+
+        work[2*j] = ((float)in[2*i] - mean) * fftWindow[2*i*stride];
+        work[2*j + 1] = ((float)in[2*i + 1] - mean) * fftWindow[(2*i + 1) * stride];
+    }
+
+    // Radix-2 decimation in time butterflies, W_size^k = W_FFT_LENGTH^(k * FFT_LENGTH / size)
+    for (size = 2; size <= half; size *= 2)
+    {
+        uint32_t bf = size / 2;
+        uint32_t step = FFT_LENGTH / size;
+
+        for (start = 0; start < half; start += size)
+        {
+            for (k = 0; k < bf; k++)
+            {
+                float wr = fftCos[k * step];
+                float wi = -fftSin[k * step];
+                float * a = &work[2 * (start + k)];
+                float * b = &work[2 * (start + k + bf)];
+                float tr = b[0] * wr - b[1] * wi;
+                float ti = b[0] * wi + b[1] * wr;
+
+                b[0] = a[0] - tr;
+                b[1] = a[1] - ti;
+                a[0] += tr;
+                a[1] += ti;
+            }
+        }
+    }
+
+    for (i = 0; i < FFT_BANDS; i++)
+    {
+        res->bandEnergy[i] = 0.0f;
+    }
+    res->dominantBin = 1;
+    res->dominantPower = -1.0f;
+
+    // Split into the real spectrum, X[k] = Fe[k] + W_N^k * Fo[k], DC (k = 0) is skipped.
+    for (k = 1; k <= half; k++)
+    {
+        const float * z = &work[2 * (k % half)];
+        const float * zc = &work[2 * (half - k)];
+        float c = (k < half) ? fftCos[k * stride] : -1.0f;
+        float s = (k < half) ? fftSin[k * stride] : 0.0f;
+        float feR = (z[0] + zc[0]) * 0.5f;
+        float feI = (z[1] - zc[1]) * 0.5f;
+        float foR = (z[1] + zc[1]) * 0.5f;
+        float foI = (zc[0] - z[0]) * 0.5f;
+        float xr = feR + c * foR + s * foI;
+        float xi = feI + c * foI - s * foR;
+        float power = xr * xr + xi * xi;
+
+        res->bandEnergy[(k - 1) / binsPerBand] += power;
+        if (power > res->dominantPower)
+        {
+            res->dominantPower = power;
+            res->dominantBin = k;
+        }
+    }
+}
+
+/**
+ * @brief   Center frequency of a bin.
+ *
+ * @param   bin Bin number, 0 ... n/2.
+ * @param   n Number of samples analyzed.
+ * @param   sampleRateMhz Sample rate in mHz.
+ *
+ * @return  Frequency in mHz
+ */
+uint32_t fft_bin_to_mhz (uint16_t bin, uint32_t n, uint32_t sampleRateMhz)
+{
+    return (uint32_t)(((uint64_t)bin * sampleRateMhz) / n);
+}
@@ -0,0 +1,37 @@
+/**
+ * @file fft.h
+ *
+ * @author agent
+ * @license MIT
+ *
+ * Copyright agent, 2026
+ */
+
+#ifndef FFT_H_
+#define FFT_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifndef FFT_LENGTH
+#define FFT_LENGTH      32  // Longest transform, power of two, set from the Makefile
+#endif
+#define FFT_BANDS       4   // Equal width bands between the first bin and Nyquist
+
+#if (FFT_LENGTH < 2 * FFT_BANDS) || ((FFT_LENGTH & (FFT_LENGTH - 1)) != 0)
+#error "FFT_LENGTH must be a power of two and at least 2 * FFT_BANDS"
+#endif
+
+typedef struct
+{
+    float bandEnergy[FFT_BANDS];    // Sum of |X[k]|^2, band b has bins b * N/(2*FFT_BANDS) + 1 ... (b+1) * N/(2*FFT_BANDS)
+    uint16_t dominantBin;           // Bin with the highest power, 1 ... N/2
+    float dominantPower;            // |X[dominantBin]|^2
+} fft_result_t;
+
+// Public functions
+bool fft_length_valid(uint32_t n);
+void fft_analyze(const int16_t in[], uint32_t n, float work[], fft_result_t * res);
+uint32_t fft_bin_to_mhz(uint16_t bin, uint32_t n, uint32_t sampleRateMhz);
+
+#endif // FFT_H_
@@ -0,0 +1,82 @@
+/**
+ * @file fft_tables_gen.c
+ *
+ * @brief   Build host tool, writes the FFT twiddle, window and bit reversal tables for
+ *          fft.c to stdout as a C header. Run by the Makefile, the tables end up in flash.
+ *
+ *          Usage: fft_tables_gen <length>, length is a power of two, 8 ... 4096.
+ *
+ * @author agent
+ * @license MIT
+ *
+ * Copyright agent, 2026
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+
+#define PI  3.14159265358979323846
+
+static void print_float_table (const char * name, double (*f)(unsigned, unsigned), unsigned count, unsigned length)
+{
+    unsigned i;
+
+    printf("static const float %s[%u] = {", name, count);
+    for (i = 0; i < count; i++)
+    {
+        printf("%s%.9ef%s", (i % 4) ? " " : "\n    ", f(i, length), (i < count - 1) ? "," : "");
+    }
+    printf("\n};\n\n");
+}
+
+static double twiddle_cos (unsigned k, unsigned n)
+{
+    return cos(2 * PI * k / n);
+}
+
+static double twiddle_sin (unsigned k, unsigned n)
+{
+    return sin(2 * PI * k / n);
+}
+
+// Periodic Hann window
+static double hann (unsigned k, unsigned n)
+{
+    return 0.5 * (1 - cos(2 * PI * k / n));
+}
+
+int main (int argc, char * argv[])
+{
+    unsigned length, half, bits, i, j, r;
+
+    length = (argc == 2) ? (unsigned)strtoul(argv[1], NULL, 0) : 0;
+    if ((length < 8) || (length > 4096) || ((length & (length - 1)) != 0))
+    {
+        fprintf(stderr, "usage: %s <length>, length is a power of two 8 ... 4096\n", argv[0]);
+        return 1;
+    }
+    half = length / 2;
+    for (bits = 0; (1u << bits) < half; bits++);
+
+    printf("/* Generated by fft_tables_gen, do not edit. */\n\n");
+    printf("#define FFT_TABLES_LENGTH %u\n\n", length);
+
+    // W_N^k = cos(2 pi k / N) - i sin(2 pi k / N), k < N/2
+    print_float_table("fftCos", twiddle_cos, half, length);
+    print_float_table("fftSin", twiddle_sin, half, length);
+    print_float_table("fftWindow", hann, length, length);
+
+    // Bit reversed indices of the N/2 point complex FFT
+    printf("static const uint16_t fftBitRev[%u] = {", half);
+    for (i = 0; i < half; i++)
+    {
+        for (r = 0, j = 0; j < bits; j++)
+        {
+            r |= ((i >> j) & 1) << (bits - 1 - j);
+        }
+        printf("%s%u%s", (i % 8) ? " " : "\n    ", r, (i < half - 1) ? "," : "");
+    }
+    printf("\n};\n");
+    return 0;
+}
@@ -0,0 +1,359 @@
+/**
+ * @file flash_log.c
+ *
+ * @brief   Recording of the raw x/y/z samples into a circular log of internal flash pages,
+ *          see flash_log.h for the page format.
+ *
+ * @details The acquisition thread encodes samples into a page buffer in RAM. A full page is
+ *          handed to a low priority writer thread, which erases the next flash page and
+ *          programs the buffer into it, so the acquisition thread never waits for flash. If
+ *          the writer still has every buffer when a page is to be started, samples are dropped
+ *          and counted; the sample index in the next page shows the gap.
+ *
+ *          The writer thread also polls the serial port for commands: FLASH_LOG_CMD_READOUT
+ *          sends the log out, FLASH_LOG_CMD_ERASE erases it. The page being filled is not
+ *          part of the log until it is full.
+ *
+ * @note    Flash reads stall while a page is erased or programmed (tens of ms per page, see
+ *          the datasheet). Interrupts are served late meanwhile, at high data rates the
+ *          sensor may overwrite a sample before it is read.
+ *
+ * @author agent
+ * @license MIT
+ *
+ * Copyright agent, 2026
+ */
+
+#include "flash_log.h"
+
+#if FLASH_LOG
+
+#include <stddef.h>
+#include <inttypes.h>
+#include <string.h>
+
+#include "cmsis_os2.h"
+#include "retargetserial.h"
+
+#include "checksum.h"
+#include "tickless_idle.h"
+#include "rtos_static.h"
+
+#include "log_async.h"
+
+#include "loglevels.h"
+#define __MODUUL__ "flog"
+#define __LOG_LEVEL__ (LOG_LEVEL_main & BASE_LOG_LEVEL)
+#include "log.h"
+
+#define FLASH_LOG_THREAD_FLAG       0x01
+#define FLASH_LOG_CRC_START         offsetof(flash_log_page_hdr_t, len)
+
+// Page buffers, a full buffer belongs to the writer thread until it clears pageFull
+static uint32_t pageBuf[FLASH_LOG_BUFFERS][FLASH_MSC_PAGE_SIZE / sizeof(uint32_t)];
+static volatile bool pageFull[FLASH_LOG_BUFFERS];
+
+// Acquisition thread
+static uint8_t fillBuf;
+static bool filling;
+static int16_t prev[3];
+static uint32_t sampleIndex;
+static uint8_t boot;
+
+// Writer thread
+static uint8_t writeBuf;
+static uint32_t nextPage;
+static uint32_t nextSeq;
+static uint32_t readBuf[FLASH_MSC_PAGE_SIZE / sizeof(uint32_t)];
+static log_output_f readoutOutput;
+static osThreadId_t writerThreadId;
+
+static volatile uint32_t pagesWritten;
+static volatile uint32_t samplesDropped;
+static volatile uint32_t errors;
+
+static void flash_log_loop (void * args);
+
+static uint32_t page_addr (uint32_t page)
+{
+    return FLASH_LOG_START + (page * FLASH_MSC_PAGE_SIZE);
+}
+
+static uint16_t page_crc (const flash_log_page_hdr_t * hdr)
+{
+    return crc_ccitt_ffff((const unsigned char *)hdr + FLASH_LOG_CRC_START,
+                          sizeof(flash_log_page_hdr_t) - FLASH_LOG_CRC_START + hdr->len);
+}
+
+/**
+ * @brief   Read a page into readBuf and check it.
+ *
+ * @return  true if the page holds a complete log page
+ */
+static bool page_read (uint32_t page)
+{
+    flash_log_page_hdr_t * hdr = (flash_log_page_hdr_t *)readBuf;
+
+    flash_msc_read(page_addr(page), hdr, sizeof(flash_log_page_hdr_t));
+    if ((hdr->magic != FLASH_LOG_MAGIC) || (hdr->len > FLASH_LOG_PAYLOAD_MAX))
+    {
+        return false;
+    }
+    flash_msc_read(page_addr(page) + sizeof(flash_log_page_hdr_t), hdr + 1, hdr->len);
+    return page_crc(hdr) == hdr->crc;
+}
+
+/**
+ * @brief   Find the newest page and start the writer thread, call before osKernelStart().
+ *
+ * @param   readout Output for the log readout, the same as the log output.
+ *
+ * @return  -1 if the flash area is not usable or the thread could not be created
+ *           0 otherwise
+ */
+int8_t flash_log_init (log_output_f readout)
+{
+    RTOS_THREAD_STATIC(writerThread, FLASH_LOG_STACK_SIZE);
+    const osThreadAttr_t flash_log_thread_attr = { .name = "flash_log", .priority = osPriorityLow, RTOS_THREAD_MEM(writerThread) };
+    const flash_log_page_hdr_t * hdr = (const flash_log_page_hdr_t *)readBuf;
+    uint32_t valid = 0;
+    uint32_t page;
+
+    readoutOutput = readout;
+    if (flash_msc_init(FLASH_LOG_START, FLASH_LOG_PAGES * FLASH_MSC_PAGE_SIZE) != 0)
+    {
+        err1("Flash area %08"PRIX32" not usable", (uint32_t)FLASH_LOG_START);
+        return -1;
+    }
+
+    // Continue after the newest page, it is followed by the oldest one
+    for (page = 0; page < FLASH_LOG_PAGES; page++)
+    {
+        if (page_read(page))
+        {
+            if ((valid == 0) || (hdr->seq >= nextSeq))
+            {
+                nextSeq = hdr->seq + 1;
+                nextPage = (page + 1) % FLASH_LOG_PAGES;
+                boot = hdr->boot + 1;
+            }
+            valid++;
+        }
+    }
+    info1("Flash log %"PRIu32" of %"PRIu32" pages used, next page %"PRIu32", boot %u", valid, (uint32_t)FLASH_LOG_PAGES, nextPage, boot);
+
+    // The serial receiver stops in EM2, commands would be lost
+    tickless_em2_block();
+
+    writerThreadId = rtos_thread_new(flash_log_loop, NULL, &flash_log_thread_attr);
+    return (writerThreadId == NULL) ? -1 : 0;
+}
+
+static uint32_t put_varint (uint8_t * buf, uint32_t len, uint32_t v)
+{
+    while (v >= 0x80)
+    {
+        buf[len++] = (uint8_t)(v | 0x80);
+        v >>= 7;
+    }
+    buf[len++] = (uint8_t)v;
+    return len;
+}
+
+static bool page_open (uint8_t resolution, uint32_t odrMhz)
+{
+    flash_log_page_hdr_t * hdr = (flash_log_page_hdr_t *)pageBuf[fillBuf];
+
+    if (__atomic_load_n(&pageFull[fillBuf], __ATOMIC_ACQUIRE))
+    {
+        return false;
+    }
+    hdr->len = 0;
+    hdr->index = sampleIndex;
+    hdr->ms = (uint32_t)((uint64_t)osKernelGetTickCount() * 1000 / osKernelGetTickFreq());
+    hdr->odrMhz = odrMhz;
+    hdr->count = 0;
+    hdr->resolution = resolution;
+    hdr->boot = boot;
+    memset(prev, 0, sizeof(prev));
+    filling = true;
+    return true;
+}
+
+static void page_close (void)
+{
+    __atomic_store_n(&pageFull[fillBuf], true, __ATOMIC_RELEASE);
+    fillBuf = (fillBuf + 1) % FLASH_LOG_BUFFERS;
+    filling = false;
+    osThreadFlagsSet(writerThreadId, FLASH_LOG_THREAD_FLAG);
+}
+
+/**
+ * @brief   Add a sample (acquisition thread), the page is written when it is full.
+ *
+ * @param   x, y, z Counts.
+ * @param   resolution Sample resolution in bits.
+ * @param   odrMhz Output data rate the sample was taken at.
+ */
+void flash_log_add (int16_t x, int16_t y, int16_t z, uint8_t resolution, uint32_t odrMhz)
+{
+    const int16_t v[3] = { x, y, z };
+    flash_log_page_hdr_t * hdr = (flash_log_page_hdr_t *)pageBuf[fillBuf];
+    uint8_t * payload = (uint8_t *)(hdr + 1);
+    uint32_t len;
+    uint8_t i;
+
+    // A page has one data rate and resolution
+    if (filling && ((hdr->resolution != resolution) || (hdr->odrMhz != odrMhz)))
+    {
+        page_close();
+        hdr = (flash_log_page_hdr_t *)pageBuf[fillBuf];
+        payload = (uint8_t *)(hdr + 1);
+    }
+    if (!filling && !page_open(resolution, odrMhz))
+    {
+        samplesDropped++;
+        sampleIndex++;
+        return;
+    }
+
+    len = hdr->len;
+    for (i = 0; i < 3; i++)
+    {
+        // Zigzag keeps small negative deltas short
+        int32_t d = (int32_t)v[i] - prev[i];
+
+        len = put_varint(payload, len, ((uint32_t)d << 1) ^ (uint32_t)(d >> 31));
+        prev[i] = v[i];
+    }
+    hdr->len = (uint16_t)len;
+    hdr->count++;
+    sampleIndex++;
+
+    if (len + FLASH_LOG_SAMPLE_MAX > FLASH_LOG_PAYLOAD_MAX)
+    {
+        page_close();
+    }
+}
+
+/**
+ * @brief   Program a full page buffer into the next flash page (writer thread).
+ */
+static void page_write (uint8_t b)
+{
+    flash_log_page_hdr_t * hdr = (flash_log_page_hdr_t *)pageBuf[b];
+    uint32_t size = (sizeof(flash_log_page_hdr_t) + hdr->len + 3) & ~3UL;
+    uint32_t addr = page_addr(nextPage);
+
+    // Programming is done in words, the padding is left erased
+    memset((uint8_t *)(hdr + 1) + hdr->len, 0xFF, size - sizeof(flash_log_page_hdr_t) - hdr->len);
+    hdr->magic = FLASH_LOG_MAGIC;
+    hdr->seq = nextSeq;
+    hdr->crc = page_crc(hdr);
+
+    if ((flash_msc_erase_page(addr) != 0) || (flash_msc_write(addr, hdr, size) != 0))
+    {
+        errors++;
+        warn1("Flash page %"PRIu32" write failed", nextPage);
+    }
+    else
+    {
+        pagesWritten++;
+    }
+    nextPage = (nextPage + 1) % FLASH_LOG_PAGES;
+    nextSeq++;
+}
+
+/**
+ * @brief   Send the valid pages out, oldest first (writer thread).
+ */
+static void readout (void)
+{
+    const flash_log_page_hdr_t * hdr = (const flash_log_page_hdr_t *)readBuf;
+    uint32_t pages = 0;
+    uint32_t i;
+
+    info1("Flash readout");
+    for (i = 0; i < FLASH_LOG_PAGES; i++)
+    {
+        uint32_t page = (nextPage + i) % FLASH_LOG_PAGES;
+
+        if (page_read(page))
+        {
+            // Keep log lines out of the page
+            log_async_flush(osWaitForever);
+            readoutOutput((const char *)readBuf, sizeof(flash_log_page_hdr_t) + hdr->len);
+            pages++;
+        }
+    }
+    info1("Flash readout done, %"PRIu32" pages", pages);
+}
+
+static void erase (void)
+{
+    uint32_t page;
+
+    for (page = 0; page < FLASH_LOG_PAGES; page++)
+    {
+        if (flash_msc_erase_page(page_addr(page)) != 0)
+        {
+            errors++;
+        }
+    }
+    info1("Flash log erased");
+}
+
+static void flash_log_loop (void * args)
+{
+    for (;;)
+    {
+        int c;
+
+        osThreadFlagsWait(FLASH_LOG_THREAD_FLAG, osFlagsWaitAny, FLASH_LOG_CMD_POLL_MS * osKernelGetTickFreq() / 1000);
+
+        while (__atomic_load_n(&pageFull[writeBuf], __ATOMIC_ACQUIRE))
+        {
+            page_write(writeBuf);
+            __atomic_store_n(&pageFull[writeBuf], false, __ATOMIC_RELEASE);
+            writeBuf = (writeBuf + 1) % FLASH_LOG_BUFFERS;
+        }
+
+        while ((c = RETARGET_ReadChar()) >= 0)
+        {
+            if (c == FLASH_LOG_CMD_READOUT)
+            {
+                readout();
+            }
+            else if (c == FLASH_LOG_CMD_ERASE)
+            {
+                erase();
+            }
+        }
+    }
+}
+
+/**
+ * @brief   Pages written since boot.
+ */
+uint32_t flash_log_pages (void)
+{
+    return pagesWritten;
+}
+
+/**
+ * @brief   Samples dropped because no page buffer was free.
+ */
+uint32_t flash_log_dropped (void)
+{
+    return samplesDropped;
+}
+
+/**
+ * @brief   Failed page erases and writes.
+ */
+uint32_t flash_log_errors (void)
+{
+    return errors;
+}
+
+#endif // FLASH_LOG
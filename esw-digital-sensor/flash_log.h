@@ -0,0 +1,77 @@
+/**
+ * @file flash_log.h
+ *
+ * @brief   Recording of the raw x/y/z samples into a circular log of internal flash pages.
+ *
+ * @details A page starts with flash_log_page_hdr_t, the payload holds the samples of the page
+ *          as deltas to the previous sample (the first one to 0), x, y and z each as a zigzag
+ *          varint. The CRC-CCITT (0xFFFF) covers the header from len and the payload. Pages
+ *          are written in turn through the whole area, so every page is erased once per lap,
+ *          and seq tells their order. A page that was being written at a reset fails the
+ *          CRC and is skipped.
+ *
+ *          Readout sends the valid pages, oldest first, as they are in flash (header and
+ *          payload), the receiver finds them by magic and CRC.
+ *
+ * @author agent
+ * @license MIT
+ *
+ * Copyright agent, 2026
+ */
+
+#ifndef FLASH_LOG_H_
+#define FLASH_LOG_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "loggers_ext.h"
+
+#include "flash_msc.h"
+
+#ifndef FLASH_LOG
+#define FLASH_LOG                   0           // Set from the Makefile
+#endif
+
+#ifndef FLASH_LOG_START
+#define FLASH_LOG_START             0x000B0000  // Set from the Makefile, must be clear of the application
+#endif
+
+#ifndef FLASH_LOG_PAGES
+#define FLASH_LOG_PAGES             128         // Set from the Makefile
+#endif
+
+#define FLASH_LOG_MAGIC             0x31474C46UL    // "FLG1"
+#define FLASH_LOG_BUFFERS           2               // Pages being filled or written
+#define FLASH_LOG_PAYLOAD_MAX       (FLASH_MSC_PAGE_SIZE - sizeof(flash_log_page_hdr_t))
+#define FLASH_LOG_SAMPLE_MAX        9               // 3 varints of up to 17 bits
+
+// Serial commands, checked by the writer thread every FLASH_LOG_CMD_POLL_MS
+#define FLASH_LOG_CMD_READOUT       'R'
+#define FLASH_LOG_CMD_ERASE         'E'
+#define FLASH_LOG_CMD_POLL_MS       100
+#define FLASH_LOG_STACK_SIZE        1536            // Writer thread, bytes, readout formatting
+
+typedef struct
+{
+    uint32_t magic;         // FLASH_LOG_MAGIC
+    uint16_t crc;           // From len to the end of the payload
+    uint16_t len;           // Payload bytes
+    uint32_t seq;           // Pages written before this one, across resets
+    uint32_t index;         // Index of the first sample since boot, counts dropped samples too
+    uint32_t ms;            // Time of the first sample since boot
+    uint32_t odrMhz;        // Output data rate
+    uint16_t count;         // Samples in the page
+    uint8_t resolution;     // Sample resolution in bits
+    uint8_t boot;           // Incremented at every start, index and ms restart with it
+} flash_log_page_hdr_t;
+
+// Public functions
+int8_t flash_log_init(log_output_f readout);
+void flash_log_add(int16_t x, int16_t y, int16_t z, uint8_t resolution, uint32_t odrMhz);
+
+uint32_t flash_log_pages(void);
+uint32_t flash_log_dropped(void);
+uint32_t flash_log_errors(void);
+
+#endif // FLASH_LOG_H_
@@ -0,0 +1,66 @@
+/**
+ * @file flash_msc.c
+ *
+ * @brief   Internal flash access for flash_log.c through em_msc.
+ *
+ * @details Flash is memory mapped, reads are copies. Erase and program run from RAM in
+ *          em_msc, the core stalls on flash fetches meanwhile.
+ *
+ * EFR32MG12 Wireless Gecko Reference Manual (MSC p146)
+ * https://www.silabs.com/documents/public/reference-manuals/efr32xg12-rm.pdf
+ *
+ * @author agent
+ * @license MIT
+ *
+ * Copyright agent, 2026
+ */
+
+#include "flash_log.h"
+
+#if FLASH_LOG
+
+#include <string.h>
+
+#include "em_device.h"
+#include "em_msc.h"
+
+#include "flash_msc.h"
+
+/**
+ * @brief   Unlock the flash controller for erase and program.
+ *
+ * @param   start, size Area that will be used, page aligned.
+ *
+ * @return  -1 if the area is not in flash or not page aligned
+ *           0 otherwise
+ */
+int8_t flash_msc_init (uint32_t start, uint32_t size)
+{
+    if ((FLASH_MSC_PAGE_SIZE != FLASH_PAGE_SIZE) || ((start % FLASH_PAGE_SIZE) != 0) ||
+        (start < FLASH_BASE) || (start + size > FLASH_BASE + FLASH_SIZE))
+    {
+        return -1;
+    }
+    MSC_Init();
+    return 0;
+}
+
+int8_t flash_msc_erase_page (uint32_t addr)
+{
+    return (MSC_ErasePage((uint32_t *)addr) == mscReturnOk) ? 0 : -1;
+}
+
+/**
+ * @brief   Program erased flash, addr and len are multiples of 4.
+ */
+int8_t flash_msc_write (uint32_t addr, const void * data, uint32_t len)
+{
+    return (MSC_WriteWord((uint32_t *)addr, data, len) == mscReturnOk) ? 0 : -1;
+}
+
+void flash_msc_read (uint32_t addr, void * data, uint32_t len)
+{
+    memcpy(data, (const void *)addr, len);
+}
+
+#endif // FLASH_LOG
@@ -0,0 +1,26 @@
+/**
+ * @file flash_msc.h
+ *
+ * @brief   Internal flash access for flash_log.c through em_msc, host/host_flash.c replaces it
+ *          with a file in the host simulation.
+ *
+ * @author agent
+ * @license MIT
+ *
+ * Copyright agent, 2026
+ */
+
+#ifndef FLASH_MSC_H_
+#define FLASH_MSC_H_
+
+#include <stdint.h>
+
+#define FLASH_MSC_PAGE_SIZE         2048    // EFR32MG12 flash page
+
+// Public functions
+int8_t flash_msc_init(uint32_t start, uint32_t size);
+int8_t flash_msc_erase_page(uint32_t addr);
+int8_t flash_msc_write(uint32_t addr, const void * data, uint32_t len);
+void flash_msc_read(uint32_t addr, void * data, uint32_t len);
+
+#endif // FLASH_MSC_H_
@@ -2,7 +2,7 @@
  * @file gpio_handler.c
  *
  * @brief Initialize GPIO and configure for I2C data transfer (SDA and SCL). 
- *        Configure GPIO pin for external interrupts.
+ *        Configure GPIO pin for external interrupts, the interrupt is served by gpio_exti.c.
  *
  * @author Johannes Ehala, ProLab.
  * @license MIT
@@ -12,7 +12,6 @@
 
 #include "em_cmu.h"
 #include "em_gpio.h"
-#include "cmsis_os2.h"
 
 #include "gpio_handler.h"
 
@@ -21,11 +20,6 @@
 #define __LOG_LEVEL__ (LOG_LEVEL_gpio & BASE_LOG_LEVEL)
 #include "log.h"
 
-volatile static osThreadId_t resumeThreadID;
-volatile static uint32_t resumeThreadFlagID;
-
-
-
 /**
  * @brief Initialize GPIO interface and configure for I2C communication. 
  *
@@ -45,68 +39,19 @@ void gpio_i2c_pin_init (void)
 /**
  * @brief Initialize GPIO interface and configure for external interrupts. 
  *
- * Accelerometer sensor interrupt 1 (INT1) is connected to port A pin 1 on TTTW lab-kit. 
+ * Accelerometer sensor interrupt 1 (INT1) is connected to port A pin 1 on TTTW lab-kit. The
+ * interrupt is left disabled, register a handler for GPIO_EXTI_NUM and enable it with gpio_exti.h.
  */
 void gpio_external_interrupt_init (void)
 {
-    // TODO Enable GPIO peripheral
+    // Enable GPIO peripheral
     CMU_ClockEnable(cmuClock_GPIO, true);
 
-    // TODO Configure pin
-    GPIO_PinModeSet(gpioPortA, 1, gpioModeInputPullFilter, 1);
+    // Configure pin
+    GPIO_PinModeSet(MMA8653FC_INT1_PORT, MMA8653FC_INT1_PIN, gpioModeInputPullFilter, 1);
     
-    // TODO Configure external interrupts
-    GPIO_ExtIntConfig(gpioPortA, 1, GPIO_EXTI_NUM, false, true, false); // Port, pin, EXTI number, rising edge, falling edge, enabled.
-      GPIO_InputSenseSet(GPIO_INSENSE_INT, GPIO_INSENSE_INT);
-      info1(" External interrupt init ");
-}
-
-void gpio_external_interrupt_disable ()
-{
-    GPIO_IntDisable(GPIO_IF_EXTI_NUM);
-    NVIC_DisableIRQ(GPIO_ODD_IRQn);
-}
-
-/**
- * @brief Enable external interrupts on GPIO pins.
- *
- * @param   tID, ID of the thread that handles the interrupt (deferred interrupt handling)
- * @param   tFlag, flag id for thread tID
- * 
- * @note    The EXTIx number (index) determines the external interrupt to use. GPIO ports and pins
- *          are wired to the interrupt controller (NVIC) based on the EXTI number (index). Only
- *          certain ports and pins are available for each external interrupt. Check EFR32MG12 manual
- *          p1114 and GPIO application note p11-12 for more information.
- *          EXTIx number also determines which IRQHandler function to use - GPIO_ODD_IRQHandler or
- *          GPIO_EVEN_IRQHandler.
- */
-void gpio_external_interrupt_enable (osThreadId_t tID, uint32_t tFlag)
-{
-    resumeThreadID = tID;
-    resumeThreadFlagID = tFlag;
-    
-    GPIO_IntClear(GPIO_IF_EXTI_NUM);
-    
-    NVIC_EnableIRQ(GPIO_ODD_IRQn);
-    NVIC_SetPriority(GPIO_ODD_IRQn, 3); 
-
-    GPIO_IntEnable(GPIO_IF_EXTI_NUM);
-}
-
-void GPIO_ODD_IRQHandler (void)
-{
-  
-    // TODO Get pending interrupts
-    uint32_t iflags;
-    iflags = GPIO_IntGetEnabled();
-    PLATFORM_LedsSet(PLATFORM_LedsGet()^2);
-    
-    if (iflags & GPIO_IF_EXTI_NUM)
-    {
-        // Clear interrupt flag.
-        GPIO_IntClear(GPIO_IF_EXTI_NUM);
-
-        osThreadFlagsSet(resumeThreadID, resumeThreadFlagID);
-    }
-    else ;
+    // Configure external interrupts
+    GPIO_ExtIntConfig(MMA8653FC_INT1_PORT, MMA8653FC_INT1_PIN, GPIO_EXTI_NUM, false, true, false); // Port, pin, EXTI number, rising edge, falling edge, enabled.
+    GPIO_InputSenseSet(GPIO_INSENSE_INT, GPIO_INSENSE_INT);
+    info1(" External interrupt init ");
 }
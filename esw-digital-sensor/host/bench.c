@@ -0,0 +1,534 @@
+/**
+ * @file bench.c
+ *
+ * @brief   Microbenchmarks of the sample conversion and analysis kernels, built for the
+ *          host from the same sources as the firmware.
+ *
+ * @details Every kernel runs over windows of several sizes, filled either with a synthetic
+ *          signal (gravity, sine vibration and noise from a fixed seed) or with samples
+ *          recorded from a sensor. The iteration count is calibrated so one measurement
+ *          takes at least BENCH_MIN_MS, the best of BENCH_REPEAT measurements is reported.
+ *          Instructions retired are counted with Linux perf events where available.
+ *
+ *          Results are written to stdout as JSON lines, one object per kernel, input and
+ *          window size, preceded by one object describing the build and the host:
+ *
+ *          {"type":"meta","cc":"...","cflags":"...","fft_length":32,"perf":true,...}
+ *          {"type":"result","kernel":"signal_stats_q","input":"synthetic","n":256,
+ *           "iterations":40000,"ns_per_sample":0.61,"samples_per_s":1.6e+09,
+ *           "instructions_per_sample":4.01}
+ *
+ *          instructions_per_sample is null if perf events can not be opened (e.g.
+ *          perf_event_paranoid or running in a container).
+ *
+ *          Usage: digi-sensor-bench [-n 32,256,2048] [-f recording.csv] [-t min_ms] [-r repeat]
+ *
+ *          A recording is a text file with one sample per line, x, y and z in counts
+ *          (-512 ... 511) separated by commas or spaces, lines starting with # are skipped.
+ *          The x, y and z streams are concatenated and windows are cut from that stream.
+ *
+ * @author agent
+ * @license MIT
+ *
+ * Copyright agent, 2026
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <math.h>
+#include <time.h>
+#include <unistd.h>
+
+#ifdef __linux__
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+#endif
+
+#include "mma8653fc_reg.h"
+#include "mma8653fc_driver.h"
+#include "signal_stats.h"
+#include "dsp_stats.h"
+#include "fft.h"
+
+#define BENCH_MIN_MS        50      // Shortest measurement
+#define BENCH_REPEAT        5       // Measurements per result, best is reported
+#define BENCH_MAX_SIZES     8
+#define BENCH_MAX_N         4096    // Largest window, must not exceed SIGNAL_STATS_MAX_N
+#define BENCH_SYNTH_SEED    1
+
+#ifndef BENCH_CC
+#define BENCH_CC            "unknown"
+#endif
+#ifndef BENCH_CFLAGS
+#define BENCH_CFLAGS        "unknown"
+#endif
+
+typedef struct
+{
+    const uint16_t * raw;   // Left-justified sensor output values
+    const int16_t * count;  // Same samples in counts
+    uint32_t n;
+} bench_input_t;
+
+typedef void (*bench_kernel_f)(const bench_input_t * in);
+
+typedef struct
+{
+    const char * name;
+    bench_kernel_f run;
+    uint32_t multiple;      // Window size must be a multiple of this
+} bench_kernel_t;
+
+// Kernel results go here so the compiler can not drop the work
+static volatile int64_t sink;
+static int16_t outBuf[BENCH_MAX_N];
+static float fftWork[FFT_LENGTH];
+
+static void k_convert_to_count (const bench_input_t * in)
+{
+    uint32_t i;
+    int32_t acc = 0;
+
+    for (i = 0; i < in->n; i++)
+    {
+        acc += convert_to_count(in->raw[i]);
+    }
+    sink = acc;
+}
+
+static void k_convert_to_g (const bench_input_t * in)
+{
+    uint32_t i;
+    float acc = 0;
+
+    for (i = 0; i < in->n; i++)
+    {
+        acc += convert_to_g(in->raw[i], MMA8653FC_XYZ_DATA_CFG_2G_RANGE);
+    }
+    sink = (int64_t)acc;
+}
+
+static void k_convert_block_to_count (const bench_input_t * in)
+{
+    convert_block_to_count(in->raw, outBuf, in->n);
+    sink = outBuf[in->n - 1];
+}
+
+static void k_convert_block_to_q15 (const bench_input_t * in)
+{
+    convert_block_to_q15(in->raw, outBuf, in->n);
+    sink = outBuf[in->n - 1];
+}
+
+static void k_convert_block_to_mg (const bench_input_t * in)
+{
+    convert_block_to_mg(in->raw, outBuf, in->n, MMA8653FC_XYZ_DATA_CFG_2G_RANGE);
+    sink = outBuf[in->n - 1];
+}
+
+// Replaces calc_signal_energy(), samples are added one at a time as in sample_window_put()
+static void k_signal_stats_q (const bench_input_t * in)
+{
+    signal_stats_q_t s;
+    uint32_t i;
+
+    signal_stats_q_reset(&s);
+    for (i = 0; i < in->n; i++)
+    {
+        signal_stats_q_add(&s, in->count[i]);
+    }
+    sink = signal_stats_q_energy(&s);
+}
+
+static void k_signal_stats_f (const bench_input_t * in)
+{
+    signal_stats_f_t s;
+    uint32_t i;
+
+    signal_stats_f_reset(&s);
+    for (i = 0; i < in->n; i++)
+    {
+        signal_stats_f_add(&s, in->count[i]);
+    }
+    sink = (int64_t)signal_stats_f_energy(&s);
+}
+
+static void k_dsp_stats_block (const bench_input_t * in)
+{
+    dsp_stats_t s;
+
+    dsp_stats_block(in->count, in->n, &s);
+    sink = s.max - s.min;
+}
+
+// One FFT per FFT_LENGTH samples
+static void k_fft_analyze (const bench_input_t * in)
+{
+    fft_result_t res;
+    uint32_t i;
+
+    for (i = 0; i < in->n; i += FFT_LENGTH)
+    {
+        fft_analyze(&in->count[i], FFT_LENGTH, fftWork, &res);
+    }
+    sink = res.dominantBin;
+}
+
+static const bench_kernel_t kernels[] =
+{
+    { "convert_to_count", k_convert_to_count, 1 },
+    { "convert_to_g", k_convert_to_g, 1 },
+    { "convert_block_to_count", k_convert_block_to_count, 1 },
+    { "convert_block_to_q15", k_convert_block_to_q15, 1 },
+    { "convert_block_to_mg", k_convert_block_to_mg, 1 },
+    { "signal_stats_q", k_signal_stats_q, 1 },
+    { "signal_stats_f", k_signal_stats_f, 1 },
+    { "dsp_stats_block", k_dsp_stats_block, 1 },
+    { "fft_analyze", k_fft_analyze, FFT_LENGTH },
+};
+
+static uint64_t now_ns (void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+// Instructions retired by this thread in user space, -1 if not available
+static int perfFd = -1;
+
+static void perf_open (void)
+{
+#ifdef __linux__
+    struct perf_event_attr attr;
+
+    memset(&attr, 0, sizeof(attr));
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.size = sizeof(attr);
+    attr.config = PERF_COUNT_HW_INSTRUCTIONS;
+    attr.disabled = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    perfFd = (int)syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+#endif
+}
+
+static void perf_start (void)
+{
+#ifdef __linux__
+    if (perfFd >= 0)
+    {
+        ioctl(perfFd, PERF_EVENT_IOC_RESET, 0);
+        ioctl(perfFd, PERF_EVENT_IOC_ENABLE, 0);
+    }
+#endif
+}
+
+static int64_t perf_stop (void)
+{
+    int64_t count = -1;
+
+#ifdef __linux__
+    if (perfFd >= 0)
+    {
+        ioctl(perfFd, PERF_EVENT_IOC_DISABLE, 0);
+        if (read(perfFd, &count, sizeof(count)) != sizeof(count))
+        {
+            count = -1;
+        }
+    }
+#endif
+    return count;
+}
+
+/*
+ * Windows are cut from a sample stream, consecutive iterations use consecutive windows
+ * (wrapping around) so a recording is not reduced to its first window.
+ */
+typedef struct
+{
+    const char * name;
+    uint16_t * raw;
+    int16_t * count;
+    uint32_t len;
+} bench_stream_t;
+
+static void stream_alloc (bench_stream_t * s, const char * name, uint32_t len)
+{
+    s->name = name;
+    s->len = len;
+    s->raw = malloc(len * sizeof(uint16_t));
+    s->count = malloc(len * sizeof(int16_t));
+    if ((s->raw == NULL) || (s->count == NULL))
+    {
+        fprintf(stderr, "out of memory\n");
+        exit(1);
+    }
+}
+
+static void stream_set (bench_stream_t * s, uint32_t i, int32_t count)
+{
+    if (count < -512)
+    {
+        count = -512;
+    }
+    else if (count > 511)
+    {
+        count = 511;
+    }
+    s->count[i] = (int16_t)count;
+    s->raw[i] = (uint16_t)(count * 64);
+}
+
+// 1 g on z, 250 mg 1 Hz vibration on x at 100 Hz, 10 mg noise, same stream every run
+static void stream_synthetic (bench_stream_t * s, uint32_t len)
+{
+    uint32_t seed = BENCH_SYNTH_SEED;
+    uint32_t i;
+
+    stream_alloc(s, "synthetic", len);
+    for (i = 0; i < len; i++)
+    {
+        double noise;
+        double mg;
+
+        seed = seed * 1664525u + 1013904223u;
+        noise = ((double)(seed >> 8) / (1 << 24) - 0.5) * 20.0;
+        switch (i % 3)
+        {
+            case 0:
+                mg = 250.0 * sin(2.0 * 3.14159265358979 * (i / 3) / 100.0);
+                break;
+            case 1:
+                mg = 0;
+                break;
+            default:
+                mg = 1000.0;
+                break;
+        }
+        stream_set(s, i, (int32_t)lround((mg + noise) * 256.0 / 1000.0));
+    }
+}
+
+static int stream_recorded (bench_stream_t * s, const char * path)
+{
+    FILE * f = fopen(path, "r");
+    char line[128];
+    int32_t * xyz = NULL;
+    uint32_t samples = 0;
+    uint32_t cap = 0;
+    uint32_t i;
+
+    if (f == NULL)
+    {
+        perror(path);
+        return -1;
+    }
+    while (fgets(line, sizeof(line), f) != NULL)
+    {
+        int x, y, z;
+
+        if ((line[0] == '#') || (sscanf(line, "%d%*[, ]%d%*[, ]%d", &x, &y, &z) != 3))
+        {
+            continue;
+        }
+        if (samples == cap)
+        {
+            cap = (cap == 0) ? 1024 : cap * 2;
+            xyz = realloc(xyz, cap * 3 * sizeof(int32_t));
+            if (xyz == NULL)
+            {
+                fprintf(stderr, "out of memory\n");
+                exit(1);
+            }
+        }
+        xyz[samples * 3] = x;
+        xyz[samples * 3 + 1] = y;
+        xyz[samples * 3 + 2] = z;
+        samples++;
+    }
+    fclose(f);
+    if (samples == 0)
+    {
+        fprintf(stderr, "%s: no samples\n", path);
+        free(xyz);
+        return -1;
+    }
+
+    // Axis streams one after the other, repeated to fill the largest window
+    stream_alloc(s, "recorded", (samples * 3 > BENCH_MAX_N) ? samples * 3 : BENCH_MAX_N);
+    for (i = 0; i < s->len; i++)
+    {
+        uint32_t j = i % (samples * 3);
+
+        stream_set(s, i, xyz[(j % samples) * 3 + j / samples]);
+    }
+    free(xyz);
+    return 0;
+}
+
+// Run iterations windows of n samples, return elapsed ns
+static uint64_t run_windows (const bench_kernel_t * k, const bench_stream_t * s, uint32_t n,
+                             uint64_t iterations, int64_t * instructions)
+{
+    uint32_t windows = (s->len >= n) ? s->len / n : 1;
+    bench_input_t in;
+    uint64_t start;
+    uint64_t i;
+
+    in.n = n;
+    perf_start();
+    start = now_ns();
+    for (i = 0; i < iterations; i++)
+    {
+        uint32_t offset = (uint32_t)(i % windows) * n;
+
+        in.raw = &s->raw[offset];
+        in.count = &s->count[offset];
+        k->run(&in);
+    }
+    start = now_ns() - start;
+    *instructions = perf_stop();
+    return start;
+}
+
+static void bench_kernel (const bench_kernel_t * k, const bench_stream_t * s, uint32_t n,
+                          uint32_t minMs, uint32_t repeat)
+{
+    uint64_t iterations = 1;
+    uint64_t best = UINT64_MAX;
+    int64_t bestInstr = -1;
+    int64_t instr;
+    uint64_t ns;
+    uint32_t r;
+
+    // Grow iteration count until one measurement takes minMs
+    for (;;)
+    {
+        ns = run_windows(k, s, n, iterations, &instr);
+        if (ns >= (uint64_t)minMs * 1000000ULL)
+        {
+            break;
+        }
+        iterations *= (ns < (uint64_t)minMs * 100000ULL) ? 10 : 2;
+    }
+
+    for (r = 0; r < repeat; r++)
+    {
+        ns = run_windows(k, s, n, iterations, &instr);
+        if (ns < best)
+        {
+            best = ns;
+            bestInstr = instr;
+        }
+    }
+
+    printf("{\"type\":\"result\",\"kernel\":\"%s\",\"input\":\"%s\",\"n\":%u,\"iterations\":%llu,"
+           "\"ns_per_sample\":%.4f,\"samples_per_s\":%.4g,\"instructions_per_sample\":",
+           k->name, s->name, n, (unsigned long long)iterations,
+           (double)best / ((double)iterations * n),
+           (double)iterations * n * 1e9 / (double)best);
+    if (bestInstr >= 0)
+    {
+        printf("%.3f}\n", (double)bestInstr / ((double)iterations * n));
+    }
+    else
+    {
+        printf("null}\n");
+    }
+    fflush(stdout);
+}
+
+static uint32_t parse_sizes (const char * arg, uint32_t sizes[BENCH_MAX_SIZES])
+{
+    uint32_t count = 0;
+    char * end;
+
+    while ((*arg != '\0') && (count < BENCH_MAX_SIZES))
+    {
+        unsigned long v = strtoul(arg, &end, 0);
+
+        if ((end == arg) || (v == 0) || (v > BENCH_MAX_N))
+        {
+            fprintf(stderr, "window size must be 1 ... %u\n", BENCH_MAX_N);
+            exit(2);
+        }
+        sizes[count++] = (uint32_t)v;
+        arg = (*end == ',') ? end + 1 : end;
+    }
+    return count;
+}
+
+int main (int argc, char * argv[])
+{
+    uint32_t sizes[BENCH_MAX_SIZES] = { 32, 256, 2048 };
+    uint32_t sizeCount = 3;
+    uint32_t minMs = BENCH_MIN_MS;
+    uint32_t repeat = BENCH_REPEAT;
+    const char * recording = NULL;
+    bench_stream_t streams[2];
+    uint32_t streamCount = 0;
+    uint32_t s, z, k;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "n:f:t:r:h")) != -1)
+    {
+        switch (opt)
+        {
+            case 'n':
+                sizeCount = parse_sizes(optarg, sizes);
+                break;
+            case 'f':
+                recording = optarg;
+                break;
+            case 't':
+                minMs = (uint32_t)strtoul(optarg, NULL, 0);
+                break;
+            case 'r':
+                repeat = (uint32_t)strtoul(optarg, NULL, 0);
+                break;
+            default:
+                fprintf(stderr, "usage: %s [-n 32,256,2048] [-f recording.csv] [-t min_ms] [-r repeat]\n", argv[0]);
+                return 2;
+        }
+    }
+    if (repeat == 0)
+    {
+        repeat = 1;
+    }
+
+    stream_synthetic(&streams[streamCount++], 3 * BENCH_MAX_N);
+    if (recording != NULL)
+    {
+        if (stream_recorded(&streams[streamCount], recording) != 0)
+        {
+            return 1;
+        }
+        streamCount++;
+    }
+
+    perf_open();
+    printf("{\"type\":\"meta\",\"cc\":\"%s\",\"cflags\":\"%s\",\"fft_length\":%u,\"min_ms\":%u,"
+           "\"repeat\":%u,\"perf\":%s}\n", BENCH_CC, BENCH_CFLAGS, FFT_LENGTH, minMs, repeat,
+           (perfFd >= 0) ? "true" : "false");
+
+    for (s = 0; s < streamCount; s++)
+    {
+        for (z = 0; z < sizeCount; z++)
+        {
+            for (k = 0; k < sizeof(kernels) / sizeof(kernels[0]); k++)
+            {
+                if ((sizes[z] % kernels[k].multiple) == 0)
+                {
+                    bench_kernel(&kernels[k], &streams[s], sizes[z], minMs, repeat);
+                }
+            }
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,320 @@
+/**
+ * @file blog_decode.c
+ *
+ * @brief   Formats the binary log records of a LOG_BINARY=1 build (blog.h) as text.
+ *
+ * @details Usage:
+ *          digi-sensor-blog image.elf [log.bin]
+ *
+ *          Format strings are taken from the blog_fmt section of the ELF file the log was
+ *          produced by (firmware .elf or the host simulation). The log is read from the file
+ *          or stdin, text output between the records is passed through. At the end the
+ *          number of records, their size and the size of the text they decode to are
+ *          printed to stderr.
+ *
+ * @author agent
+ * @license MIT
+ *
+ * Copyright agent, 2026
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <elf.h>
+
+#include "blog.h"
+
+#define BLOG_SECTION    "blog_fmt"
+
+static char * fmtData;
+static uint32_t fmtSize;
+
+static uint32_t records;
+static uint32_t recordBytes;
+static uint32_t textBytes;
+
+/**
+ * @brief   Load the blog_fmt section of a 32 or 64 bit little endian ELF file.
+ */
+static int load_formats (const char * path)
+{
+    FILE * f = fopen(path, "rb");
+    uint8_t * img;
+    long size;
+    uint64_t shoff, offset = 0, len = 0;
+    uint32_t shnum, shstrndx, shentsize, i;
+    bool is64;
+    const char * names;
+
+    if (f == NULL)
+    {
+        perror(path);
+        return -1;
+    }
+    fseek(f, 0, SEEK_END);
+    size = ftell(f);
+    rewind(f);
+    img = malloc(size);
+    if ((img == NULL) || (fread(img, 1, size, f) != (size_t)size))
+    {
+        perror(path);
+        fclose(f);
+        return -1;
+    }
+    fclose(f);
+
+    if ((size < (long)sizeof(Elf32_Ehdr)) || (memcmp(img, ELFMAG, SELFMAG) != 0) ||
+        (img[EI_DATA] != ELFDATA2LSB))
+    {
+        fprintf(stderr, "%s: not a little endian ELF file\n", path);
+        return -1;
+    }
+    is64 = (img[EI_CLASS] == ELFCLASS64);
+    if (is64)
+    {
+        Elf64_Ehdr * eh = (Elf64_Ehdr *)img;
+
+        shoff = eh->e_shoff;
+        shnum = eh->e_shnum;
+        shstrndx = eh->e_shstrndx;
+        shentsize = eh->e_shentsize;
+    }
+    else
+    {
+        Elf32_Ehdr * eh = (Elf32_Ehdr *)img;
+
+        shoff = eh->e_shoff;
+        shnum = eh->e_shnum;
+        shstrndx = eh->e_shstrndx;
+        shentsize = eh->e_shentsize;
+    }
+    if ((shoff + (uint64_t)shnum * shentsize > (uint64_t)size) || (shstrndx >= shnum))
+    {
+        fprintf(stderr, "%s: bad section table\n", path);
+        return -1;
+    }
+
+    names = (const char *)img + (is64 ? ((Elf64_Shdr *)(img + shoff + shstrndx * shentsize))->sh_offset
+                                      : ((Elf32_Shdr *)(img + shoff + shstrndx * shentsize))->sh_offset);
+    for (i = 0; i < shnum; i++)
+    {
+        uint8_t * sh = img + shoff + i * shentsize;
+        uint32_t name = is64 ? ((Elf64_Shdr *)sh)->sh_name : ((Elf32_Shdr *)sh)->sh_name;
+
+        if (strcmp(&names[name], BLOG_SECTION) == 0)
+        {
+            offset = is64 ? ((Elf64_Shdr *)sh)->sh_offset : ((Elf32_Shdr *)sh)->sh_offset;
+            len = is64 ? ((Elf64_Shdr *)sh)->sh_size : ((Elf32_Shdr *)sh)->sh_size;
+            break;
+        }
+    }
+    if ((i == shnum) || (offset + len > (uint64_t)size))
+    {
+        fprintf(stderr, "%s: no " BLOG_SECTION " section, not a LOG_BINARY=1 build?\n", path);
+        return -1;
+    }
+
+    // Keep a terminator after the last string
+    fmtData = calloc(1, len + 1);
+    memcpy(fmtData, img + offset, len);
+    fmtSize = (uint32_t)len;
+    free(img);
+    return 0;
+}
+
+static bool get_varint (const uint8_t * buf, uint32_t len, uint32_t * pos, uint32_t * v)
+{
+    uint32_t shift = 0;
+
+    *v = 0;
+    while (*pos < len)
+    {
+        uint8_t b = buf[(*pos)++];
+
+        *v |= (uint32_t)(b & 0x7F) << shift;
+        if ((b & 0x80) == 0)
+        {
+            return true;
+        }
+        shift += 7;
+        if (shift > 28)
+        {
+            break;
+        }
+    }
+    return false;
+}
+
+static char level_char (uint8_t bit)
+{
+    if (bit >= 12)
+    {
+        return 'E';
+    }
+    if (bit >= 8)
+    {
+        return 'W';
+    }
+    if (bit >= 4)
+    {
+        return 'I';
+    }
+    return 'D';
+}
+
+/**
+ * @brief   printf the integer conversions of fmt with args, anything else prints as <?>.
+ */
+static int format_args (char * out, size_t size, const char * fmt, const uint32_t * args, uint32_t nargs)
+{
+    size_t n = 0;
+    uint32_t a = 0;
+
+    while ((*fmt != '\0') && (n + 1 < size))
+    {
+        char spec[32];
+        size_t s = 0;
+        uint32_t longs = 0;
+
+        if (*fmt != '%')
+        {
+            out[n++] = *fmt++;
+            continue;
+        }
+        fmt++;
+        if (*fmt == '%')
+        {
+            out[n++] = *fmt++;
+            continue;
+        }
+
+        spec[s++] = '%';
+        while ((strchr("-+ #0123456789.", *fmt) != NULL) && (*fmt != '\0') && (s < sizeof(spec) - 2))
+        {
+            spec[s++] = *fmt++;
+        }
+        while ((*fmt == 'h') || (*fmt == 'l'))
+        {
+            longs += (*fmt++ == 'l');
+        }
+        spec[s++] = *fmt;
+        spec[s] = '\0';
+
+        if ((a >= nargs) || (*fmt == '\0') || (longs > 1))
+        {
+            n += snprintf(&out[n], size - n, "<?>");
+            a++;
+        }
+        else if (strchr("di", *fmt) != NULL)
+        {
+            n += snprintf(&out[n], size - n, spec, (int)args[a++]);
+        }
+        else if (strchr("uoxXc", *fmt) != NULL)
+        {
+            n += snprintf(&out[n], size - n, spec, (unsigned)args[a++]);
+        }
+        else
+        {
+            n += snprintf(&out[n], size - n, "<?>");
+            a++;
+        }
+        if (n >= size)
+        {
+            n = size - 1;
+        }
+        if (*fmt != '\0')
+        {
+            fmt++;
+        }
+    }
+    out[n] = '\0';
+    return (int)n;
+}
+
+static void decode_record (const uint8_t * rec, uint32_t len)
+{
+    uint32_t args[BLOG_MAX_ARGS];
+    uint32_t nargs = 0;
+    uint32_t pos = 1;
+    uint32_t id, ms, v;
+    char text[512];
+    int n;
+
+    if ((len < 1) || !get_varint(rec, len, &pos, &id) || !get_varint(rec, len, &pos, &ms) ||
+        (id >= fmtSize))
+    {
+        puts("<bad record>");
+        return;
+    }
+    while ((pos < len) && (nargs < BLOG_MAX_ARGS) && get_varint(rec, len, &pos, &v))
+    {
+        args[nargs++] = (v >> 1) ^ (uint32_t)-(int32_t)(v & 1);
+    }
+
+    n = printf("%02u:%02u:%02u.%03u %c|", (unsigned)(ms / 3600000), (unsigned)(ms / 60000 % 60),
+               (unsigned)(ms / 1000 % 60), (unsigned)(ms % 1000), level_char(rec[0]));
+    n += format_args(text, sizeof(text), &fmtData[id], args, nargs);
+    printf("%s\n", text);
+
+    records++;
+    recordBytes += len + 2;
+    textBytes += n + 1;
+}
+
+int main (int argc, char * argv[])
+{
+    FILE * in = stdin;
+    uint8_t rec[256];
+    int c;
+
+    if ((argc < 2) || (argc > 3))
+    {
+        fprintf(stderr, "usage: %s image.elf [log.bin]\n", argv[0]);
+        return 2;
+    }
+    if (load_formats(argv[1]) != 0)
+    {
+        return 1;
+    }
+    if (argc == 3)
+    {
+        in = fopen(argv[2], "rb");
+        if (in == NULL)
+        {
+            perror(argv[2]);
+            return 1;
+        }
+    }
+
+    while ((c = getc(in)) != EOF)
+    {
+        int len;
+
+        if (c != BLOG_SYNC)
+        {
+            putchar(c);
+            continue;
+        }
+        len = getc(in);
+        if ((len == EOF) || (fread(rec, 1, len, in) != (size_t)len))
+        {
+            break;
+        }
+        decode_record(rec, len);
+    }
+
+    fflush(stdout);
+    if (records > 0)
+    {
+        fprintf(stderr, "%u records, %u bytes, %u bytes as text (%.1fx)\n", records, recordBytes,
+                textBytes, (double)textBytes / recordBytes);
+    }
+    if (in != stdin)
+    {
+        fclose(in);
+    }
+    return 0;
+}
@@ -0,0 +1,247 @@
+/**
+ * @file flash_dump.c
+ *
+ * @brief   Decoder for the flash sample log of a FLASH_LOG=1 build (flash_log.h).
+ *
+ * @details Usage:
+ *          digi-sensor-flash [-o samples.csv] input
+ *
+ *          input is a capture of a flash log readout (other output in it is skipped) or a
+ *          flash image, e.g. the SIM_FLASH file of the host simulation. Pages are found by
+ *          magic and CRC and decoded in seq order, a page that is in the input more than
+ *          once is decoded once. With -o the samples are written as CSV, x,y,z counts per
+ *          line, which digi-sensor-trace can import; lost samples are marked with comment
+ *          lines, a new boot with a comment line. The page and sample counts, losses and the
+ *          bytes per sample are printed to stderr.
+ *
+ * @author agent
+ * @license MIT
+ *
+ * Copyright agent, 2026
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "checksum.h"
+#include "flash_log.h"
+
+#define CRC_START       offsetof(flash_log_page_hdr_t, len)
+
+static int page_cmp (const void * a, const void * b)
+{
+    const flash_log_page_hdr_t * pa = *(const flash_log_page_hdr_t * const *)a;
+    const flash_log_page_hdr_t * pb = *(const flash_log_page_hdr_t * const *)b;
+
+    return (pa->seq > pb->seq) - (pa->seq < pb->seq);
+}
+
+static uint8_t * read_all (FILE * in, size_t * n)
+{
+    size_t size = 65536;
+    uint8_t * buf = malloc(size);
+    size_t got;
+
+    *n = 0;
+    while ((buf != NULL) && ((got = fread(&buf[*n], 1, size - *n, in)) > 0))
+    {
+        *n += got;
+        if (*n == size)
+        {
+            size *= 2;
+            buf = realloc(buf, size);
+        }
+    }
+    return buf;
+}
+
+static bool get_varint (const uint8_t * p, uint32_t len, uint32_t * pos, int32_t * v)
+{
+    uint32_t u = 0;
+    uint8_t shift = 0;
+
+    while (*pos < len)
+    {
+        uint8_t b = p[(*pos)++];
+
+        u |= (uint32_t)(b & 0x7F) << shift;
+        if ((b & 0x80) == 0)
+        {
+            *v = (int32_t)(u >> 1) ^ -(int32_t)(u & 1);
+            return true;
+        }
+        shift += 7;
+        if (shift > 28)
+        {
+            break;
+        }
+    }
+    return false;
+}
+
+int main (int argc, char * argv[])
+{
+    FILE * in;
+    FILE * csv = NULL;
+    uint8_t * buf;
+    size_t n, pos;
+    flash_log_page_hdr_t ** pages;
+    uint32_t pageCount = 0;
+    uint32_t badPages = 0;
+    uint32_t samples = 0;
+    uint32_t samplesLost = 0;
+    uint32_t payloadBytes = 0;
+    uint32_t nextIndex = 0;
+    uint32_t odrMhz = 0;
+    uint8_t resolution = 0;
+    uint8_t boot = 0;
+    uint32_t boots = 0;
+    uint32_t i;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "o:")) != -1)
+    {
+        if (opt == 'o')
+        {
+            csv = fopen(optarg, "w");
+            if (csv == NULL)
+            {
+                perror(optarg);
+                return 1;
+            }
+        }
+        else
+        {
+            optind = argc;
+            break;
+        }
+    }
+    if (optind != argc - 1)
+    {
+        fprintf(stderr, "usage: %s [-o samples.csv] input\n", argv[0]);
+        return 2;
+    }
+    in = fopen(argv[optind], "rb");
+    if (in == NULL)
+    {
+        perror(argv[optind]);
+        return 1;
+    }
+    buf = read_all(in, &n);
+    fclose(in);
+    pages = malloc((n / sizeof(flash_log_page_hdr_t) + 1) * sizeof(*pages));
+    if ((buf == NULL) || (pages == NULL))
+    {
+        fprintf(stderr, "out of memory\n");
+        return 1;
+    }
+
+    // Pages are word aligned in flash, but not in a capture with other output
+    for (pos = 0; pos + sizeof(flash_log_page_hdr_t) <= n; pos++)
+    {
+        flash_log_page_hdr_t hdr;
+
+        memcpy(&hdr, &buf[pos], sizeof(hdr));
+        if ((hdr.magic != FLASH_LOG_MAGIC) || (hdr.len > FLASH_LOG_PAYLOAD_MAX) ||
+            (pos + sizeof(hdr) + hdr.len > n))
+        {
+            continue;
+        }
+        if (crc_ccitt_ffff(&buf[pos + CRC_START], sizeof(hdr) - CRC_START + hdr.len) != hdr.crc)
+        {
+            badPages++;
+            continue;
+        }
+        // Aligned copy, the payload follows the header
+        pages[pageCount] = malloc(sizeof(hdr) + hdr.len);
+        memcpy(pages[pageCount], &buf[pos], sizeof(hdr) + hdr.len);
+        pageCount++;
+        pos += sizeof(hdr) + hdr.len - 1;
+    }
+    qsort(pages, pageCount, sizeof(*pages), page_cmp);
+
+    for (i = 0; i < pageCount; i++)
+    {
+        const flash_log_page_hdr_t * hdr = pages[i];
+        const uint8_t * payload = (const uint8_t *)(hdr + 1);
+        int32_t prev[3] = { 0, 0, 0 };
+        uint32_t p = 0;
+        uint16_t s;
+
+        if ((i > 0) && (hdr->seq == pages[i - 1]->seq))
+        {
+            continue;
+        }
+        if ((boots == 0) || (hdr->boot != boot))
+        {
+            // Sample index and time start over
+            boots++;
+            boot = hdr->boot;
+            if (csv != NULL)
+            {
+                fprintf(csv, "# boot %u\n", boot);
+            }
+        }
+        else if (hdr->index != nextIndex)
+        {
+            samplesLost += hdr->index - nextIndex;
+            if (csv != NULL)
+            {
+                fprintf(csv, "# lost %u samples at %u\n", hdr->index - nextIndex, nextIndex);
+            }
+        }
+        if ((csv != NULL) && ((hdr->odrMhz != odrMhz) || (hdr->resolution != resolution)))
+        {
+            fprintf(csv, "# odr %u mHz, resolution %u\n", hdr->odrMhz, hdr->resolution);
+        }
+        odrMhz = hdr->odrMhz;
+        resolution = hdr->resolution;
+
+        for (s = 0; s < hdr->count; s++)
+        {
+            uint8_t a;
+
+            for (a = 0; a < 3; a++)
+            {
+                int32_t d;
+
+                if (!get_varint(payload, hdr->len, &p, &d))
+                {
+                    fprintf(stderr, "page %u: payload ends at sample %u of %u\n", hdr->seq, s, hdr->count);
+                    return 1;
+                }
+                prev[a] += d;
+            }
+            if (csv != NULL)
+            {
+                fprintf(csv, "%d,%d,%d\n", prev[0], prev[1], prev[2]);
+            }
+        }
+        samples += hdr->count;
+        payloadBytes += hdr->len;
+        nextIndex = hdr->index + hdr->count;
+    }
+
+    fprintf(stderr, "flash: %u pages, %u bad", pageCount, badPages);
+    if (pageCount > 0)
+    {
+        fprintf(stderr, ", seq %u ... %u, %u boots", pages[0]->seq, pages[pageCount - 1]->seq, boots);
+    }
+    fprintf(stderr, "\nflash: %u samples, %u lost", samples, samplesLost);
+    if (samples > 0)
+    {
+        fprintf(stderr, ", %.2f bytes/sample", (double)payloadBytes / samples);
+    }
+    fprintf(stderr, "\n");
+
+    if (csv != NULL)
+    {
+        fclose(csv);
+    }
+    return ((badPages > 0) || (samplesLost > 0)) ? 1 : 0;
+}
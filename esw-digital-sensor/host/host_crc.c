@@ -0,0 +1,31 @@
+/**
+ * @file host_crc.c
+ *
+ * @brief   CRC-CCITT of the host build, same results as libcrc crc_ccitt_ffff().
+ *
+ * @author agent
+ * @license MIT
+ *
+ * Copyright agent, 2026
+ */
+
+#include "checksum.h"
+
+#define CRC_POLY_CCITT  0x1021
+
+uint16_t crc_ccitt_ffff (const unsigned char * input_str, size_t num_bytes)
+{
+    uint16_t crc = 0xFFFF;
+    size_t i;
+    int b;
+
+    for (i = 0; i < num_bytes; i++)
+    {
+        crc ^= (uint16_t)input_str[i] << 8;
+        for (b = 0; b < 8; b++)
+        {
+            crc = (crc & 0x8000) ? (uint16_t)((crc << 1) ^ CRC_POLY_CCITT) : (uint16_t)(crc << 1);
+        }
+    }
+    return crc;
+}
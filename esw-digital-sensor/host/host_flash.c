@@ -0,0 +1,124 @@
+/**
+ * @file host_flash.c
+ *
+ * @brief   Flash of the host simulation, replaces flash_msc.c.
+ *
+ * @details The flash log area is kept in memory and, with SIM_FLASH set, in a file of the same
+ *          size, so the log survives between runs and the file can be decoded like a
+ *          readout. Erased flash reads 0xFF and programming can only clear bits. Erase and
+ *          program take the typical datasheet times in simulated time.
+ *
+ * @author agent
+ * @license MIT
+ *
+ * Copyright agent, 2026
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "host_sim.h"
+#include "flash_msc.h"
+
+#define HOST_FLASH_ERASE_NS     20000000ULL // Page erase
+#define HOST_FLASH_WORD_NS      20000ULL    // Word program
+
+static uint8_t * flash;
+static uint32_t flashStart;
+static uint32_t flashSize;
+static FILE * flashFile;
+
+static void file_update (uint32_t offset, uint32_t len)
+{
+    if (flashFile != NULL)
+    {
+        fseek(flashFile, offset, SEEK_SET);
+        fwrite(&flash[offset], len, 1, flashFile);
+        fflush(flashFile);
+    }
+}
+
+int8_t flash_msc_init (uint32_t start, uint32_t size)
+{
+    if ((start % FLASH_MSC_PAGE_SIZE) != 0)
+    {
+        return -1;
+    }
+    flashStart = start;
+    flashSize = size;
+    flash = malloc(size);
+    if (flash == NULL)
+    {
+        return -1;
+    }
+    memset(flash, 0xFF, size);
+
+    if (simConfig.flashFile != NULL)
+    {
+        flashFile = fopen(simConfig.flashFile, "r+b");
+        if (flashFile == NULL)
+        {
+            flashFile = fopen(simConfig.flashFile, "w+b");
+        }
+        if (flashFile == NULL)
+        {
+            perror(simConfig.flashFile);
+            exit(1);
+        }
+        // A new or shorter file is erased flash
+        if (fread(flash, 1, size, flashFile) < size)
+        {
+            file_update(0, size);
+        }
+    }
+    return 0;
+}
+
+static bool in_area (uint32_t addr, uint32_t len)
+{
+    return (addr >= flashStart) && (addr - flashStart + len <= flashSize);
+}
+
+int8_t flash_msc_erase_page (uint32_t addr)
+{
+    if (((addr % FLASH_MSC_PAGE_SIZE) != 0) || !in_area(addr, FLASH_MSC_PAGE_SIZE))
+    {
+        return -1;
+    }
+    sim_sleep_until_ns(sim_time_ns() + HOST_FLASH_ERASE_NS);
+    memset(&flash[addr - flashStart], 0xFF, FLASH_MSC_PAGE_SIZE);
+    file_update(addr - flashStart, FLASH_MSC_PAGE_SIZE);
+    simStats.flashErases++;
+    return 0;
+}
+
+int8_t flash_msc_write (uint32_t addr, const void * data, uint32_t len)
+{
+    const uint8_t * src = data;
+    uint32_t i;
+
+    if (((addr % 4) != 0) || ((len % 4) != 0) || !in_area(addr, len))
+    {
+        return -1;
+    }
+    sim_sleep_until_ns(sim_time_ns() + (len / 4) * HOST_FLASH_WORD_NS);
+    for (i = 0; i < len; i++)
+    {
+        flash[addr - flashStart + i] &= src[i];
+    }
+    file_update(addr - flashStart, len);
+    return 0;
+}
+
+void flash_msc_read (uint32_t addr, void * data, uint32_t len)
+{
+    if (in_area(addr, len))
+    {
+        memcpy(data, &flash[addr - flashStart], len);
+    }
+    else
+    {
+        memset(data, 0xFF, len);
+    }
+}
@@ -0,0 +1,196 @@
+/**
+ * @file host_gpio.c
+ *
+ * @brief   GPIO with external interrupts for the host simulation.
+ *
+ * @details Pins driven by simulated devices (sim_gpio_drive()) are edge detected with the
+ *          EXTI configuration from GPIO_ExtIntConfig(). Like on EFR32, odd EXTI numbers
+ *          raise GPIO_ODD_IRQn and even ones GPIO_EVEN_IRQn. Input pins that are not driven
+ *          read the configured pull direction.
+ *
+ * EFR32MG12 Wireless Gecko Reference Manual (GPIO p1105)
+ * https://www.silabs.com/documents/public/reference-manuals/efr32xg12-rm.pdf
+ *
+ * @author agent
+ * @license MIT
+ *
+ * Copyright agent, 2026
+ */
+
+#include <pthread.h>
+
+#include "em_gpio.h"
+#include "host_sim.h"
+
+#define HOST_GPIO_PORTS     6
+#define HOST_GPIO_PINS      16
+#define HOST_GPIO_EXTI      16
+
+typedef struct
+{
+    uint8_t port;
+    uint8_t pin;
+    bool rising;
+    bool falling;
+    bool configured;
+} host_exti_t;
+
+static pthread_mutex_t gpioLock = PTHREAD_MUTEX_INITIALIZER;
+static uint16_t pinLevel[HOST_GPIO_PORTS];      // Input level of every pin
+static uint16_t pinDriven[HOST_GPIO_PORTS];     // Pins driven by a simulated device
+static host_exti_t exti[HOST_GPIO_EXTI];
+static uint32_t gpioIf;
+static uint32_t gpioIen;
+
+// Set pending the GPIO interrupt of every enabled flag, gpioLock must be held.
+static void gpio_raise (uint32_t flags)
+{
+    flags &= gpioIen;
+    if (flags & 0xAAAAAAAAUL)
+    {
+        NVIC_SetPendingIRQ(GPIO_ODD_IRQn);
+    }
+    if (flags & 0x55555555UL)
+    {
+        NVIC_SetPendingIRQ(GPIO_EVEN_IRQn);
+    }
+}
+
+// New input level of a pin, gpioLock must be held.
+static void pin_set (unsigned int port, unsigned int pin, unsigned int level)
+{
+    unsigned int old = (pinLevel[port] >> pin) & 1;
+    uint32_t i;
+
+    if (level)
+    {
+        pinLevel[port] |= (1U << pin);
+    }
+    else
+    {
+        pinLevel[port] &= ~(1U << pin);
+    }
+
+    if (old == level)
+    {
+        return;
+    }
+    for (i = 0; i < HOST_GPIO_EXTI; i++)
+    {
+        if (exti[i].configured && (exti[i].port == port) && (exti[i].pin == pin) &&
+            ((level && exti[i].rising) || (!level && exti[i].falling)))
+        {
+            gpioIf |= (1UL << i);
+            gpio_raise(1UL << i);
+        }
+    }
+}
+
+/**
+ * @brief   Drive a pin from a simulated device.
+ */
+void sim_gpio_drive (GPIO_Port_TypeDef port, unsigned int pin, unsigned int level)
+{
+    pthread_mutex_lock(&gpioLock);
+    pinDriven[port] |= (1U << pin);
+    pin_set(port, pin, level ? 1 : 0);
+    pthread_mutex_unlock(&gpioLock);
+}
+
+void GPIO_PinModeSet (GPIO_Port_TypeDef port, unsigned int pin, GPIO_Mode_TypeDef mode, unsigned int out)
+{
+    pthread_mutex_lock(&gpioLock);
+    if (!(pinDriven[port] & (1U << pin)))
+    {
+        // Pull-up/down or output value (DOUT sets the pull direction of inputs)
+        pin_set(port, pin, (mode == gpioModeDisabled) ? 0 : (out ? 1 : 0));
+    }
+    pthread_mutex_unlock(&gpioLock);
+}
+
+unsigned int GPIO_PinInGet (GPIO_Port_TypeDef port, unsigned int pin)
+{
+    return (pinLevel[port] >> pin) & 1;
+}
+
+void GPIO_PinOutSet (GPIO_Port_TypeDef port, unsigned int pin)
+{
+    pthread_mutex_lock(&gpioLock);
+    pin_set(port, pin, 1);
+    pthread_mutex_unlock(&gpioLock);
+}
+
+void GPIO_PinOutClear (GPIO_Port_TypeDef port, unsigned int pin)
+{
+    pthread_mutex_lock(&gpioLock);
+    pin_set(port, pin, 0);
+    pthread_mutex_unlock(&gpioLock);
+}
+
+void GPIO_ExtIntConfig (GPIO_Port_TypeDef port, unsigned int pin, unsigned int intNo,
+                        bool risingEdge, bool fallingEdge, bool enable)
+{
+    if (intNo >= HOST_GPIO_EXTI)
+    {
+        return;
+    }
+    pthread_mutex_lock(&gpioLock);
+    exti[intNo].port = port;
+    exti[intNo].pin = pin;
+    exti[intNo].rising = risingEdge;
+    exti[intNo].falling = fallingEdge;
+    exti[intNo].configured = true;
+    gpioIf &= ~(1UL << intNo);
+    if (enable)
+    {
+        gpioIen |= (1UL << intNo);
+    }
+    else
+    {
+        gpioIen &= ~(1UL << intNo);
+    }
+    pthread_mutex_unlock(&gpioLock);
+}
+
+void GPIO_InputSenseSet (uint32_t val, uint32_t mask)
+{
+    (void)val;
+    (void)mask;
+}
+
+void GPIO_IntClear (uint32_t flags)
+{
+    pthread_mutex_lock(&gpioLock);
+    gpioIf &= ~flags;
+    pthread_mutex_unlock(&gpioLock);
+}
+
+void GPIO_IntEnable (uint32_t flags)
+{
+    pthread_mutex_lock(&gpioLock);
+    gpioIen |= flags;
+    gpio_raise(gpioIf & flags);
+    pthread_mutex_unlock(&gpioLock);
+}
+
+void GPIO_IntDisable (uint32_t flags)
+{
+    pthread_mutex_lock(&gpioLock);
+    gpioIen &= ~flags;
+    pthread_mutex_unlock(&gpioLock);
+}
+
+uint32_t GPIO_IntGet (void)
+{
+    return gpioIf;
+}
+
+uint32_t GPIO_IntGetEnabled (void)
+{
+    uint32_t ret;
+
+    pthread_mutex_lock(&gpioLock);
+    ret = gpioIf & gpioIen;
+    pthread_mutex_unlock(&gpioLock);
+    return ret;
+}
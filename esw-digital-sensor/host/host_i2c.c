@@ -0,0 +1,246 @@
+/**
+ * @file host_i2c.c
+ *
+ * @brief   I2C0 master of the host simulation with the emlib transfer API.
+ *
+ * @details I2C_TransferInit() hands the transfer to a bus thread and returns
+ *          i2cTransferInProgress. The bus thread waits for the time the transfer takes on
+ *          the wire (9 clocks per byte plus START/STOP at the I2C_Init() frequency), carries
+ *          it out against the sensor model and raises I2C0_IRQn. I2C_Transfer() called from
+ *          the interrupt handler then returns the result, like emlib after the last step.
+ *
+ *          Only the interrupt driven emlib transfers are modelled, not register level
+ *          sequencing (acq_ldma.c can not run in the simulation).
+ *
+ * @author agent
+ * @license MIT
+ *
+ * Copyright agent, 2026
+ */
+
+#include <pthread.h>
+
+#include "em_i2c.h"
+#include "host_sim.h"
+#include "mma8653fc_sim.h"
+
+I2C_TypeDef host_i2c0;
+
+static pthread_mutex_t busLock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t busCond = PTHREAD_COND_INITIALIZER;
+static pthread_t busThread;
+static I2C_TransferSeq_TypeDef * volatile busSeq;  // Transfer waiting for the bus thread
+static volatile I2C_TransferReturn_TypeDef busResult = i2cTransferDone;
+static volatile bool busActive;
+static volatile bool busCompleting;
+static uint32_t busFreq = I2C_FREQ_STANDARD_MAX;
+static bool busEnabled;
+
+static uint32_t seq_bytes (const I2C_TransferSeq_TypeDef * seq)
+{
+    switch (seq->flags)
+    {
+        case I2C_FLAG_WRITE:
+        case I2C_FLAG_READ:
+            return 1 + seq->buf[0].len;
+        case I2C_FLAG_WRITE_READ:
+            return 2 + seq->buf[0].len + seq->buf[1].len;
+        case I2C_FLAG_WRITE_WRITE:
+            return 1 + seq->buf[0].len + seq->buf[1].len;
+        default:
+            return 0;
+    }
+}
+
+// Carry out a transfer against the sensor model.
+static I2C_TransferReturn_TypeDef bus_execute (I2C_TransferSeq_TypeDef * seq)
+{
+    uint8_t addrW = (uint8_t)(seq->addr & 0xFE);
+    I2C_TransferReturn_TypeDef ret = i2cTransferDone;
+    uint32_t i;
+
+    mma_sim_i2c_lock();
+    if (!mma_sim_i2c_address(addrW))
+    {
+        ret = i2cTransferNack;
+    }
+    else
+    {
+        mma_sim_i2c_start();
+        switch (seq->flags)
+        {
+            case I2C_FLAG_WRITE:
+                for (i = 0; i < seq->buf[0].len; i++)
+                {
+                    mma_sim_i2c_write(seq->buf[0].data[i]);
+                }
+                break;
+
+            case I2C_FLAG_WRITE_WRITE:
+                for (i = 0; i < seq->buf[0].len; i++)
+                {
+                    mma_sim_i2c_write(seq->buf[0].data[i]);
+                }
+                for (i = 0; i < seq->buf[1].len; i++)
+                {
+                    mma_sim_i2c_write(seq->buf[1].data[i]);
+                }
+                break;
+
+            case I2C_FLAG_WRITE_READ:
+                for (i = 0; i < seq->buf[0].len; i++)
+                {
+                    mma_sim_i2c_write(seq->buf[0].data[i]);
+                }
+                mma_sim_i2c_start();
+                for (i = 0; i < seq->buf[1].len; i++)
+                {
+                    seq->buf[1].data[i] = mma_sim_i2c_read();
+                }
+                break;
+
+            case I2C_FLAG_READ:
+                for (i = 0; i < seq->buf[0].len; i++)
+                {
+                    seq->buf[0].data[i] = mma_sim_i2c_read();
+                }
+                break;
+
+            default:
+                ret = i2cTransferUsageFault;
+                break;
+        }
+        mma_sim_i2c_stop();
+    }
+    mma_sim_i2c_unlock();
+    return ret;
+}
+
+static void * bus_thread (void * arg)
+{
+    (void)arg;
+
+    for (;;)
+    {
+        I2C_TransferSeq_TypeDef * seq;
+        uint64_t wireNs;
+
+        pthread_mutex_lock(&busLock);
+        while (busSeq == NULL)
+        {
+            pthread_cond_wait(&busCond, &busLock);
+        }
+        seq = busSeq;
+        pthread_mutex_unlock(&busLock);
+
+        // START + bytes with ACK + STOP
+        wireNs = (uint64_t)(seq_bytes(seq) * 9 + 2) * 1000000000ULL / busFreq;
+        sim_sleep_until_ns(sim_time_ns() + wireNs);
+
+        busResult = bus_execute(seq);
+        simStats.i2cTransfers++;
+        simStats.i2cBytes += seq_bytes(seq);
+        if (busResult == i2cTransferNack)
+        {
+            simStats.i2cNacks++;
+        }
+
+        // The bus is free for the next transfer started from the interrupt handler, but
+        // does not count as idle before the completion interrupt is pending.
+        pthread_mutex_lock(&busLock);
+        busSeq = NULL;
+        busCompleting = true;
+        busActive = false;
+        pthread_mutex_unlock(&busLock);
+
+        NVIC_SetPendingIRQ(I2C0_IRQn);
+        busCompleting = false;
+    }
+    return NULL;
+}
+
+/**
+ * @return  true if no transfer is in progress
+ */
+bool host_i2c_idle (void)
+{
+    return !busActive && !busCompleting;
+}
+
+void host_i2c_start (void)
+{
+    pthread_create(&busThread, NULL, bus_thread, NULL);
+}
+
+void I2C_Init (I2C_TypeDef * i2c, const I2C_Init_TypeDef * init)
+{
+    (void)i2c;
+    busFreq = (init->freq != 0) ? init->freq : I2C_FREQ_STANDARD_MAX;
+    busEnabled = init->enable;
+}
+
+void I2C_Enable (I2C_TypeDef * i2c, bool enable)
+{
+    (void)i2c;
+    busEnabled = enable;
+}
+
+void I2C_Reset (I2C_TypeDef * i2c)
+{
+    (void)i2c;
+    busEnabled = false;
+}
+
+I2C_TransferReturn_TypeDef I2C_TransferInit (I2C_TypeDef * i2c, I2C_TransferSeq_TypeDef * seq)
+{
+    (void)i2c;
+    if ((seq == NULL) || (seq_bytes(seq) == 0))
+    {
+        return i2cTransferUsageFault;
+    }
+    if (!busEnabled)
+    {
+        return i2cTransferBusErr;
+    }
+
+    pthread_mutex_lock(&busLock);
+    if (busActive)
+    {
+        pthread_mutex_unlock(&busLock);
+        return i2cTransferSwFault;
+    }
+    busActive = true;
+    busResult = i2cTransferInProgress;
+    busSeq = seq;
+    pthread_cond_signal(&busCond);
+    pthread_mutex_unlock(&busLock);
+    return i2cTransferInProgress;
+}
+
+I2C_TransferReturn_TypeDef I2C_Transfer (I2C_TypeDef * i2c)
+{
+    (void)i2c;
+    return busResult;
+}
+
+void I2C_IntClear (I2C_TypeDef * i2c, uint32_t flags)
+{
+    (void)i2c;
+    (void)flags;
+}
+
+void I2C_IntEnable (I2C_TypeDef * i2c, uint32_t flags)
+{
+    i2c->IEN |= flags;
+}
+
+void I2C_IntDisable (I2C_TypeDef * i2c, uint32_t flags)
+{
+    i2c->IEN &= ~flags;
+}
+
+uint32_t I2C_IntGetEnabled (I2C_TypeDef * i2c)
+{
+    (void)i2c;
+    return 0;
+}
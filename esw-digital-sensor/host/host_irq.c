@@ -0,0 +1,186 @@
+/**
+ * @file host_irq.c
+ *
+ * @brief   Interrupt controller of the host simulation.
+ *
+ * @details Simulated peripherals set interrupts pending, a dedicated host thread runs the
+ *          handlers of pending and enabled interrupts one at a time, lowest number first.
+ *          Handlers run with the interrupt lock held. Critical sections (em_core.h) take the
+ *          same lock, so a handler can not run in the middle of a critical section, and
+ *          handlers do not preempt each other. Interrupt priorities are not modelled.
+ *
+ * @author agent
+ * @license MIT
+ *
+ * Copyright agent, 2026
+ */
+
+#include <pthread.h>
+
+#include "em_core.h"
+#include "host_sim.h"
+
+void I2C0_IRQHandler(void) __attribute__((weak));
+void GPIO_ODD_IRQHandler(void) __attribute__((weak));
+void GPIO_EVEN_IRQHandler(void) __attribute__((weak));
+void LDMA_IRQHandler(void) __attribute__((weak));
+void RTCC_IRQHandler(void) __attribute__((weak));
+void USART0_RX_IRQHandler(void) __attribute__((weak));
+void USART0_TX_IRQHandler(void) __attribute__((weak));
+
+CoreDebug_Type host_core_debug;
+static DWT_Type hostDwt;
+
+static pthread_mutex_t irqLock;
+static pthread_mutex_t pendLock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t pendCond = PTHREAD_COND_INITIALIZER;
+static uint32_t pending;
+static uint32_t enabled;
+static pthread_t irqThread;
+static volatile bool irqThreadStarted;
+static bool inHandler;
+
+static void (*handler_for(uint32_t irq))(void)
+{
+    switch (irq)
+    {
+        case I2C0_IRQn:         return I2C0_IRQHandler;
+        case GPIO_ODD_IRQn:     return GPIO_ODD_IRQHandler;
+        case GPIO_EVEN_IRQn:    return GPIO_EVEN_IRQHandler;
+        case LDMA_IRQn:         return LDMA_IRQHandler;
+        case RTCC_IRQn:         return RTCC_IRQHandler;
+        case USART0_RX_IRQn:    return USART0_RX_IRQHandler;
+        case USART0_TX_IRQn:    return USART0_TX_IRQHandler;
+        default:                return NULL;
+    }
+}
+
+static void * irq_thread (void * arg)
+{
+    (void)arg;
+
+    for (;;)
+    {
+        uint32_t irq;
+        void (*handler)(void);
+
+        pthread_mutex_lock(&pendLock);
+        while ((pending & enabled) == 0)
+        {
+            pthread_cond_wait(&pendCond, &pendLock);
+        }
+        irq = (uint32_t)__builtin_ctz(pending & enabled);
+        pending &= ~(1UL << irq);
+        inHandler = true;
+        pthread_mutex_unlock(&pendLock);
+
+        handler = handler_for(irq);
+        if (handler != NULL)
+        {
+            host_irq_lock();
+            simStats.interrupts++;
+            handler();
+            host_irq_unlock();
+        }
+
+        pthread_mutex_lock(&pendLock);
+        inHandler = false;
+        pthread_mutex_unlock(&pendLock);
+    }
+    return NULL;
+}
+
+void host_irq_start (void)
+{
+    pthread_mutexattr_t attr;
+
+    pthread_mutexattr_init(&attr);
+    pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_RECURSIVE);
+    pthread_mutex_init(&irqLock, &attr);
+    pthread_mutexattr_destroy(&attr);
+
+    pthread_create(&irqThread, NULL, irq_thread, NULL);
+    irqThreadStarted = true;
+}
+
+void host_irq_lock (void)
+{
+    pthread_mutex_lock(&irqLock);
+}
+
+void host_irq_unlock (void)
+{
+    pthread_mutex_unlock(&irqLock);
+}
+
+/**
+ * @return  true if no interrupt is pending or being handled
+ */
+bool host_irq_idle (void)
+{
+    bool idle;
+
+    pthread_mutex_lock(&pendLock);
+    idle = !inHandler && ((pending & enabled) == 0);
+    pthread_mutex_unlock(&pendLock);
+    return idle;
+}
+
+/**
+ * @return  true if called from an interrupt handler
+ */
+bool host_irq_context (void)
+{
+    return irqThreadStarted && pthread_equal(pthread_self(), irqThread);
+}
+
+static void irq_update (uint32_t setPending, uint32_t clearPending, uint32_t setEnabled, uint32_t clearEnabled)
+{
+    pthread_mutex_lock(&pendLock);
+    pending = (pending | setPending) & ~clearPending;
+    enabled = (enabled | setEnabled) & ~clearEnabled;
+    if (pending & enabled)
+    {
+        pthread_cond_signal(&pendCond);
+    }
+    pthread_mutex_unlock(&pendLock);
+}
+
+void NVIC_EnableIRQ (IRQn_Type irq)
+{
+    irq_update(0, 0, 1UL << irq, 0);
+}
+
+void NVIC_DisableIRQ (IRQn_Type irq)
+{
+    irq_update(0, 0, 0, 1UL << irq);
+}
+
+void NVIC_SetPendingIRQ (IRQn_Type irq)
+{
+    irq_update(1UL << irq, 0, 0, 0);
+}
+
+void NVIC_ClearPendingIRQ (IRQn_Type irq)
+{
+    irq_update(0, 1UL << irq, 0, 0);
+}
+
+void NVIC_SetPriority (IRQn_Type irq, uint32_t priority)
+{
+    (void)irq;
+    (void)priority;
+}
+
+/**
+ * @brief   Cycle counter, host time converted to cycles of the 38.4 MHz core clock. Only
+ *          comparable between host runs, not with the target.
+ */
+DWT_Type * host_dwt (void)
+{
+    if (hostDwt.CTRL & DWT_CTRL_CYCCNTENA_Msk)
+    {
+        hostDwt.CYCCNT = (uint32_t)(sim_host_ns() * (SystemCoreClock / 100000) / 10000);
+    }
+    return &hostDwt;
+}
@@ -0,0 +1,99 @@
+/**
+ * @file host_log.c
+ *
+ * @brief   Logging of the host simulation. Messages get the lll layout (simulated time,
+ *          level, module) and go to the output set with log_init().
+ *
+ * @author agent
+ * @license MIT
+ *
+ * Copyright agent, 2026
+ */
+
+#include <stdio.h>
+#include <stdarg.h>
+#include <pthread.h>
+
+#include "loggers_ext.h"
+#include "logger_fwrite.h"
+#include "host_sim.h"
+
+#define __LOG_LEVEL__ 0
+#include "log.h"
+
+#define HOST_LOG_LINE_LEN   256
+
+static pthread_mutex_t fwriteLock = PTHREAD_MUTEX_INITIALIZER;
+static log_output_f logOutput;
+static log_timestamp_f logTimestamp;
+static uint16_t logLevel;
+
+void log_init (uint16_t level, log_output_f output, log_timestamp_f timestamp)
+{
+    logLevel = level;
+    logOutput = output;
+    logTimestamp = timestamp;
+}
+
+static char level_char (uint16_t level)
+{
+    if (level >= LOG_ERR4)
+    {
+        return 'E';
+    }
+    if (level >= LOG_WARN4)
+    {
+        return 'W';
+    }
+    if (level >= LOG_INFO4)
+    {
+        return 'I';
+    }
+    return 'D';
+}
+
+void host_log (uint16_t level, const char * module, const char * fmt, ...)
+{
+    char line[HOST_LOG_LINE_LEN];
+    uint32_t ms;
+    va_list args;
+    int stamp;
+    int len;
+
+    if ((logOutput == NULL) || ((logLevel & level) == 0))
+    {
+        return;
+    }
+
+    ms = (logTimestamp != NULL) ? logTimestamp() : (uint32_t)(sim_time_ns() / 1000000);
+    stamp = snprintf(line, sizeof(line), "%02u:%02u:%02u.%03u ",
+                     (unsigned)(ms / 3600000), (unsigned)(ms / 60000 % 60),
+                     (unsigned)(ms / 1000 % 60), (unsigned)(ms % 1000));
+    len = stamp + snprintf(&line[stamp], sizeof(line) - stamp, "%c|%s: ", level_char(level), module);
+    va_start(args, fmt);
+    len += vsnprintf(&line[len], sizeof(line) - len - 1, fmt, args);
+    va_end(args);
+    if (len > (int)sizeof(line) - 2)
+    {
+        len = sizeof(line) - 2;
+    }
+    line[len++] = '\n';
+    line[len] = '\0';
+    logOutput(line, len);
+
+    // Replay compares what the firmware reports, without the time
+    sim_replay_result(&line[stamp]);
+}
+
+void logger_fwrite_init (void)
+{
+}
+
+int logger_fwrite (const char * ptr, int len)
+{
+    pthread_mutex_lock(&fwriteLock);
+    fwrite(ptr, len, 1, stdout);
+    fflush(stdout);
+    pthread_mutex_unlock(&fwriteLock);
+    return len;
+}
@@ -0,0 +1,556 @@
+/**
+ * @file host_os.c
+ *
+ * @brief   CMSIS-RTOS2 on POSIX threads for the host simulation.
+ *
+ * @details Threads created before osKernelStart() are started by it. Thread flags,
+ *          mutexes and semaphores are built on one mutex and condition variable each,
+ *          message queues on two semaphores (free slots and messages), timeouts are in ticks
+ *          of simulated time (1000 Hz). Functions that are valid in interrupt context on the
+ *          target (osThreadFlagsSet, osSemaphoreRelease, osMessageQueuePut with no timeout)
+ *          can be called from the simulated interrupt handlers. Message priorities are
+ *          ignored.
+ *
+ *          Control block and stack memory in the attributes is not used, objects created
+ *          without it are counted (simStats.rtosHeapObjects). Threads run on a painted host
+ *          stack, osThreadGetStackSpace() is the stack_size of the attributes less the most
+ *          the thread has used of it divided by HOST_OS_STACK_SCALE: x86-64 code with the
+ *          host C library needs several times the stack of the target build. The figures
+ *          show the relative depth of the threads, the target stacks are sized on the target.
+ *
+ * @author agent
+ * @license MIT
+ *
+ * Copyright agent, 2026
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <sched.h>
+#include <pthread.h>
+
+#include "cmsis_os2.h"
+#include "em_core.h"
+#include "host_sim.h"
+
+#define HOST_OS_TICK_FREQ   1000
+#define HOST_OS_STACK_SIZE  (256 * 1024)
+#define HOST_OS_STACK_FILL  0xA5
+#define HOST_OS_STACK_SCALE 4       // Host stack use per byte on the target, roughly
+
+typedef struct host_thread
+{
+    pthread_t thread;
+    osThreadFunc_t func;
+    void * argument;
+    const char * name;
+    osPriority_t priority;
+    uint32_t stackSize;     // Of the attributes
+    uint8_t * stack;        // Host stack, painted
+    uintptr_t stackTop;     // Stack pointer when the thread function was entered
+    pthread_mutex_t lock;
+    pthread_cond_t cond;
+    uint32_t flags;
+    bool started;
+    struct host_thread * next;
+} host_thread_t;
+
+typedef struct
+{
+    pthread_mutex_t lock;
+    pthread_cond_t cond;
+    uint32_t count;
+    uint32_t max;
+    host_thread_t * owner;  // Mutexes only
+    bool isMutex;
+} host_sync_t;
+
+typedef struct
+{
+    host_sync_t * slots;
+    host_sync_t * msgs;
+    pthread_mutex_t lock;
+    uint8_t * buf;
+    uint32_t msgSize;
+    uint32_t msgCount;
+    uint32_t head;
+    uint32_t tail;
+} host_queue_t;
+
+static osKernelState_t kernelState = osKernelInactive;
+static host_thread_t * threads;
+static pthread_mutex_t threadsLock = PTHREAD_MUTEX_INITIALIZER;
+static __thread host_thread_t * currentThread;
+
+static uint64_t ticks_to_deadline (uint32_t ticks)
+{
+    return sim_time_ns() + (uint64_t)ticks * (1000000000ULL / HOST_OS_TICK_FREQ);
+}
+
+/**
+ * @brief   Wait on cond until signalled or the simulated deadline passes.
+ *
+ * @return  false on timeout
+ */
+static bool cond_wait_until (pthread_cond_t * cond, pthread_mutex_t * lock, uint32_t timeout, uint64_t deadline)
+{
+    struct timespec ts;
+
+    if (timeout == osWaitForever)
+    {
+        pthread_cond_wait(cond, lock);
+        return true;
+    }
+    ts = sim_host_deadline(deadline);
+    return pthread_cond_timedwait(cond, lock, &ts) == 0;
+}
+
+osStatus_t osKernelInitialize (void)
+{
+    if (kernelState != osKernelInactive)
+    {
+        return osError;
+    }
+    kernelState = osKernelReady;
+    return osOK;
+}
+
+static void * thread_entry (void * arg)
+{
+    host_thread_t * t = arg;
+
+    currentThread = t;
+    t->stackTop = (uintptr_t)__builtin_frame_address(0);
+    t->func(t->argument);
+    return NULL;
+}
+
+static void thread_start (host_thread_t * t)
+{
+    pthread_attr_t attr;
+
+    pthread_attr_init(&attr);
+    pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_DETACHED);
+    if (posix_memalign((void **)&t->stack, 4096, HOST_OS_STACK_SIZE) == 0)
+    {
+        memset(t->stack, HOST_OS_STACK_FILL, HOST_OS_STACK_SIZE);
+        pthread_attr_setstack(&attr, t->stack, HOST_OS_STACK_SIZE);
+    }
+    t->started = true;
+    pthread_create(&t->thread, &attr, thread_entry, t);
+    pthread_attr_destroy(&attr);
+}
+
+osStatus_t osKernelStart (void)
+{
+    host_thread_t * t;
+
+    if (kernelState != osKernelReady)
+    {
+        return osError;
+    }
+    kernelState = osKernelRunning;
+
+    pthread_mutex_lock(&threadsLock);
+    for (t = threads; t != NULL; t = t->next)
+    {
+        if (!t->started)
+        {
+            thread_start(t);
+        }
+    }
+    pthread_mutex_unlock(&threadsLock);
+
+    // Like the target, does not return.
+    sim_run();
+    return osError;
+}
+
+osKernelState_t osKernelGetState (void)
+{
+    return kernelState;
+}
+
+uint32_t osKernelGetTickCount (void)
+{
+    return (uint32_t)(sim_time_ns() / (1000000000ULL / HOST_OS_TICK_FREQ));
+}
+
+uint32_t osKernelGetTickFreq (void)
+{
+    return HOST_OS_TICK_FREQ;
+}
+
+osThreadId_t osThreadNew (osThreadFunc_t func, void * argument, const osThreadAttr_t * attr)
+{
+    host_thread_t * t;
+
+    if (func == NULL)
+    {
+        return NULL;
+    }
+    t = calloc(1, sizeof(*t));
+    if (t == NULL)
+    {
+        return NULL;
+    }
+    t->func = func;
+    t->argument = argument;
+    t->name = (attr != NULL) ? attr->name : NULL;
+    t->priority = ((attr != NULL) && (attr->priority != osPriorityNone)) ? attr->priority : osPriorityNormal;
+    t->stackSize = (attr != NULL) ? attr->stack_size : 0;
+    if ((attr == NULL) || (attr->cb_mem == NULL) || (attr->stack_mem == NULL))
+    {
+        simStats.rtosHeapObjects++;
+    }
+    pthread_mutex_init(&t->lock, NULL);
+    sim_cond_init(&t->cond);
+
+    pthread_mutex_lock(&threadsLock);
+    t->next = threads;
+    threads = t;
+    if (kernelState == osKernelRunning)
+    {
+        thread_start(t);
+    }
+    pthread_mutex_unlock(&threadsLock);
+    return t;
+}
+
+osThreadId_t osThreadGetId (void)
+{
+    return currentThread;
+}
+
+const char * osThreadGetName (osThreadId_t thread_id)
+{
+    return (thread_id != NULL) ? ((host_thread_t *)thread_id)->name : NULL;
+}
+
+uint32_t osThreadGetStackSpace (osThreadId_t thread_id)
+{
+    host_thread_t * t = thread_id;
+    uint32_t low = 0;
+    uint32_t used;
+
+    if ((t == NULL) || (t->stack == NULL) || (t->stackTop == 0))
+    {
+        return 0;
+    }
+    // Lowest byte written, the stack grows down
+    while ((low < HOST_OS_STACK_SIZE) && (t->stack[low] == HOST_OS_STACK_FILL))
+    {
+        low++;
+    }
+    used = (uint32_t)(t->stackTop - (uintptr_t)&t->stack[low]);
+    used /= HOST_OS_STACK_SCALE;
+    return (t->stackSize > used) ? t->stackSize - used : 0;
+}
+
+osStatus_t osThreadYield (void)
+{
+    sched_yield();
+    return osOK;
+}
+
+uint32_t osThreadFlagsSet (osThreadId_t thread_id, uint32_t flags)
+{
+    host_thread_t * t = thread_id;
+    uint32_t ret;
+
+    if ((t == NULL) || (flags & osFlagsError))
+    {
+        return osFlagsErrorParameter;
+    }
+    pthread_mutex_lock(&t->lock);
+    t->flags |= flags;
+    ret = t->flags;
+    pthread_cond_broadcast(&t->cond);
+    pthread_mutex_unlock(&t->lock);
+    return ret;
+}
+
+uint32_t osThreadFlagsClear (uint32_t flags)
+{
+    host_thread_t * t = currentThread;
+    uint32_t ret;
+
+    if (t == NULL)
+    {
+        return osFlagsErrorISR;
+    }
+    pthread_mutex_lock(&t->lock);
+    ret = t->flags;
+    t->flags &= ~flags;
+    pthread_mutex_unlock(&t->lock);
+    return ret;
+}
+
+uint32_t osThreadFlagsGet (void)
+{
+    return (currentThread != NULL) ? currentThread->flags : 0;
+}
+
+uint32_t osThreadFlagsWait (uint32_t flags, uint32_t options, uint32_t timeout)
+{
+    host_thread_t * t = currentThread;
+    uint64_t deadline = ticks_to_deadline(timeout);
+    uint32_t ret;
+
+    if (t == NULL)
+    {
+        return osFlagsErrorISR;
+    }
+    pthread_mutex_lock(&t->lock);
+    for (;;)
+    {
+        bool done = (options & osFlagsWaitAll) ? ((t->flags & flags) == flags) : ((t->flags & flags) != 0);
+
+        if (done)
+        {
+            ret = t->flags;
+            if (!(options & osFlagsNoClear))
+            {
+                t->flags &= ~flags;
+            }
+            break;
+        }
+        if (timeout == 0)
+        {
+            ret = osFlagsErrorResource;
+            break;
+        }
+        if (!cond_wait_until(&t->cond, &t->lock, timeout, deadline))
+        {
+            ret = osFlagsErrorTimeout;
+            break;
+        }
+    }
+    pthread_mutex_unlock(&t->lock);
+    return ret;
+}
+
+osStatus_t osDelay (uint32_t ticks)
+{
+    sim_sleep_until_ns(ticks_to_deadline(ticks));
+    return osOK;
+}
+
+osStatus_t osDelayUntil (uint32_t ticks)
+{
+    sim_sleep_until_ns((uint64_t)ticks * (1000000000ULL / HOST_OS_TICK_FREQ));
+    return osOK;
+}
+
+static host_sync_t * sync_new (uint32_t max, uint32_t initial, bool isMutex)
+{
+    host_sync_t * s = calloc(1, sizeof(*s));
+
+    if (s == NULL)
+    {
+        return NULL;
+    }
+    pthread_mutex_init(&s->lock, NULL);
+    sim_cond_init(&s->cond);
+    s->max = max;
+    s->count = initial;
+    s->isMutex = isMutex;
+    return s;
+}
+
+static osStatus_t sync_acquire (host_sync_t * s, uint32_t timeout)
+{
+    uint64_t deadline = ticks_to_deadline(timeout);
+    osStatus_t ret = osOK;
+
+    if (s == NULL)
+    {
+        return osErrorParameter;
+    }
+    pthread_mutex_lock(&s->lock);
+    while (s->count == 0)
+    {
+        if (timeout == 0)
+        {
+            ret = osErrorResource;
+            break;
+        }
+        if (!cond_wait_until(&s->cond, &s->lock, timeout, deadline))
+        {
+            ret = osErrorTimeout;
+            break;
+        }
+    }
+    if (ret == osOK)
+    {
+        s->count--;
+        s->owner = currentThread;
+    }
+    pthread_mutex_unlock(&s->lock);
+    return ret;
+}
+
+static osStatus_t sync_release (host_sync_t * s)
+{
+    osStatus_t ret = osOK;
+
+    if (s == NULL)
+    {
+        return osErrorParameter;
+    }
+    pthread_mutex_lock(&s->lock);
+    if ((s->count >= s->max) || (s->isMutex && (s->owner != currentThread)))
+    {
+        ret = osErrorResource;
+    }
+    else
+    {
+        s->count++;
+        s->owner = NULL;
+        pthread_cond_signal(&s->cond);
+    }
+    pthread_mutex_unlock(&s->lock);
+    return ret;
+}
+
+osMutexId_t osMutexNew (const osMutexAttr_t * attr)
+{
+    if ((attr == NULL) || (attr->cb_mem == NULL))
+    {
+        simStats.rtosHeapObjects++;
+    }
+    return sync_new(1, 1, true);
+}
+
+osStatus_t osMutexAcquire (osMutexId_t mutex_id, uint32_t timeout)
+{
+    if (host_irq_context())
+    {
+        return osErrorISR;
+    }
+    return sync_acquire(mutex_id, timeout);
+}
+
+osStatus_t osMutexRelease (osMutexId_t mutex_id)
+{
+    if (host_irq_context())
+    {
+        return osErrorISR;
+    }
+    return sync_release(mutex_id);
+}
+
+osSemaphoreId_t osSemaphoreNew (uint32_t max_count, uint32_t initial_count, const osSemaphoreAttr_t * attr)
+{
+    if ((attr == NULL) || (attr->cb_mem == NULL))
+    {
+        simStats.rtosHeapObjects++;
+    }
+    if ((max_count == 0) || (initial_count > max_count))
+    {
+        return NULL;
+    }
+    return sync_new(max_count, initial_count, false);
+}
+
+osStatus_t osSemaphoreAcquire (osSemaphoreId_t semaphore_id, uint32_t timeout)
+{
+    if (host_irq_context() && (timeout != 0))
+    {
+        return osErrorParameter;
+    }
+    return sync_acquire(semaphore_id, timeout);
+}
+
+osStatus_t osSemaphoreRelease (osSemaphoreId_t semaphore_id)
+{
+    return sync_release(semaphore_id);
+}
+
+uint32_t osSemaphoreGetCount (osSemaphoreId_t semaphore_id)
+{
+    return (semaphore_id != NULL) ? ((host_sync_t *)semaphore_id)->count : 0;
+}
+
+osMessageQueueId_t osMessageQueueNew (uint32_t msg_count, uint32_t msg_size, const osMessageQueueAttr_t * attr)
+{
+    host_queue_t * q;
+
+    if ((attr == NULL) || (attr->cb_mem == NULL) || (attr->mq_mem == NULL))
+    {
+        simStats.rtosHeapObjects++;
+    }
+    if ((msg_count == 0) || (msg_size == 0))
+    {
+        return NULL;
+    }
+    q = calloc(1, sizeof(*q));
+    if (q == NULL)
+    {
+        return NULL;
+    }
+    pthread_mutex_init(&q->lock, NULL);
+    q->slots = sync_new(msg_count, msg_count, false);
+    q->msgs = sync_new(msg_count, 0, false);
+    q->buf = malloc(msg_count * msg_size);
+    q->msgSize = msg_size;
+    q->msgCount = msg_count;
+    if ((q->slots == NULL) || (q->msgs == NULL) || (q->buf == NULL))
+    {
+        return NULL;
+    }
+    return q;
+}
+
+osStatus_t osMessageQueuePut (osMessageQueueId_t mq_id, const void * msg_ptr, uint8_t msg_prio, uint32_t timeout)
+{
+    host_queue_t * q = mq_id;
+    osStatus_t ret;
+
+    (void)msg_prio;
+    if ((q == NULL) || (msg_ptr == NULL) || (host_irq_context() && (timeout != 0)))
+    {
+        return osErrorParameter;
+    }
+    ret = sync_acquire(q->slots, timeout);
+    if (ret != osOK)
+    {
+        return ret;
+    }
+    pthread_mutex_lock(&q->lock);
+    memcpy(&q->buf[q->tail * q->msgSize], msg_ptr, q->msgSize);
+    q->tail = (q->tail + 1) % q->msgCount;
+    pthread_mutex_unlock(&q->lock);
+    return sync_release(q->msgs);
+}
+
+osStatus_t osMessageQueueGet (osMessageQueueId_t mq_id, void * msg_ptr, uint8_t * msg_prio, uint32_t timeout)
+{
+    host_queue_t * q = mq_id;
+    osStatus_t ret;
+
+    if ((q == NULL) || (msg_ptr == NULL) || (host_irq_context() && (timeout != 0)))
+    {
+        return osErrorParameter;
+    }
+    ret = sync_acquire(q->msgs, timeout);
+    if (ret != osOK)
+    {
+        return ret;
+    }
+    pthread_mutex_lock(&q->lock);
+    memcpy(msg_ptr, &q->buf[q->head * q->msgSize], q->msgSize);
+    q->head = (q->head + 1) % q->msgCount;
+    pthread_mutex_unlock(&q->lock);
+    if (msg_prio != NULL)
+    {
+        *msg_prio = 0;
+    }
+    return sync_release(q->slots);
+}
+
+uint32_t osMessageQueueGetCount (osMessageQueueId_t mq_id)
+{
+    return (mq_id != NULL) ? osSemaphoreGetCount(((host_queue_t *)mq_id)->msgs) : 0;
+}
@@ -0,0 +1,72 @@
+/**
+ * @file host_platform.c
+ *
+ * @brief   Board support of the host simulation: platform init starts the simulation,
+ *          LEDs are kept in a variable, serial output is stdout and input stdin.
+ *
+ * @author agent
+ * @license MIT
+ *
+ * Copyright agent, 2026
+ */
+
+#include <stdio.h>
+#include <stdbool.h>
+#include <poll.h>
+#include <unistd.h>
+
+#include "platform.h"
+#include "retargetserial.h"
+#include "host_sim.h"
+
+// Application header, a binary blob included with INCBIN on target
+const unsigned char gHeaderData[] = { 0 };
+
+static volatile uint8_t leds;
+static bool inputClosed;
+
+void PLATFORM_Init (void)
+{
+    sim_init();
+}
+
+void PLATFORM_LedsInit (void)
+{
+    leds = 0;
+}
+
+void PLATFORM_LedsSet (uint8_t value)
+{
+    leds = value;
+}
+
+uint8_t PLATFORM_LedsGet (void)
+{
+    return leds;
+}
+
+void RETARGET_SerialInit (void)
+{
+    setvbuf(stdout, NULL, _IOLBF, 0);
+}
+
+/**
+ * @brief   Next character from stdin, -1 if none has arrived. Does not block.
+ */
+int RETARGET_ReadChar (void)
+{
+    struct pollfd pfd = { .fd = STDIN_FILENO, .events = POLLIN };
+    unsigned char c;
+
+    if (inputClosed || (poll(&pfd, 1, 0) <= 0))
+    {
+        return -1;
+    }
+    if (read(STDIN_FILENO, &c, 1) != 1)
+    {
+        // End of input, e.g. /dev/null
+        inputClosed = true;
+        return -1;
+    }
+    return c;
+}
@@ -0,0 +1,293 @@
+/**
+ * @file host_replay.c
+ *
+ * @brief   Replay of recorded traces through the firmware: throughput, per-window latency
+ *          and comparison of the analysis results with golden output.
+ *
+ * @details The sensor model reports when each sample is produced. sample_window_release() is
+ *          wrapped (linker --wrap) to take the time when the analysis of a window is complete,
+ *          window latency is the time from the last sample of the window being produced to
+ *          that point. sample_window_wait() is wrapped to find the analysis thread, whatever
+ *          it logs is the analysis result of the firmware. Lines with cycle counts are timing,
+ *          not results, and are left out.
+ *
+ *          Results are written to SIM_RESULTS (to create golden output) and compared line by
+ *          line with SIM_GOLDEN. At the end of the trace the simulation waits for the last
+ *          complete window to be analyzed, prints a report to stderr and exits with 0 if the
+ *          results match the golden output and no window was missed, 1 otherwise.
+ *
+ * @author agent
+ * @license MIT
+ *
+ * Copyright agent, 2026
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+
+#include "host_sim.h"
+#include "sample_window.h"
+#include "log_async.h"
+
+#define REPLAY_WINDOW_TIMES     64          // Windows in flight that latency can be measured for, power of two
+#define REPLAY_DRAIN_TIMEOUT_NS 2000000000  // Give up waiting for the last windows after this long
+#define REPLAY_STALL_TIMEOUT_NS 10000000000ULL  // Give up if the sensor produces no samples for this long
+#define REPLAY_TIMING_TAG       "cycles"    // Result lines containing this are skipped
+#define REPLAY_LINE_LEN         256
+
+void __real_sample_window_release(sample_window_t * w);
+sample_window_t * __real_sample_window_wait(uint32_t timeout);
+
+static pthread_mutex_t lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t doneCond;
+
+static pthread_t analysisThread;
+static volatile bool analysisThreadKnown;
+
+static uint64_t windowReadyNs[REPLAY_WINDOW_TIMES];  // Last sample of window produced
+static uint64_t firstSampleNs;
+static uint64_t lastReleaseNs;
+static uint32_t windowsDone;
+static uint64_t latencySumNs;
+static uint64_t latencyMinNs = UINT64_MAX;
+static uint64_t latencyMaxNs;
+static bool traceEnd;
+static uint32_t traceSamples;
+
+static FILE * resultsFile;
+static FILE * goldenFile;
+static uint32_t resultLines;
+static uint32_t mismatchLine;       // First line not matching golden output, 0 - none
+static char mismatchExpected[REPLAY_LINE_LEN];
+static char mismatchGot[REPLAY_LINE_LEN];
+
+/**
+ * @brief   Sample index was produced by the sensor model.
+ */
+void sim_replay_sample (uint32_t index)
+{
+    uint64_t now = sim_host_ns();
+    uint32_t length = sample_window_length();
+
+    if (index == 0)
+    {
+        firstSampleNs = now;
+    }
+    if ((index % length) == (length - 1))
+    {
+        windowReadyNs[(index / length) & (REPLAY_WINDOW_TIMES - 1)] = now;
+    }
+}
+
+/**
+ * @brief   The trace has no more samples.
+ */
+void sim_replay_end (uint32_t samples)
+{
+    pthread_mutex_lock(&lock);
+    traceEnd = true;
+    traceSamples = samples;
+    pthread_cond_broadcast(&doneCond);
+    pthread_mutex_unlock(&lock);
+}
+
+sample_window_t * __wrap_sample_window_wait (uint32_t timeout)
+{
+    if (!analysisThreadKnown)
+    {
+        analysisThread = pthread_self();
+        analysisThreadKnown = true;
+    }
+    return __real_sample_window_wait(timeout);
+}
+
+void __wrap_sample_window_release (sample_window_t * w)
+{
+    uint64_t now = sim_host_ns();
+    uint64_t latency = now - windowReadyNs[w->seq & (REPLAY_WINDOW_TIMES - 1)];
+
+    pthread_mutex_lock(&lock);
+    if (simConfig.traceIn != NULL)
+    {
+        latencySumNs += latency;
+        if (latency < latencyMinNs)
+        {
+            latencyMinNs = latency;
+        }
+        if (latency > latencyMaxNs)
+        {
+            latencyMaxNs = latency;
+        }
+    }
+    windowsDone++;
+    lastReleaseNs = now;
+    pthread_cond_broadcast(&doneCond);
+    pthread_mutex_unlock(&lock);
+
+    __real_sample_window_release(w);
+}
+
+static void strip_newline (char * s)
+{
+    s[strcspn(s, "\r\n")] = '\0';
+}
+
+/**
+ * @brief   Log line without timestamp, kept if it was logged by the analysis thread.
+ */
+void sim_replay_result (const char * line)
+{
+    char expected[REPLAY_LINE_LEN];
+    char got[REPLAY_LINE_LEN];
+
+    if (!analysisThreadKnown || !pthread_equal(pthread_self(), analysisThread) ||
+        (strstr(line, REPLAY_TIMING_TAG) != NULL))
+    {
+        return;
+    }
+
+    pthread_mutex_lock(&lock);
+    resultLines++;
+    if (resultsFile != NULL)
+    {
+        fputs(line, resultsFile);
+    }
+    if ((goldenFile != NULL) && (mismatchLine == 0))
+    {
+        snprintf(got, sizeof(got), "%s", line);
+        strip_newline(got);
+        if (fgets(expected, sizeof(expected), goldenFile) == NULL)
+        {
+            expected[0] = '\0';
+        }
+        strip_newline(expected);
+        if (strcmp(expected, got) != 0)
+        {
+            mismatchLine = resultLines;
+            memcpy(mismatchExpected, expected, sizeof(expected));
+            memcpy(mismatchGot, got, sizeof(got));
+        }
+    }
+    pthread_mutex_unlock(&lock);
+}
+
+/**
+ * @brief   Open the results and golden files, called at simulation start.
+ */
+void sim_replay_init (void)
+{
+    sim_cond_init(&doneCond);
+    if (simConfig.results != NULL)
+    {
+        resultsFile = fopen(simConfig.results, "w");
+        if (resultsFile == NULL)
+        {
+            perror(simConfig.results);
+            exit(1);
+        }
+    }
+    if (simConfig.golden != NULL)
+    {
+        goldenFile = fopen(simConfig.golden, "r");
+        if (goldenFile == NULL)
+        {
+            perror(simConfig.golden);
+            exit(1);
+        }
+    }
+}
+
+/**
+ * @brief   Called instead of running for SIM_DURATION when replaying a trace: waits until the
+ *          trace has been replayed and analyzed, reports and ends the process.
+ */
+void sim_replay_finish (void)
+{
+    uint32_t expected;
+    uint32_t done;
+    uint64_t elapsed;
+    bool pass = true;
+
+    pthread_mutex_lock(&lock);
+    while (!traceEnd)
+    {
+        uint32_t samples = simStats.samples;
+        uint64_t t = sim_host_ns() + REPLAY_STALL_TIMEOUT_NS;
+        struct timespec ts = { .tv_sec = (time_t)(t / 1000000000ULL), .tv_nsec = (long)(t % 1000000000ULL) };
+
+        if ((pthread_cond_timedwait(&doneCond, &lock, &ts) != 0) && (samples == simStats.samples))
+        {
+            fflush(stdout);
+            fprintf(stderr, "replay: stalled after %u samples\n", samples);
+            exit(1);
+        }
+    }
+    expected = traceSamples / sample_window_length();
+    lastReleaseNs = sim_host_ns();
+    while (windowsDone < expected)
+    {
+        struct timespec ts;
+        uint64_t deadline = lastReleaseNs + REPLAY_DRAIN_TIMEOUT_NS;
+
+        if (sim_host_ns() >= deadline)
+        {
+            break;
+        }
+        ts.tv_sec = (time_t)(deadline / 1000000000ULL);
+        ts.tv_nsec = (long)(deadline % 1000000000ULL);
+        pthread_cond_timedwait(&doneCond, &lock, &ts);
+    }
+    done = windowsDone;
+    elapsed = lastReleaseNs - firstSampleNs;
+
+    log_async_flush(SIM_LOG_FLUSH_TICKS);
+    fflush(stdout);
+    fprintf(stderr, "replay: %u samples, %u/%u windows in %.3f s, %.0f samples/s\n", traceSamples, done,
+            expected, elapsed / 1e9, (elapsed > 0) ? traceSamples * 1e9 / elapsed : 0.0);
+    if (done > 0)
+    {
+        fprintf(stderr, "replay: window latency min %.1f avg %.1f max %.1f us\n", latencyMinNs / 1e3,
+                latencySumNs / 1e3 / done, latencyMaxNs / 1e3);
+    }
+    if ((done != expected) || (sample_window_missed() != 0))
+    {
+        fprintf(stderr, "replay: %u windows missed\n", expected - done + sample_window_missed());
+        pass = false;
+    }
+
+    if (goldenFile != NULL)
+    {
+        char extra[REPLAY_LINE_LEN];
+
+        if ((mismatchLine == 0) && (fgets(extra, sizeof(extra), goldenFile) != NULL))
+        {
+            // Golden output has more lines than produced
+            mismatchLine = resultLines + 1;
+            strip_newline(extra);
+            snprintf(mismatchExpected, sizeof(mismatchExpected), "%s", extra);
+            mismatchGot[0] = '\0';
+        }
+        if (mismatchLine != 0)
+        {
+            fprintf(stderr, "replay: golden mismatch at result line %u\n-%s\n+%s\n", mismatchLine,
+                    mismatchExpected, mismatchGot);
+            pass = false;
+        }
+        else
+        {
+            fprintf(stderr, "replay: %u result lines match %s\n", resultLines, simConfig.golden);
+        }
+        fclose(goldenFile);
+        goldenFile = NULL;
+    }
+    if (resultsFile != NULL)
+    {
+        fclose(resultsFile);
+        resultsFile = NULL;
+    }
+    pthread_mutex_unlock(&lock);
+
+    exit(pass ? 0 : 1);
+}
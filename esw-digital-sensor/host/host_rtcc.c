@@ -0,0 +1,33 @@
+/**
+ * @file host_rtcc.c
+ *
+ * @brief   RTCC of the host simulation, counts the 32768 Hz LFXO in simulated time.
+ *
+ * @author agent
+ * @license MIT
+ *
+ * Copyright agent, 2026
+ */
+
+#include "em_rtcc.h"
+#include "host_sim.h"
+
+#define HOST_RTCC_LFXO_HZ   32768ULL
+
+static volatile bool rtccEnabled;
+static volatile uint32_t rtccPresc = 1;
+
+void RTCC_Init (const RTCC_Init_TypeDef * init)
+{
+    rtccPresc = 1UL << init->presc;
+    rtccEnabled = init->enable;
+}
+
+uint32_t RTCC_CounterGet (void)
+{
+    if (!rtccEnabled)
+    {
+        return 0;
+    }
+    return (uint32_t)(sim_time_ns() * HOST_RTCC_LFXO_HZ / rtccPresc / 1000000000ULL);
+}
@@ -0,0 +1,163 @@
+/**
+ * @file host_sim.c
+ *
+ * @brief   Simulated time, configuration and run statistics of the host simulation.
+ *
+ * @details Simulated time runs SIM_TIME_SCALE times faster than host time. RTOS ticks,
+ *          sensor output data rate and I2C bus time all use simulated time, so a run can
+ *          be sped up as long as the host keeps up with the firmware.
+ *
+ *          Configuration is read from the environment at PLATFORM_Init().
+ *
+ * @author agent
+ * @license MIT
+ *
+ * Copyright agent, 2026
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <errno.h>
+#include <unistd.h>
+
+#include "host_sim.h"
+#include "mma8653fc_sim.h"
+#include "log_async.h"
+#include "sample_window.h"
+
+sim_config_t simConfig;
+sim_stats_t simStats;
+
+static uint64_t hostStartNs;
+
+static double env_double (const char * name, double def)
+{
+    const char * s = getenv(name);
+
+    return (s != NULL) ? strtod(s, NULL) : def;
+}
+
+static void sim_report (void)
+{
+    fflush(stdout);
+    fprintf(stderr, "sim: %.3f s, samples %u, overwritten %u, i2c transfers %u, bytes %u, nacks %u, "
+            "ignored writes %u, irqs %u, uart bytes %u, flash erases %u, rtos heap objects %u\n", sim_time_ns() / 1e9,
+            simStats.samples, simStats.overwrites, simStats.i2cTransfers, simStats.i2cBytes, simStats.i2cNacks,
+            simStats.ignoredWrites, simStats.interrupts, simStats.uartBytes, simStats.flashErases, simStats.rtosHeapObjects);
+}
+
+/**
+ * @brief   Read configuration and start the simulated hardware.
+ */
+void sim_init (void)
+{
+    simConfig.durationS = env_double("SIM_DURATION", 0);
+    simConfig.timeScale = env_double("SIM_TIME_SCALE", 1);
+    simConfig.vibrationHz = env_double("SIM_VIB_HZ", 1);
+    simConfig.vibrationMg = env_double("SIM_VIB_MG", 250);
+    simConfig.vibrationOnS = env_double("SIM_VIB_ON", 0);
+    simConfig.vibrationOffS = env_double("SIM_VIB_OFF", 0);
+    simConfig.noiseMg = env_double("SIM_NOISE_MG", 10);
+    simConfig.seed = (uint32_t)env_double("SIM_SEED", 1);
+    simConfig.odrPpm = env_double("SIM_ODR_PPM", 0);
+    simConfig.windowLength = (uint32_t)env_double("SIM_WINDOW_LENGTH", 0);
+    simConfig.traceIn = getenv("SIM_TRACE");
+    simConfig.traceOut = getenv("SIM_TRACE_OUT");
+    simConfig.replayFast = env_double("SIM_REPLAY_FAST", 0) != 0;
+    simConfig.golden = getenv("SIM_GOLDEN");
+    simConfig.results = getenv("SIM_RESULTS");
+    simConfig.streamOut = getenv("SIM_STREAM_OUT");
+    simConfig.flashFile = getenv("SIM_FLASH");
+    if (simConfig.timeScale <= 0)
+    {
+        simConfig.timeScale = 1;
+    }
+
+    hostStartNs = sim_host_ns();
+    atexit(sim_report);
+
+    sim_replay_init();
+    host_irq_start();
+    host_i2c_start();
+    mma_sim_start();
+}
+
+/**
+ * @brief   Monotonic host time in ns.
+ */
+uint64_t sim_host_ns (void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+/**
+ * @brief   Simulated time since sim_init() in ns.
+ */
+uint64_t sim_time_ns (void)
+{
+    return (uint64_t)((double)(sim_host_ns() - hostStartNs) * simConfig.timeScale);
+}
+
+/**
+ * @brief   Host CLOCK_MONOTONIC time at which simulated time reaches simNs.
+ */
+struct timespec sim_host_deadline (uint64_t simNs)
+{
+    uint64_t hostNs = hostStartNs + (uint64_t)((double)simNs / simConfig.timeScale);
+    struct timespec ts;
+
+    ts.tv_sec = (time_t)(hostNs / 1000000000ULL);
+    ts.tv_nsec = (long)(hostNs % 1000000000ULL);
+    return ts;
+}
+
+/**
+ * @brief   Initialize a condition variable whose timed waits take CLOCK_MONOTONIC deadlines
+ *          (sim_host_deadline()).
+ */
+void sim_cond_init (pthread_cond_t * cond)
+{
+    pthread_condattr_t attr;
+
+    pthread_condattr_init(&attr);
+    pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+    pthread_cond_init(cond, &attr);
+    pthread_condattr_destroy(&attr);
+}
+
+void sim_sleep_until_ns (uint64_t simNs)
+{
+    struct timespec ts = sim_host_deadline(simNs);
+
+    while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL) == EINTR);
+}
+
+/**
+ * @brief   Called by osKernelStart() once the threads are running, ends the process after
+ *          SIM_DURATION of simulated time or when a replayed trace has been analyzed.
+ */
+void sim_run (void)
+{
+    if ((simConfig.windowLength != 0) && (sample_window_set_length((uint16_t)simConfig.windowLength) != 0))
+    {
+        fprintf(stderr, "sim: SIM_WINDOW_LENGTH %u not allowed\n", simConfig.windowLength);
+        exit(2);
+    }
+    if (simConfig.traceIn != NULL)
+    {
+        sim_replay_finish();
+    }
+    if (simConfig.durationS > 0)
+    {
+        sim_sleep_until_ns((uint64_t)(simConfig.durationS * 1e9));
+        log_async_flush(SIM_LOG_FLUSH_TICKS);
+        exit(0);
+    }
+    for (;;)
+    {
+        pause();
+    }
+}
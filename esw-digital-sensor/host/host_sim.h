@@ -0,0 +1,96 @@
+/**
+ * @file host_sim.h
+ *
+ * @brief   Internals shared by the host simulation modules: simulated time, configuration
+ *          and statistics.
+ *
+ * @author agent
+ * @license MIT
+ *
+ * Copyright agent, 2026
+ */
+
+#ifndef HOST_SIM_H_
+#define HOST_SIM_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <time.h>
+#include <pthread.h>
+
+#include "em_device.h"
+#include "em_gpio.h"
+
+// Board wiring of the sensor INT1 line
+#define SIM_INT1_PORT       gpioPortA
+#define SIM_INT1_PIN        1
+
+// Wait up to a host second for queued log output before exiting, in kernel ticks (1 kHz)
+#define SIM_LOG_FLUSH_TICKS ((uint32_t)(simConfig.timeScale * 1000))
+
+typedef struct
+{
+    double durationS;       // SIM_DURATION, simulated seconds to run, 0 - forever
+    double timeScale;       // SIM_TIME_SCALE, simulated seconds per host second
+    double vibrationHz;     // SIM_VIB_HZ, frequency of the vibration on the x axis
+    double vibrationMg;     // SIM_VIB_MG, amplitude of the vibration
+    double vibrationOnS;    // SIM_VIB_ON, vibration on for, 0 - always
+    double vibrationOffS;   // SIM_VIB_OFF, then off for
+    double noiseMg;         // SIM_NOISE_MG, peak uniform noise on all axes
+    uint32_t seed;          // SIM_SEED, noise generator seed
+    double odrPpm;          // SIM_ODR_PPM, sensor data rate error, positive is fast
+    uint32_t windowLength;  // SIM_WINDOW_LENGTH, samples per analysis window set at start, 0 - default
+    const char * traceIn;   // SIM_TRACE, replay samples from this trace instead
+    const char * traceOut;  // SIM_TRACE_OUT, record the samples produced into this trace
+    bool replayFast;        // SIM_REPLAY_FAST, next trace sample as soon as the previous one is read
+    const char * golden;    // SIM_GOLDEN, compare analysis results with this file
+    const char * results;   // SIM_RESULTS, write analysis results to this file
+    const char * streamOut; // SIM_STREAM_OUT, serial port output of the sample stream, stdout if not set
+    const char * flashFile; // SIM_FLASH, contents of the flash log area, kept in memory if not set
+} sim_config_t;
+
+typedef struct
+{
+    volatile uint32_t samples;          // Samples produced by the sensor model
+    volatile uint32_t overwrites;       // Samples overwritten before they were read
+    volatile uint32_t i2cTransfers;     // Transfers on the simulated I2C0
+    volatile uint32_t i2cBytes;         // Bytes on the bus, addresses included
+    volatile uint32_t i2cNacks;         // Transfers not acknowledged
+    volatile uint32_t ignoredWrites;    // Configuration writes dropped because the sensor was active
+    volatile uint32_t interrupts;       // Interrupt handler invocations
+    volatile uint32_t uartBytes;        // Bytes sent by the sample stream
+    volatile uint32_t flashErases;      // Flash pages erased
+    volatile uint32_t rtosHeapObjects;  // RTOS objects created without control block or stack memory
+} sim_stats_t;
+
+extern sim_config_t simConfig;
+extern sim_stats_t simStats;
+
+// host_sim.c
+void sim_init(void);
+uint64_t sim_time_ns(void);
+uint64_t sim_host_ns(void);
+void sim_sleep_until_ns(uint64_t simNs);
+void sim_cond_init(pthread_cond_t * cond);
+struct timespec sim_host_deadline(uint64_t simNs);
+void sim_run(void);
+
+// host_irq.c
+void host_irq_start(void);
+bool host_irq_idle(void);
+
+// host_gpio.c
+void sim_gpio_drive(GPIO_Port_TypeDef port, unsigned int pin, unsigned int level);
+
+// host_i2c.c
+void host_i2c_start(void);
+bool host_i2c_idle(void);
+
+// host_replay.c
+void sim_replay_init(void);
+void sim_replay_sample(uint32_t index);
+void sim_replay_end(uint32_t samples);
+void sim_replay_result(const char * line);
+void sim_replay_finish(void);
+
+#endif // HOST_SIM_H_
@@ -0,0 +1,93 @@
+/**
+ * @file host_uart.c
+ *
+ * @brief   Frame transmission of the host simulation, replaces stream_uart.c.
+ *
+ * @details A host thread plays the USART with TX DMA: a frame takes 10 bits per byte at the
+ *          configured baud rate in simulated time, then its bytes are written to
+ *          SIM_STREAM_OUT (stdout if not set) and the done callback runs like an interrupt
+ *          handler, with the interrupt lock held.
+ *
+ * @author agent
+ * @license MIT
+ *
+ * Copyright agent, 2026
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <pthread.h>
+
+#include "em_core.h"
+#include "host_sim.h"
+#include "stream_uart.h"
+
+static pthread_mutex_t uartLock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t uartCond = PTHREAD_COND_INITIALIZER;
+static pthread_t uartThread;
+static const uint8_t * txBuf;
+static uint16_t txLen;
+static uint32_t uartBaudrate;
+static stream_uart_done_f doneCb;
+static FILE * out;
+
+static void * uart_thread (void * arg)
+{
+    (void)arg;
+
+    for (;;)
+    {
+        const uint8_t * buf;
+        uint16_t len;
+
+        pthread_mutex_lock(&uartLock);
+        while (txBuf == NULL)
+        {
+            pthread_cond_wait(&uartCond, &uartLock);
+        }
+        buf = txBuf;
+        len = txLen;
+        pthread_mutex_unlock(&uartLock);
+
+        // Start bit, 8 data bits, stop bit
+        sim_sleep_until_ns(sim_time_ns() + (uint64_t)len * 10 * 1000000000ULL / uartBaudrate);
+        fwrite(buf, len, 1, out);
+        fflush(out);
+        simStats.uartBytes += len;
+
+        pthread_mutex_lock(&uartLock);
+        txBuf = NULL;
+        pthread_mutex_unlock(&uartLock);
+
+        host_irq_lock();
+        doneCb();
+        host_irq_unlock();
+    }
+    return NULL;
+}
+
+void stream_uart_init (uint32_t baudrate, stream_uart_done_f done)
+{
+    uartBaudrate = baudrate;
+    doneCb = done;
+    out = stdout;
+    if (simConfig.streamOut != NULL)
+    {
+        out = fopen(simConfig.streamOut, "wb");
+        if (out == NULL)
+        {
+            perror(simConfig.streamOut);
+            exit(1);
+        }
+    }
+    pthread_create(&uartThread, NULL, uart_thread, NULL);
+}
+
+void stream_uart_send (const uint8_t * buf, uint16_t len)
+{
+    pthread_mutex_lock(&uartLock);
+    txBuf = buf;
+    txLen = len;
+    pthread_cond_signal(&uartCond);
+    pthread_mutex_unlock(&uartLock);
+}
@@ -0,0 +1,10 @@
+/**
+ * @file DeviceSignature.h
+ *
+ * @brief   Host build stand-in, device signatures are not used in the simulation.
+ *
+ * @author agent
+ * @license MIT
+ *
+ * Copyright agent, 2026
+ */
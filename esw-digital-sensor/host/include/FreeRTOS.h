@@ -0,0 +1,37 @@
+/**
+ * @file FreeRTOS.h
+ *
+ * @brief   Host build stand-in for the FreeRTOS kernel configuration and port types, for the
+ *          tickless idle check (tickless_sim.c) and the static object memory of rtos_static.h.
+ *          The simulation itself runs on the CMSIS-RTOS2 stand-in (cmsis_os2.h).
+ *
+ * @author agent
+ * @license MIT
+ *
+ * Copyright agent, 2026
+ */
+
+#ifndef HOST_FREERTOS_H_
+#define HOST_FREERTOS_H_
+
+#include <stdint.h>
+
+typedef uint32_t TickType_t;
+typedef long BaseType_t;
+typedef unsigned long UBaseType_t;
+
+// Control block memory of statically allocated objects, not used by the stand-in
+typedef struct { void * reserved[24]; } StaticTask_t;
+typedef struct { void * reserved[20]; } StaticSemaphore_t;
+
+#define pdFALSE                         ((BaseType_t)0)
+#define pdTRUE                          ((BaseType_t)1)
+
+#define configTICK_RATE_HZ              1000
+#define configEXPECTED_IDLE_TIME_BEFORE_SLEEP   2
+
+#define portSET_INTERRUPT_MASK_FROM_ISR()       0
+#define portCLEAR_INTERRUPT_MASK_FROM_ISR(x)    ((void)(x))
+#define portYIELD_FROM_ISR(x)                   ((void)(x))
+
+#endif // HOST_FREERTOS_H_
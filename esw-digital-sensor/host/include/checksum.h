@@ -0,0 +1,20 @@
+/**
+ * @file checksum.h
+ *
+ * @brief   Host build stand-in for lammertb libcrc checksum.h, implemented in host_crc.c.
+ *
+ * @author agent
+ * @license MIT
+ *
+ * Copyright agent, 2026
+ */
+
+#ifndef HOST_CHECKSUM_H_
+#define HOST_CHECKSUM_H_
+
+#include <stdint.h>
+#include <stddef.h>
+
+uint16_t crc_ccitt_ffff(const unsigned char * input_str, size_t num_bytes);
+
+#endif // HOST_CHECKSUM_H_
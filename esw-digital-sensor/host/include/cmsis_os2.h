@@ -0,0 +1,160 @@
+/**
+ * @file cmsis_os2.h
+ *
+ * @brief   Host build stand-in for the CMSIS-RTOS2 API, the subset used by the firmware,
+ *          implemented on POSIX threads in host_os.c.
+ *
+ * @note    Thread priorities are recorded but not enforced, all threads are scheduled by
+ *          the host. Tick frequency is 1000 Hz of simulated time.
+ *
+ * ARM RTOS API
+ * https://arm-software.github.io/CMSIS_5/RTOS2/html/group__CMSIS__RTOS.html
+ *
+ * @author agent
+ * @license MIT
+ *
+ * Copyright agent, 2026
+ */
+
+#ifndef HOST_CMSIS_OS2_H_
+#define HOST_CMSIS_OS2_H_
+
+#include <stdint.h>
+#include <stddef.h>
+
+typedef enum
+{
+    osOK                    =  0,
+    osError                 = -1,
+    osErrorTimeout          = -2,
+    osErrorResource         = -3,
+    osErrorParameter        = -4,
+    osErrorNoMemory         = -5,
+    osErrorISR              = -6,
+    osStatusReserved        = 0x7FFFFFFF
+} osStatus_t;
+
+typedef enum
+{
+    osKernelInactive        =  0,
+    osKernelReady           =  1,
+    osKernelRunning         =  2,
+    osKernelLocked          =  3,
+    osKernelSuspended       =  4,
+    osKernelError           = -1,
+    osKernelReserved        = 0x7FFFFFFF
+} osKernelState_t;
+
+typedef enum
+{
+    osPriorityNone          =  0,
+    osPriorityIdle          =  1,
+    osPriorityLow           =  8,
+    osPriorityLow1          =  8+1,
+    osPriorityBelowNormal   = 16,
+    osPriorityBelowNormal1  = 16+1,
+    osPriorityNormal        = 24,
+    osPriorityNormal1       = 24+1,
+    osPriorityNormal2       = 24+2,
+    osPriorityAboveNormal   = 32,
+    osPriorityHigh          = 40,
+    osPriorityRealtime      = 48,
+    osPriorityISR           = 56,
+    osPriorityError         = -1,
+    osPriorityReserved      = 0x7FFFFFFF
+} osPriority_t;
+
+#define osWaitForever       0xFFFFFFFFU
+
+#define osFlagsWaitAny      0x00000000U
+#define osFlagsWaitAll      0x00000001U
+#define osFlagsNoClear      0x00000002U
+
+#define osFlagsError        0x80000000U
+#define osFlagsErrorUnknown 0xFFFFFFFFU
+#define osFlagsErrorTimeout 0xFFFFFFFEU
+#define osFlagsErrorResource 0xFFFFFFFDU
+#define osFlagsErrorParameter 0xFFFFFFFCU
+#define osFlagsErrorISR     0xFFFFFFFAU
+
+typedef void (*osThreadFunc_t)(void * argument);
+
+typedef void * osThreadId_t;
+typedef void * osMutexId_t;
+typedef void * osSemaphoreId_t;
+typedef void * osMessageQueueId_t;
+
+typedef struct
+{
+    const char * name;
+    uint32_t attr_bits;
+    void * cb_mem;
+    uint32_t cb_size;
+    void * stack_mem;
+    uint32_t stack_size;
+    osPriority_t priority;
+    uint32_t tz_module;
+    uint32_t reserved;
+} osThreadAttr_t;
+
+typedef struct
+{
+    const char * name;
+    uint32_t attr_bits;
+    void * cb_mem;
+    uint32_t cb_size;
+} osMutexAttr_t;
+
+typedef struct
+{
+    const char * name;
+    uint32_t attr_bits;
+    void * cb_mem;
+    uint32_t cb_size;
+} osSemaphoreAttr_t;
+
+typedef struct
+{
+    const char * name;
+    uint32_t attr_bits;
+    void * cb_mem;
+    uint32_t cb_size;
+    void * mq_mem;
+    uint32_t mq_size;
+} osMessageQueueAttr_t;
+
+osStatus_t osKernelInitialize(void);
+osStatus_t osKernelStart(void);
+osKernelState_t osKernelGetState(void);
+uint32_t osKernelGetTickCount(void);
+uint32_t osKernelGetTickFreq(void);
+
+osThreadId_t osThreadNew(osThreadFunc_t func, void * argument, const osThreadAttr_t * attr);
+osThreadId_t osThreadGetId(void);
+const char * osThreadGetName(osThreadId_t thread_id);
+uint32_t osThreadGetStackSpace(osThreadId_t thread_id);
+osStatus_t osThreadYield(void);
+
+uint32_t osThreadFlagsSet(osThreadId_t thread_id, uint32_t flags);
+uint32_t osThreadFlagsClear(uint32_t flags);
+uint32_t osThreadFlagsGet(void);
+uint32_t osThreadFlagsWait(uint32_t flags, uint32_t options, uint32_t timeout);
+
+osStatus_t osDelay(uint32_t ticks);
+osStatus_t osDelayUntil(uint32_t ticks);
+
+osMutexId_t osMutexNew(const osMutexAttr_t * attr);
+osStatus_t osMutexAcquire(osMutexId_t mutex_id, uint32_t timeout);
+osStatus_t osMutexRelease(osMutexId_t mutex_id);
+
+osSemaphoreId_t osSemaphoreNew(uint32_t max_count, uint32_t initial_count, const osSemaphoreAttr_t * attr);
+osStatus_t osSemaphoreAcquire(osSemaphoreId_t semaphore_id, uint32_t timeout);
+osStatus_t osSemaphoreRelease(osSemaphoreId_t semaphore_id);
+uint32_t osSemaphoreGetCount(osSemaphoreId_t semaphore_id);
+
+osMessageQueueId_t osMessageQueueNew(uint32_t msg_count, uint32_t msg_size, const osMessageQueueAttr_t * attr);
+osStatus_t osMessageQueuePut(osMessageQueueId_t mq_id, const void * msg_ptr, uint8_t msg_prio, uint32_t timeout);
+osStatus_t osMessageQueueGet(osMessageQueueId_t mq_id, void * msg_ptr, uint8_t * msg_prio, uint32_t timeout);
+uint32_t osMessageQueueGetCount(osMessageQueueId_t mq_id);
+
+#endif // HOST_CMSIS_OS2_H_
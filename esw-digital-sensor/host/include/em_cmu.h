@@ -0,0 +1,46 @@
+/**
+ * @file em_cmu.h
+ *
+ * @brief   Host build stand-in for emlib em_cmu.h, clocks are always on.
+ *
+ * @author agent
+ * @license MIT
+ *
+ * Copyright agent, 2026
+ */
+
+#ifndef HOST_EM_CMU_H_
+#define HOST_EM_CMU_H_
+
+#include "em_device.h"
+
+typedef enum
+{
+    cmuClock_HFPER,
+    cmuClock_GPIO,
+    cmuClock_I2C0,
+    cmuClock_LDMA,
+    cmuClock_USART0,
+    cmuClock_RTCC,
+    cmuClock_HFLE,
+    cmuClock_LFE
+} CMU_Clock_TypeDef;
+
+typedef enum
+{
+    cmuOsc_LFXO,
+    cmuOsc_LFRCO
+} CMU_Osc_TypeDef;
+
+typedef enum
+{
+    cmuSelect_LFXO,
+    cmuSelect_LFRCO
+} CMU_Select_TypeDef;
+
+static inline void CMU_ClockEnable(CMU_Clock_TypeDef clock, bool enable) { (void)clock; (void)enable; }
+static inline uint32_t CMU_ClockFreqGet(CMU_Clock_TypeDef clock) { (void)clock; return SystemCoreClock; }
+static inline void CMU_OscillatorEnable(CMU_Osc_TypeDef osc, bool enable, bool wait) { (void)osc; (void)enable; (void)wait; }
+static inline void CMU_ClockSelectSet(CMU_Clock_TypeDef clock, CMU_Select_TypeDef ref) { (void)clock; (void)ref; }
+
+#endif // HOST_EM_CMU_H_
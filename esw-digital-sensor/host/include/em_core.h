@@ -0,0 +1,30 @@
+/**
+ * @file em_core.h
+ *
+ * @brief   Host build stand-in for emlib em_core.h. Critical sections keep the simulated
+ *          interrupt handlers (host_irq.c) from running, like masking interrupts does on
+ *          the target.
+ *
+ * @author agent
+ * @license MIT
+ *
+ * Copyright agent, 2026
+ */
+
+#ifndef HOST_EM_CORE_H_
+#define HOST_EM_CORE_H_
+
+#include "em_device.h"
+
+void host_irq_lock(void);
+void host_irq_unlock(void);
+bool host_irq_context(void);
+
+#define CORE_DECLARE_IRQ_STATE      int irqState __attribute__((unused)) = 0
+#define CORE_ENTER_CRITICAL()       host_irq_lock()
+#define CORE_EXIT_CRITICAL()        host_irq_unlock()
+#define CORE_ENTER_ATOMIC()         host_irq_lock()
+#define CORE_EXIT_ATOMIC()          host_irq_unlock()
+#define CORE_InIrqContext()         host_irq_context()
+
+#endif // HOST_EM_CORE_H_
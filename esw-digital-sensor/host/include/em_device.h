@@ -0,0 +1,96 @@
+/**
+ * @file em_device.h
+ *
+ * @brief   Host build stand-in for the EFR32MG12 device header. Only what the firmware
+ *          uses: interrupt numbers, NVIC, core intrinsics, the DWT cycle counter and the
+ *          I2C0 registry block. NVIC and DWT are implemented in host_irq.c.
+ *
+ * @author agent
+ * @license MIT
+ *
+ * Copyright agent, 2026
+ */
+
+#ifndef HOST_EM_DEVICE_H_
+#define HOST_EM_DEVICE_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#define __IOM volatile
+#define __IM  volatile const
+
+typedef enum
+{
+    LDMA_IRQn       = 8,
+    GPIO_EVEN_IRQn  = 10,
+    USART0_RX_IRQn  = 11,
+    USART0_TX_IRQn  = 12,
+    I2C0_IRQn       = 17,
+    GPIO_ODD_IRQn   = 18,
+    RTCC_IRQn       = 30,
+    HOST_IRQn_COUNT = 32
+} IRQn_Type;
+
+void NVIC_EnableIRQ(IRQn_Type irq);
+void NVIC_DisableIRQ(IRQn_Type irq);
+void NVIC_ClearPendingIRQ(IRQn_Type irq);
+void NVIC_SetPendingIRQ(IRQn_Type irq);
+void NVIC_SetPriority(IRQn_Type irq, uint32_t priority);
+
+#define __NVIC_PRIO_BITS    3
+
+// PRIMASK, only the single threaded host tools mask interrupts this way
+void __disable_irq(void);
+void __enable_irq(void);
+
+static inline void __DMB(void) { __atomic_thread_fence(__ATOMIC_SEQ_CST); }
+static inline void __DSB(void) { __atomic_thread_fence(__ATOMIC_SEQ_CST); }
+static inline void __ISB(void) { __atomic_thread_fence(__ATOMIC_SEQ_CST); }
+static inline void __NOP(void) { }
+static inline uint32_t __CLZ(uint32_t v) { return (v == 0) ? 32 : (uint32_t)__builtin_clz(v); }
+
+// Cycle counter, reading DWT->CYCCNT gives host time at the 38.4 MHz core clock
+typedef struct
+{
+    __IOM uint32_t CTRL;
+    __IOM uint32_t CYCCNT;
+} DWT_Type;
+
+typedef struct
+{
+    __IOM uint32_t DEMCR;
+} CoreDebug_Type;
+
+DWT_Type * host_dwt(void);
+extern CoreDebug_Type host_core_debug;
+
+#define DWT                         (host_dwt())
+#define CoreDebug                   (&host_core_debug)
+#define DWT_CTRL_CYCCNTENA_Msk      (1UL << 0)
+#define CoreDebug_DEMCR_TRCENA_Msk  (1UL << 24)
+
+#define SystemCoreClock             38400000UL
+
+// I2C0, only the fields written by the firmware, transfers go through em_i2c.h
+typedef struct
+{
+    __IOM uint32_t CTRL;
+    __IOM uint32_t CMD;
+    __IM  uint32_t STATE;
+    __IM  uint32_t STATUS;
+    __IM  uint32_t RXDATA;
+    __IOM uint32_t TXDATA;
+    __IM  uint32_t IF;
+    __IOM uint32_t IEN;
+    __IOM uint32_t ROUTEPEN;
+    __IOM uint32_t ROUTELOC0;
+} I2C_TypeDef;
+
+extern I2C_TypeDef host_i2c0;
+
+#define I2C0                        (&host_i2c0)
+#define I2C_ROUTELOC0_SCLLOC_LOC1   (0x1UL << 8)
+
+#endif // HOST_EM_DEVICE_H_
@@ -0,0 +1,21 @@
+/**
+ * @file em_emu.h
+ *
+ * @brief   Host build stand-in for emlib em_emu.h, energy modes are entered in the tickless
+ *          idle check (tickless_sim.c).
+ *
+ * @author agent
+ * @license MIT
+ *
+ * Copyright agent, 2026
+ */
+
+#ifndef HOST_EM_EMU_H_
+#define HOST_EM_EMU_H_
+
+#include "em_device.h"
+
+void EMU_EnterEM1(void);
+void EMU_EnterEM2(bool restore);
+
+#endif // HOST_EM_EMU_H_
@@ -0,0 +1,54 @@
+/**
+ * @file em_gpio.h
+ *
+ * @brief   Host build stand-in for emlib em_gpio.h, implemented in host_gpio.c.
+ *
+ * @author agent
+ * @license MIT
+ *
+ * Copyright agent, 2026
+ */
+
+#ifndef HOST_EM_GPIO_H_
+#define HOST_EM_GPIO_H_
+
+#include "em_device.h"
+
+typedef enum
+{
+    gpioPortA = 0,
+    gpioPortB = 1,
+    gpioPortC = 2,
+    gpioPortD = 3,
+    gpioPortF = 5
+} GPIO_Port_TypeDef;
+
+typedef enum
+{
+    gpioModeDisabled,
+    gpioModeInput,
+    gpioModeInputPull,
+    gpioModeInputPullFilter,
+    gpioModePushPull,
+    gpioModeWiredAnd,
+    gpioModeWiredAndPullUp,
+    gpioModeWiredAndPullUpFilter
+} GPIO_Mode_TypeDef;
+
+#define GPIO_INSENSE_INT    0x1
+#define GPIO_INSENSE_PRS    0x2
+
+void GPIO_PinModeSet(GPIO_Port_TypeDef port, unsigned int pin, GPIO_Mode_TypeDef mode, unsigned int out);
+unsigned int GPIO_PinInGet(GPIO_Port_TypeDef port, unsigned int pin);
+void GPIO_PinOutSet(GPIO_Port_TypeDef port, unsigned int pin);
+void GPIO_PinOutClear(GPIO_Port_TypeDef port, unsigned int pin);
+void GPIO_ExtIntConfig(GPIO_Port_TypeDef port, unsigned int pin, unsigned int intNo,
+                       bool risingEdge, bool fallingEdge, bool enable);
+void GPIO_InputSenseSet(uint32_t val, uint32_t mask);
+void GPIO_IntClear(uint32_t flags);
+void GPIO_IntEnable(uint32_t flags);
+void GPIO_IntDisable(uint32_t flags);
+uint32_t GPIO_IntGet(void);
+uint32_t GPIO_IntGetEnabled(void);
+
+#endif // HOST_EM_GPIO_H_
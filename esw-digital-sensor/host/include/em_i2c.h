@@ -0,0 +1,85 @@
+/**
+ * @file em_i2c.h
+ *
+ * @brief   Host build stand-in for emlib em_i2c.h. Transfers are carried out by the
+ *          simulated bus in host_i2c.c, completion is signalled with I2C0_IRQn.
+ *
+ * @author agent
+ * @license MIT
+ *
+ * Copyright agent, 2026
+ */
+
+#ifndef HOST_EM_I2C_H_
+#define HOST_EM_I2C_H_
+
+#include "em_device.h"
+
+#define I2C_FLAG_WRITE          0x0001
+#define I2C_FLAG_READ           0x0002
+#define I2C_FLAG_WRITE_READ     0x0004
+#define I2C_FLAG_WRITE_WRITE    0x0008
+
+#define I2C_IF_RXDATAV          (1UL << 5)
+#define I2C_IF_ACK              (1UL << 6)
+#define I2C_IF_NACK             (1UL << 7)
+#define I2C_IF_MSTOP            (1UL << 8)
+#define I2C_IF_ARBLOST          (1UL << 9)
+#define I2C_IF_BUSERR           (1UL << 10)
+#define I2C_IF_BUSHOLD          (1UL << 11)
+#define _I2C_IF_MASK            0x0007FFFFUL
+#define _I2C_IEN_MASK           0x0007FFFFUL
+
+typedef enum
+{
+    i2cTransferInProgress = 1,
+    i2cTransferDone = 0,
+    i2cTransferNack = -1,
+    i2cTransferBusErr = -2,
+    i2cTransferArbLost = -3,
+    i2cTransferUsageFault = -4,
+    i2cTransferSwFault = -5
+} I2C_TransferReturn_TypeDef;
+
+typedef struct
+{
+    uint16_t addr;
+    uint16_t flags;
+    struct
+    {
+        uint8_t * data;
+        uint16_t len;
+    } buf[2];
+} I2C_TransferSeq_TypeDef;
+
+typedef enum
+{
+    i2cClockHLRStandard,
+    i2cClockHLRAsymetric,
+    i2cClockHLRFast
+} I2C_ClockHLR_TypeDef;
+
+typedef struct
+{
+    bool enable;
+    bool master;
+    uint32_t refFreq;
+    uint32_t freq;
+    I2C_ClockHLR_TypeDef clhr;
+} I2C_Init_TypeDef;
+
+#define I2C_FREQ_STANDARD_MAX   100000
+#define I2C_INIT_DEFAULT        { true, true, 0, I2C_FREQ_STANDARD_MAX, i2cClockHLRStandard }
+
+void I2C_Init(I2C_TypeDef * i2c, const I2C_Init_TypeDef * init);
+void I2C_Enable(I2C_TypeDef * i2c, bool enable);
+void I2C_Reset(I2C_TypeDef * i2c);
+I2C_TransferReturn_TypeDef I2C_TransferInit(I2C_TypeDef * i2c, I2C_TransferSeq_TypeDef * seq);
+I2C_TransferReturn_TypeDef I2C_Transfer(I2C_TypeDef * i2c);
+
+void I2C_IntClear(I2C_TypeDef * i2c, uint32_t flags);
+void I2C_IntEnable(I2C_TypeDef * i2c, uint32_t flags);
+void I2C_IntDisable(I2C_TypeDef * i2c, uint32_t flags);
+uint32_t I2C_IntGetEnabled(I2C_TypeDef * i2c);
+
+#endif // HOST_EM_I2C_H_
@@ -0,0 +1,62 @@
+/**
+ * @file em_rtcc.h
+ *
+ * @brief   Host build stand-in for emlib em_rtcc.h, the counter follows simulated time
+ *          (host_rtcc.c). Only the prescaler of the configuration is used. Compare channels
+ *          and interrupts are implemented by the tickless idle check (tickless_sim.c).
+ *
+ * @author agent
+ * @license MIT
+ *
+ * Copyright agent, 2026
+ */
+
+#ifndef HOST_EM_RTCC_H_
+#define HOST_EM_RTCC_H_
+
+#include "em_device.h"
+
+typedef enum
+{
+    rtccCntPresc_1 = 0,
+    rtccCntPresc_32 = 5
+} RTCC_CntPresc_TypeDef;
+
+typedef struct
+{
+    bool enable;
+    bool debugRun;
+    RTCC_CntPresc_TypeDef presc;
+} RTCC_Init_TypeDef;
+
+#define RTCC_INIT_DEFAULT   { true, false, rtccCntPresc_32 }
+
+typedef enum
+{
+    rtccCapComChModeOff,
+    rtccCapComChModeCapture,
+    rtccCapComChModeCompare
+} RTCC_CapComChMode_TypeDef;
+
+typedef struct
+{
+    RTCC_CapComChMode_TypeDef chMode;
+} RTCC_CCChConf_TypeDef;
+
+#define RTCC_CH_INIT_COMPARE_DEFAULT    { rtccCapComChModeCompare }
+
+#define RTCC_IF_CC0         (1UL << 1)
+#define RTCC_IF_CC1         (1UL << 2)
+#define RTCC_IF_CC2         (1UL << 3)
+#define RTCC_IEN_CC1        RTCC_IF_CC1
+
+void RTCC_Init(const RTCC_Init_TypeDef * init);
+uint32_t RTCC_CounterGet(void);
+void RTCC_ChannelInit(int ch, const RTCC_CCChConf_TypeDef * confPtr);
+void RTCC_ChannelCCVSet(int ch, uint32_t value);
+void RTCC_IntClear(uint32_t flags);
+void RTCC_IntEnable(uint32_t flags);
+void RTCC_IntSet(uint32_t flags);
+uint32_t RTCC_IntGet(void);
+
+#endif // HOST_EM_RTCC_H_
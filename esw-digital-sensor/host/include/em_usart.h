@@ -0,0 +1,31 @@
+/**
+ * @file em_usart.h
+ *
+ * @brief   Host build stand-in for emlib em_usart.h, only the status of the retarget serial
+ *          USART. Serial output of the simulation is in host_uart.c and host_platform.c.
+ *
+ * @author agent
+ * @license MIT
+ *
+ * Copyright agent, 2026
+ */
+
+#ifndef HOST_EM_USART_H_
+#define HOST_EM_USART_H_
+
+#include "em_device.h"
+
+typedef struct
+{
+    __IM uint32_t STATUS;
+} USART_TypeDef;
+
+extern USART_TypeDef host_usart0;
+
+#define USART0                  (&host_usart0)
+#define USART_STATUS_TXC        (1UL << 5)
+#define USART_STATUS_TXIDLE     (1UL << 13)
+
+uint32_t USART_StatusGet(USART_TypeDef * usart);
+
+#endif // HOST_EM_USART_H_
@@ -0,0 +1,17 @@
+/**
+ * @file incbin.h
+ *
+ * @brief   Host build stand-in, the application header binary is not included.
+ *
+ * @author agent
+ * @license MIT
+ *
+ * Copyright agent, 2026
+ */
+
+#ifndef HOST_INCBIN_H_
+#define HOST_INCBIN_H_
+
+#define INCBIN(name, file)  extern const unsigned char g##name##Data[]
+
+#endif // HOST_INCBIN_H_
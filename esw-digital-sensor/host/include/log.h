@@ -0,0 +1,64 @@
+/**
+ * @file log.h
+ *
+ * @brief   Host build stand-in for lll log.h. Same macros and level bits, messages are
+ *          formatted by host_log() and passed to the output given to log_init().
+ *
+ *          The including file defines __MODUUL__ and __LOG_LEVEL__ before including.
+ *
+ * @author agent
+ * @license MIT
+ *
+ * Copyright agent, 2026
+ */
+
+#ifndef HOST_LOG_H_
+#define HOST_LOG_H_
+
+#include <stdint.h>
+
+#define LOG_DEBUG4          0x0001
+#define LOG_DEBUG3          0x0002
+#define LOG_DEBUG2          0x0004
+#define LOG_DEBUG1          0x0008
+#define LOG_INFO4           0x0010
+#define LOG_INFO3           0x0020
+#define LOG_INFO2           0x0040
+#define LOG_INFO1           0x0080
+#define LOG_WARN4           0x0100
+#define LOG_WARN3           0x0200
+#define LOG_WARN2           0x0400
+#define LOG_WARN1           0x0800
+#define LOG_ERR4            0x1000
+#define LOG_ERR3            0x2000
+#define LOG_ERR2            0x4000
+#define LOG_ERR1            0x8000
+
+#define LOG_LEVEL_DEBUG     0xFFFF
+#define LOG_LEVEL_INFO      0xFFF0
+#define LOG_LEVEL_WARN      0xFF00
+#define LOG_LEVEL_ERR       0xF000
+#define LOG_LEVEL_NONE      0x0000
+
+void host_log(uint16_t level, const char * module, const char * fmt, ...) __attribute__((format(printf, 3, 4)));
+
+#define HOST_LOG_(lvl, ...) do { if ((__LOG_LEVEL__) & (lvl)) { host_log((lvl), __MODUUL__, __VA_ARGS__); } } while (0)
+
+#define debug4(...)         HOST_LOG_(LOG_DEBUG4, __VA_ARGS__)
+#define debug3(...)         HOST_LOG_(LOG_DEBUG3, __VA_ARGS__)
+#define debug2(...)         HOST_LOG_(LOG_DEBUG2, __VA_ARGS__)
+#define debug1(...)         HOST_LOG_(LOG_DEBUG1, __VA_ARGS__)
+#define info4(...)          HOST_LOG_(LOG_INFO4, __VA_ARGS__)
+#define info3(...)          HOST_LOG_(LOG_INFO3, __VA_ARGS__)
+#define info2(...)          HOST_LOG_(LOG_INFO2, __VA_ARGS__)
+#define info1(...)          HOST_LOG_(LOG_INFO1, __VA_ARGS__)
+#define warn4(...)          HOST_LOG_(LOG_WARN4, __VA_ARGS__)
+#define warn3(...)          HOST_LOG_(LOG_WARN3, __VA_ARGS__)
+#define warn2(...)          HOST_LOG_(LOG_WARN2, __VA_ARGS__)
+#define warn1(...)          HOST_LOG_(LOG_WARN1, __VA_ARGS__)
+#define err4(...)           HOST_LOG_(LOG_ERR4, __VA_ARGS__)
+#define err3(...)           HOST_LOG_(LOG_ERR3, __VA_ARGS__)
+#define err2(...)           HOST_LOG_(LOG_ERR2, __VA_ARGS__)
+#define err1(...)           HOST_LOG_(LOG_ERR1, __VA_ARGS__)
+
+#endif // HOST_LOG_H_
@@ -0,0 +1,18 @@
+/**
+ * @file logger_fwrite.h
+ *
+ * @brief   Host build stand-in for the thread-safe fwrite logger, implemented in host_log.c.
+ *
+ * @author agent
+ * @license MIT
+ *
+ * Copyright agent, 2026
+ */
+
+#ifndef HOST_LOGGER_FWRITE_H_
+#define HOST_LOGGER_FWRITE_H_
+
+void logger_fwrite_init(void);
+int logger_fwrite(const char * ptr, int len);
+
+#endif // HOST_LOGGER_FWRITE_H_
@@ -0,0 +1,22 @@
+/**
+ * @file loggers_ext.h
+ *
+ * @brief   Host build stand-in for lll loggers_ext.h, implemented in host_log.c.
+ *
+ * @author agent
+ * @license MIT
+ *
+ * Copyright agent, 2026
+ */
+
+#ifndef HOST_LOGGERS_EXT_H_
+#define HOST_LOGGERS_EXT_H_
+
+#include <stdint.h>
+
+typedef int (*log_output_f)(const char * ptr, int len);
+typedef uint32_t (*log_timestamp_f)(void);
+
+void log_init(uint16_t level, log_output_f output, log_timestamp_f timestamp);
+
+#endif // HOST_LOGGERS_EXT_H_
@@ -0,0 +1,23 @@
+/**
+ * @file platform.h
+ *
+ * @brief   Host build stand-in for the node-platform board support, implemented in
+ *          host_platform.c. LEDs are kept in a variable.
+ *
+ * @author agent
+ * @license MIT
+ *
+ * Copyright agent, 2026
+ */
+
+#ifndef HOST_PLATFORM_H_
+#define HOST_PLATFORM_H_
+
+#include <stdint.h>
+
+void PLATFORM_Init(void);
+void PLATFORM_LedsInit(void);
+void PLATFORM_LedsSet(uint8_t leds);
+uint8_t PLATFORM_LedsGet(void);
+
+#endif // HOST_PLATFORM_H_
@@ -0,0 +1,18 @@
+/**
+ * @file retargetserial.h
+ *
+ * @brief   Host build stand-in, output goes to stdout, input comes from stdin.
+ *
+ * @author agent
+ * @license MIT
+ *
+ * Copyright agent, 2026
+ */
+
+#ifndef HOST_RETARGETSERIAL_H_
+#define HOST_RETARGETSERIAL_H_
+
+void RETARGET_SerialInit(void);
+int RETARGET_ReadChar(void);
+
+#endif // HOST_RETARGETSERIAL_H_
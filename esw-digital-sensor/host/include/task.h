@@ -0,0 +1,29 @@
+/**
+ * @file task.h
+ *
+ * @brief   Host build stand-in for the FreeRTOS task API used by a port tick and tickless
+ *          idle, implemented by the tickless idle check (tickless_sim.c).
+ *
+ * @author agent
+ * @license MIT
+ *
+ * Copyright agent, 2026
+ */
+
+#ifndef HOST_TASK_H_
+#define HOST_TASK_H_
+
+#include "FreeRTOS.h"
+
+typedef enum
+{
+    eAbortSleep = 0,
+    eStandardSleep,
+    eNoTasksWaitingTimeout
+} eSleepModeStatus;
+
+BaseType_t xTaskIncrementTick(void);
+void vTaskStepTick(TickType_t xTicksToJump);
+eSleepModeStatus eTaskConfirmSleepModeStatus(void);
+
+#endif // HOST_TASK_H_
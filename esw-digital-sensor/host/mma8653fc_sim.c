@@ -0,0 +1,719 @@
+/**
+ * @file mma8653fc_sim.c
+ *
+ * @brief   Register level model of the MMA8653FC accelerometer for the host simulation.
+ *
+ * @details Modelled:
+ *          - registry map with reset values, WHO_AM_I 0x5A, read-only registries
+ *          - register address auto-increment, over the data registries it wraps back to
+ *            STATUS and skips the LSB registries with CTRL_REG1 F_READ set
+ *          - configuration can only be changed in standby, writes to other registries and
+ *            to fields of CTRL_REG1 other than ACTIVE are dropped while active (counted)
+ *          - CTRL_REG2 RST soft reset
+ *          - output data rate clock from CTRL_REG1 DR, off by SIM_ODR_PPM, new samples set the
+ *            STATUS data ready and overwrite flags, reading OUT_x_MSB clears them
+ *          - data ready interrupt (CTRL_REG4/5) on INT1 with CTRL_REG3 polarity
+ *          - freefall/motion detection on every sample: FF_MT_CFG axes, OR/AND and latch,
+ *            FF_MT_THS threshold and debounce mode, FF_MT_COUNT; FF_MT_SRC read clears
+ *          - auto-sleep: with CTRL_REG2 SLPE the sensor goes to sleep after ASLP_COUNT
+ *            steps without a wake event (FF_MT enabled in CTRL_REG4 and CTRL_REG3), runs at
+ *            the CTRL_REG1 ASLP_RATE and wakes on the next one; SYSMOD read clears the source
+ *          - FF_MT and auto-sleep interrupt sources, on INT1 if routed there (INT2 is not wired)
+ *          Not modelled: portrait/landscape, offsets, the oversampling modes of CTRL_REG2.
+ *
+ *          Acceleration is 1 g on z, a SIM_VIB_HZ sine of SIM_VIB_MG on x and SIM_NOISE_MG
+ *          uniform noise on all axes. With SIM_VIB_ON and SIM_VIB_OFF the vibration is on for
+ *          SIM_VIB_ON seconds and off for SIM_VIB_OFF seconds in turn. With SIM_TRACE set, samples are replayed from a trace
+ *          file instead (see sim_trace.h), rescaled if the trace was recorded with another
+ *          range. SIM_REPLAY_FAST=1 produces the next sample as soon as the previous one has
+ *          been read instead of at the output data rate. SIM_TRACE_OUT records the samples
+ *          produced into a trace.
+ *
+ * MMA8653FC datasheet
+ * https://www.nxp.com/docs/en/data-sheet/MMA8653FC.pdf
+ *
+ * @author agent
+ * @license MIT
+ *
+ * Copyright agent, 2026
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <pthread.h>
+
+#include "mma8653fc_reg.h"
+#include "host_sim.h"
+#include "mma8653fc_sim.h"
+#include "sim_trace.h"
+
+#define MMA_SIM_REGS            0x32
+#define MMA_SIM_WHO_AM_I        0x5A
+#define MMA_SIM_PI              3.14159265358979323846
+#define MMA_SIM_READ_TIMEOUT_NS 100000000   // Fast replay produces the next sample anyway after this long
+#define MMA_SIM_IDLE_POLL_NS    10000
+
+#define MMA_SIM_REG_PL_CFG      0x11
+#define MMA_SIM_REG_PL_BF_ZCOMP 0x13
+#define MMA_SIM_REG_PL_THS      0x14
+
+static pthread_mutex_t lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t wakeCond;
+static pthread_cond_t readCond;
+static pthread_t odrThread;
+
+static uint8_t regs[MMA_SIM_REGS];
+static uint8_t regPointer;
+static bool firstWrite;         // Next byte written in this transfer is the registry address
+static uint32_t clockGen;       // Incremented when the data rate clock must restart
+static uint32_t rngState;
+static bool sleeping;            // Auto-sleep, SYSMOD is SLEEP
+static uint32_t inactiveMs;     // Time without a wake event, auto-sleep
+static uint8_t ffmtDebounce;
+static sim_trace_t traceIn;
+static sim_trace_t traceOut;
+static bool traceEnded;
+static uint32_t nackSkip;       // Transfers acknowledged before nackTransfers, mma_sim_nack()
+static uint32_t nackTransfers;  // Transfers to the sensor not acknowledged
+
+// Output data rates of CTRL_REG1 DR in mHz
+static const uint32_t odrMhz[8] = { 800000, 400000, 200000, 100000, 50000, 12500, 6250, 1563 };
+
+// Output data rates of CTRL_REG1 ASLP_RATE in mHz
+static const uint32_t aslpOdrMhz[4] = { 50000, 12500, 6250, 1563 };
+
+static bool is_active (void)
+{
+    return (regs[MMA8653FC_REGADDR_CTRL_REG1] & MMA8653FC_CTRL_REG1_SAMODE_MASK) != 0;
+}
+
+static bool fast_read (void)
+{
+    return (regs[MMA8653FC_REGADDR_CTRL_REG1] & MMA8653FC_CTRL_REG1_READ_MOD_MASK) != 0;
+}
+
+// Output data rate of the current mode
+static uint32_t current_odr_mhz (void)
+{
+    if (sleeping)
+    {
+        return aslpOdrMhz[(regs[MMA8653FC_REGADDR_CTRL_REG1] & MMA8653FC_CTRL_REG1_ASPL_DR_MASK) >> MMA8653FC_CTRL_REG1_ASPL_DR_SHIFT];
+    }
+    return odrMhz[(regs[MMA8653FC_REGADDR_CTRL_REG1] & MMA8653FC_CTRL_REG1_DATA_RATE_MASK) >> MMA8653FC_CTRL_REG1_DATA_RATE_SHIFT];
+}
+
+static bool is_writable (uint8_t addr)
+{
+    // XYZ_DATA_CFG, PL_CFG ... FF_MT_CFG, FF_MT_THS, FF_MT_COUNT, ASLP_COUNT ... OFF_Z
+    return (addr == MMA8653FC_REGADDR_XYZ_DATA_CFG) ||
+           ((addr >= MMA_SIM_REG_PL_CFG) && (addr <= 0x15)) ||
+           (addr == 0x17) || (addr == 0x18) ||
+           ((addr >= MMA8653FC_REGADDR_ASLP_COUNT) && (addr < MMA_SIM_REGS));
+}
+
+// Drive INT1 from the interrupt sources routed to it, lock must be held.
+static void int1_update (void)
+{
+    uint8_t src = regs[MMA8653FC_REGADDR_INT_SOURCE] & regs[MMA8653FC_REGADDR_CTRL_REG4];
+    bool assert = (src & regs[MMA8653FC_REGADDR_CTRL_REG5]) != 0;
+    bool activeHigh = (regs[MMA8653FC_REGADDR_CTRL_REG3] & MMA8653FC_CTRL_REG3_POLARITY_MASK) != 0;
+
+    sim_gpio_drive(SIM_INT1_PORT, SIM_INT1_PIN, (assert == activeHigh) ? 1 : 0);
+}
+
+// Data ready source follows ZYXDR while the interrupt is enabled, lock must be held.
+static void drdy_update (void)
+{
+    if ((regs[MMA8653FC_REGADDR_STATUS] & MMA8653FC_STATUS_ZYXDR_MASK) &&
+        (regs[MMA8653FC_REGADDR_CTRL_REG4] & MMA8653FC_CTRL_REG4_DRDY_INT_MASK))
+    {
+        regs[MMA8653FC_REGADDR_INT_SOURCE] |= MMA8653FC_INT_SOURCE_DRDY_MASK;
+    }
+    else
+    {
+        regs[MMA8653FC_REGADDR_INT_SOURCE] &= ~MMA8653FC_INT_SOURCE_DRDY_MASK;
+    }
+    int1_update();
+}
+
+// Interrupt source bit follows a condition while enabled in CTRL_REG4, lock must be held.
+static void int_source_set (uint8_t srcMask, uint8_t enMask, bool set)
+{
+    if (set && (regs[MMA8653FC_REGADDR_CTRL_REG4] & enMask))
+    {
+        regs[MMA8653FC_REGADDR_INT_SOURCE] |= srcMask;
+    }
+    else if (!set)
+    {
+        regs[MMA8653FC_REGADDR_INT_SOURCE] &= ~srcMask;
+    }
+}
+
+// Wake mode, as after activation
+static void wake_state_reset (void)
+{
+    sleeping = false;
+    inactiveMs = 0;
+    ffmtDebounce = 0;
+}
+
+static void reset_registers (void)
+{
+    memset(regs, 0, sizeof(regs));
+    wake_state_reset();
+    regs[MMA8653FC_REGADDR_WHO_AM_I] = MMA_SIM_WHO_AM_I;
+    regs[MMA_SIM_REG_PL_CFG] = 0x80;
+    regs[MMA_SIM_REG_PL_BF_ZCOMP] = 0x44;
+    regs[MMA_SIM_REG_PL_THS] = 0x84;
+    regPointer = 0;
+    clockGen++;
+    drdy_update();
+}
+
+static double noise_mg (void)
+{
+    // xorshift32
+    rngState ^= rngState << 13;
+    rngState ^= rngState >> 17;
+    rngState ^= rngState << 5;
+    return simConfig.noiseMg * ((double)rngState / 2147483648.0 - 1.0);
+}
+
+static double full_scale_mg (uint8_t range)
+{
+    return 2000.0 * (1 << (range & MMA8653FC_XYZ_DATA_CFG_RANGE_MASK));
+}
+
+static void store_axis (uint8_t msbAddr, double mg)
+{
+    long count = lround(mg * 512.0 / full_scale_mg(regs[MMA8653FC_REGADDR_XYZ_DATA_CFG]));
+
+    if (count > 511)
+    {
+        count = 511;
+    }
+    if (count < -512)
+    {
+        count = -512;
+    }
+    regs[msbAddr] = (uint8_t)((count >> 2) & 0xFF);
+    regs[msbAddr + 1] = (uint8_t)((count & 0x03) << 6);
+}
+
+static int16_t load_axis (uint8_t msbAddr)
+{
+    return (int16_t)((int8_t)regs[msbAddr] * 4 + (regs[msbAddr + 1] >> 6));
+}
+
+/*
+ * Freefall/motion detection on the new sample, lock must be held. Returns true if the
+ * debounced condition holds, which is a wake event for auto-sleep if enabled.
+ */
+static bool ffmt_update (void)
+{
+    uint8_t cfg = regs[MMA8653FC_REGADDR_FF_MT_CFG];
+    uint8_t ths = regs[MMA8653FC_REGADDR_FF_MT_THS];
+    double thsMg = (ths & MMA8653FC_FF_MT_THS_THS_MASK) * (double)MMA8653FC_FF_MT_THS_MG_PER_LSB;
+    double countMg = full_scale_mg(regs[MMA8653FC_REGADDR_XYZ_DATA_CFG]) / 512.0;
+    bool motion = (cfg & MMA8653FC_FF_MT_CFG_OAE_MASK) != 0;
+    bool cond = !motion;
+    uint8_t flags = 0;
+    uint8_t axis;
+
+    if ((cfg & MMA8653FC_FF_MT_CFG_AXES_MASK) == 0)
+    {
+        return false;
+    }
+    for (axis = 0; axis < 3; axis++)
+    {
+        double mg = load_axis(MMA8653FC_REGADDR_OUT_X_MSB + 2 * axis) * countMg;
+        bool above = fabs(mg) > thsMg;
+
+        if (!(cfg & (MMA8653FC_FF_MT_CFG_XEFE_MASK << axis)))
+        {
+            continue;
+        }
+        if (above)
+        {
+            // HE and HP bits of the axis
+            flags |= (MMA8653FC_FF_MT_SRC_XHE_MASK | ((mg < 0) ? MMA8653FC_FF_MT_SRC_XHP_MASK : 0)) << (2 * axis);
+        }
+        cond = motion ? (cond || above) : (cond && !above);
+    }
+
+    if (cond)
+    {
+        if (ffmtDebounce < 0xFF)
+        {
+            ffmtDebounce++;
+        }
+    }
+    else if (ths & MMA8653FC_FF_MT_THS_DBCNTM_MASK)
+    {
+        ffmtDebounce = 0;
+    }
+    else if (ffmtDebounce > 0)
+    {
+        ffmtDebounce--;
+    }
+    cond = cond && (ffmtDebounce > regs[MMA8653FC_REGADDR_FF_MT_COUNT]);
+
+    if (cfg & MMA8653FC_FF_MT_CFG_ELE_MASK)
+    {
+        // Frozen at the event until FF_MT_SRC is read
+        if (cond && !(regs[MMA8653FC_REGADDR_FF_MT_SRC] & MMA8653FC_FF_MT_SRC_EA_MASK))
+        {
+            regs[MMA8653FC_REGADDR_FF_MT_SRC] = MMA8653FC_FF_MT_SRC_EA_MASK | (motion ? flags : 0);
+            int_source_set(MMA8653FC_INT_SOURCE_FF_MT_MASK, MMA8653FC_CTRL_REG4_FFMT_INT_MASK, true);
+        }
+    }
+    else
+    {
+        regs[MMA8653FC_REGADDR_FF_MT_SRC] = cond ? (MMA8653FC_FF_MT_SRC_EA_MASK | (motion ? flags : 0)) : 0;
+        if (cond)
+        {
+            int_source_set(MMA8653FC_INT_SOURCE_FF_MT_MASK, MMA8653FC_CTRL_REG4_FFMT_INT_MASK, true);
+        }
+    }
+    return cond && (regs[MMA8653FC_REGADDR_CTRL_REG4] & MMA8653FC_CTRL_REG4_FFMT_INT_MASK) &&
+           (regs[MMA8653FC_REGADDR_CTRL_REG3] & MMA8653FC_CTRL_REG3_WAKE_FFMT_MASK);
+}
+
+// Auto-sleep after a sample of periodMs, lock must be held.
+static void aslp_update (bool wakeEvent, uint32_t periodMs)
+{
+    uint32_t step = ((regs[MMA8653FC_REGADDR_CTRL_REG1] & MMA8653FC_CTRL_REG1_DATA_RATE_MASK) ==
+                     (MMA8653FC_CTRL_REG1_DR_1HZ << MMA8653FC_CTRL_REG1_DATA_RATE_SHIFT)) ?
+                    MMA8653FC_ASLP_COUNT_STEP_MS_1HZ : MMA8653FC_ASLP_COUNT_STEP_MS;
+
+    if (!(regs[MMA8653FC_REGADDR_CTRL_REG2] & MMA8653FC_CTRL_REG2_ASLEEP_MASK))
+    {
+        return;
+    }
+    if (wakeEvent)
+    {
+        inactiveMs = 0;
+        if (sleeping)
+        {
+            sleeping = false;
+            regs[MMA8653FC_REGADDR_SYSMOD] = MMA8653FC_SYSMOD_MOD_WAKE;
+            int_source_set(MMA8653FC_INT_SOURCE_ASLP_MASK, MMA8653FC_CTRL_REG4_ASLP_INT_MASK, true);
+            clockGen++;
+        }
+        return;
+    }
+    if (!sleeping)
+    {
+        inactiveMs += periodMs;
+        if (inactiveMs >= regs[MMA8653FC_REGADDR_ASLP_COUNT] * step)
+        {
+            sleeping = true;
+            regs[MMA8653FC_REGADDR_SYSMOD] = MMA8653FC_SYSMOD_MOD_SLEEP;
+            int_source_set(MMA8653FC_INT_SOURCE_ASLP_MASK, MMA8653FC_CTRL_REG4_ASLP_INT_MASK, true);
+            clockGen++;
+        }
+    }
+}
+
+// Vibration on the x axis at simulated time s
+static double vibration_mg (double s)
+{
+    double cycle = simConfig.vibrationOnS + simConfig.vibrationOffS;
+
+    if ((simConfig.vibrationOnS > 0) && (simConfig.vibrationOffS > 0) && (fmod(s, cycle) >= simConfig.vibrationOnS))
+    {
+        return 0;
+    }
+    return simConfig.vibrationMg * sin(2 * MMA_SIM_PI * simConfig.vibrationHz * s);
+}
+
+static void record_sample (void)
+{
+    int16_t xyz[3];
+
+    if (traceOut.f == NULL)
+    {
+        sim_trace_info_t info;
+
+        info.range = regs[MMA8653FC_REGADDR_XYZ_DATA_CFG] & MMA8653FC_XYZ_DATA_CFG_RANGE_MASK;
+        info.resolution = fast_read() ? 8 : 10;
+        info.odrMhz = odrMhz[(regs[MMA8653FC_REGADDR_CTRL_REG1] & MMA8653FC_CTRL_REG1_DATA_RATE_MASK) >> MMA8653FC_CTRL_REG1_DATA_RATE_SHIFT];
+        if (sim_trace_open_write(&traceOut, simConfig.traceOut, &info) != 0)
+        {
+            perror(simConfig.traceOut);
+            simConfig.traceOut = NULL;
+            return;
+        }
+    }
+    xyz[0] = load_axis(MMA8653FC_REGADDR_OUT_X_MSB);
+    xyz[1] = load_axis(MMA8653FC_REGADDR_OUT_Y_MSB);
+    xyz[2] = load_axis(MMA8653FC_REGADDR_OUT_Z_MSB);
+    sim_trace_write(&traceOut, xyz);
+}
+
+static void close_traces (void)
+{
+    pthread_mutex_lock(&lock);
+    sim_trace_close(&traceOut);
+    sim_trace_close(&traceIn);
+    pthread_mutex_unlock(&lock);
+}
+
+// New sample at simulated time t, lock must be held. Returns false at the end of the trace.
+static bool new_sample (uint64_t t)
+{
+    double s = (double)t / 1e9;
+    uint8_t status = regs[MMA8653FC_REGADDR_STATUS];
+
+    if (traceIn.f != NULL)
+    {
+        double countMg = full_scale_mg(traceIn.info.range) / 512.0;
+        int16_t xyz[3];
+
+        if (traceEnded || !sim_trace_read(&traceIn, xyz))
+        {
+            if (!traceEnded)
+            {
+                traceEnded = true;
+                sim_replay_end(simStats.samples);
+            }
+            return false;
+        }
+        store_axis(MMA8653FC_REGADDR_OUT_X_MSB, xyz[0] * countMg);
+        store_axis(MMA8653FC_REGADDR_OUT_Y_MSB, xyz[1] * countMg);
+        store_axis(MMA8653FC_REGADDR_OUT_Z_MSB, xyz[2] * countMg);
+    }
+    else
+    {
+        store_axis(MMA8653FC_REGADDR_OUT_X_MSB, vibration_mg(s) + noise_mg());
+        store_axis(MMA8653FC_REGADDR_OUT_Y_MSB, noise_mg());
+        store_axis(MMA8653FC_REGADDR_OUT_Z_MSB, 1000.0 + noise_mg());
+    }
+    if (simConfig.traceOut != NULL)
+    {
+        record_sample();
+    }
+
+    // Unread data ready flags turn into overwrite flags
+    status |= (status & 0x07) << 4;
+    if (status & MMA8653FC_STATUS_ZYXDR_MASK)
+    {
+        status |= MMA8653FC_STATUS_ZYXOW_MASK;
+        simStats.overwrites++;
+    }
+    status |= 0x07 | MMA8653FC_STATUS_ZYXDR_MASK;
+    regs[MMA8653FC_REGADDR_STATUS] = status;
+    sim_replay_sample(simStats.samples);
+    simStats.samples++;
+    aslp_update(ffmt_update(), 1000000 / current_odr_mhz());
+    drdy_update();
+    return true;
+}
+
+/*
+ * Fast replay, wait until the sample has been read and the firmware has handled the end of
+ * the transfer (so the next data ready interrupt is not lost), or MMA_SIM_READ_TIMEOUT_NS of
+ * host time at most. Lock must be held.
+ */
+static void wait_sample_read (void)
+{
+    uint64_t t = sim_host_ns() + MMA_SIM_READ_TIMEOUT_NS;
+    struct timespec deadline = { .tv_sec = (time_t)(t / 1000000000ULL), .tv_nsec = (long)(t % 1000000000ULL) };
+    const struct timespec poll = { .tv_sec = 0, .tv_nsec = MMA_SIM_IDLE_POLL_NS };
+
+    while ((regs[MMA8653FC_REGADDR_STATUS] & MMA8653FC_STATUS_ZYXDR_MASK) && is_active())
+    {
+        if (pthread_cond_timedwait(&readCond, &lock, &deadline) != 0)
+        {
+            return;
+        }
+    }
+    while (!host_i2c_idle() || !host_irq_idle())
+    {
+        if (sim_host_ns() >= t)
+        {
+            return;
+        }
+        pthread_mutex_unlock(&lock);
+        nanosleep(&poll, NULL);
+        pthread_mutex_lock(&lock);
+    }
+}
+
+static void * odr_thread (void * arg)
+{
+    (void)arg;
+
+    pthread_mutex_lock(&lock);
+    for (;;)
+    {
+        uint32_t gen;
+        uint64_t period, next;
+        bool fast, first;
+
+        while (!is_active())
+        {
+            pthread_cond_wait(&wakeCond, &lock);
+        }
+
+        gen = clockGen;
+        period = 1000000000000ULL / current_odr_mhz();
+        period = (uint64_t)(period / (1.0 + simConfig.odrPpm / 1000000.0));
+        next = sim_time_ns() + period;
+
+        if ((traceIn.f != NULL) && (odrMhz[(regs[MMA8653FC_REGADDR_CTRL_REG1] & MMA8653FC_CTRL_REG1_DATA_RATE_MASK) >> MMA8653FC_CTRL_REG1_DATA_RATE_SHIFT] != traceIn.info.odrMhz))
+        {
+            fprintf(stderr, "sim: trace recorded at %u mHz, sensor configured for %u mHz\n", traceIn.info.odrMhz,
+                    odrMhz[(regs[MMA8653FC_REGADDR_CTRL_REG1] & MMA8653FC_CTRL_REG1_DATA_RATE_MASK) >> MMA8653FC_CTRL_REG1_DATA_RATE_SHIFT]);
+        }
+
+        // Fast replay: the first sample comes one period after activation as usual, the
+        // following ones as soon as the previous one has been read.
+        fast = simConfig.replayFast && (traceIn.f != NULL);
+        first = true;
+        while (is_active() && (gen == clockGen))
+        {
+            if (!fast || first)
+            {
+                // A CTRL_REG1 write ends the wait, the sensor runs at the new rate at once
+                struct timespec ts = sim_host_deadline(next);
+
+                while (is_active() && (gen == clockGen) && (pthread_cond_timedwait(&wakeCond, &lock, &ts) == 0));
+            }
+            if (is_active() && (gen == clockGen))
+            {
+                if (!new_sample(next))
+                {
+                    break;
+                }
+                next += period;
+                first = false;
+                if (fast)
+                {
+                    wait_sample_read();
+                }
+            }
+        }
+        if (traceEnded)
+        {
+            // Nothing more to produce
+            pthread_mutex_unlock(&lock);
+            return NULL;
+        }
+    }
+    return NULL;
+}
+
+void mma_sim_start (void)
+{
+    rngState = (simConfig.seed != 0) ? simConfig.seed : 1;
+    if ((simConfig.traceIn != NULL) && (sim_trace_open_read(&traceIn, simConfig.traceIn) != 0))
+    {
+        fprintf(stderr, "sim: can not read trace %s\n", simConfig.traceIn);
+        exit(1);
+    }
+    atexit(close_traces);
+    sim_cond_init(&readCond);
+    sim_cond_init(&wakeCond);
+    pthread_mutex_lock(&lock);
+    reset_registers();
+    pthread_mutex_unlock(&lock);
+    pthread_create(&odrThread, NULL, odr_thread, NULL);
+}
+
+/**
+ * @brief   Registry value of the model, read without a bus transfer (no side effects).
+ *
+ * @return  0 for addresses past the registry map
+ */
+uint8_t mma_sim_register (uint8_t addr)
+{
+    uint8_t value;
+
+    pthread_mutex_lock(&lock);
+    value = (addr < MMA_SIM_REGS) ? regs[addr] : 0;
+    pthread_mutex_unlock(&lock);
+    return value;
+}
+
+/**
+ * @brief   Fail transfers to the sensor (no acknowledge), a failing bus or sensor.
+ *
+ * @param   skip Transfers acknowledged first.
+ * @param   transfers Transfers not acknowledged after them.
+ */
+void mma_sim_nack (uint32_t skip, uint32_t transfers)
+{
+    pthread_mutex_lock(&lock);
+    nackSkip = skip;
+    nackTransfers = transfers;
+    pthread_mutex_unlock(&lock);
+}
+
+void mma_sim_i2c_lock (void)
+{
+    pthread_mutex_lock(&lock);
+}
+
+void mma_sim_i2c_unlock (void)
+{
+    pthread_mutex_unlock(&lock);
+}
+
+/**
+ * @return  true if the address (8-bit, with R/W bit) is acknowledged
+ */
+bool mma_sim_i2c_address (uint8_t addr)
+{
+    if ((addr != MMA8653FC_SLAVE_ADDRESS_WRITE) && (addr != MMA8653FC_SLAVE_ADDRESS_READ))
+    {
+        return false;
+    }
+    if (nackSkip > 0)
+    {
+        nackSkip--;
+    }
+    else if (nackTransfers > 0)
+    {
+        nackTransfers--;
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief   START or repeated START, the registry pointer is kept.
+ */
+void mma_sim_i2c_start (void)
+{
+    firstWrite = true;
+}
+
+static void write_register (uint8_t addr, uint8_t value)
+{
+    bool active = is_active();
+
+    if (!is_writable(addr))
+    {
+        return;
+    }
+
+    if (addr == MMA8653FC_REGADDR_CTRL_REG1)
+    {
+        // Only ACTIVE can be changed in active mode
+        if (active && ((value ^ regs[addr]) & ~MMA8653FC_CTRL_REG1_SAMODE_MASK))
+        {
+            simStats.ignoredWrites++;
+            value = (regs[addr] & ~MMA8653FC_CTRL_REG1_SAMODE_MASK) | (value & MMA8653FC_CTRL_REG1_SAMODE_MASK);
+        }
+        if ((value ^ regs[addr]) & MMA8653FC_CTRL_REG1_SAMODE_MASK)
+        {
+            // Activation starts in wake mode
+            wake_state_reset();
+            clockGen++;
+        }
+        regs[addr] = value;
+        regs[MMA8653FC_REGADDR_SYSMOD] = (value & MMA8653FC_CTRL_REG1_SAMODE_MASK) ? MMA8653FC_SYSMOD_MOD_WAKE : MMA8653FC_SYSMOD_MOD_STANDBY;
+        pthread_cond_broadcast(&wakeCond);
+        return;
+    }
+
+    if ((addr == MMA8653FC_REGADDR_CTRL_REG2) && (value & MMA8653FC_CTRL_REG2_SOFTRST_MASK))
+    {
+        // Soft reset works in any mode
+        reset_registers();
+        return;
+    }
+
+    if (active)
+    {
+        simStats.ignoredWrites++;
+        return;
+    }
+    regs[addr] = value;
+    drdy_update();
+}
+
+/**
+ * @brief   Byte written by the master, the first one after START sets the registry pointer.
+ */
+void mma_sim_i2c_write (uint8_t data)
+{
+    if (firstWrite)
+    {
+        firstWrite = false;
+        regPointer = (data < MMA_SIM_REGS) ? data : 0;
+        return;
+    }
+    write_register(regPointer, data);
+    regPointer = (regPointer + 1 < MMA_SIM_REGS) ? regPointer + 1 : 0;
+}
+
+/**
+ * @brief   Byte read by the master from the registry pointer.
+ */
+uint8_t mma_sim_i2c_read (void)
+{
+    uint8_t addr = regPointer;
+    uint8_t value = regs[addr];
+
+    switch (addr)
+    {
+        case MMA8653FC_REGADDR_OUT_X_MSB:
+        case MMA8653FC_REGADDR_OUT_Y_MSB:
+        case MMA8653FC_REGADDR_OUT_Z_MSB:
+        {
+            // Reading the MSB clears the data ready and overwrite flags of the axis.
+            uint8_t axis = 1 << ((addr - MMA8653FC_REGADDR_OUT_X_MSB) / 2);
+
+            regs[MMA8653FC_REGADDR_STATUS] &= ~(axis | (axis << 4));
+            if ((regs[MMA8653FC_REGADDR_STATUS] & 0x07) == 0)
+            {
+                regs[MMA8653FC_REGADDR_STATUS] &= ~(MMA8653FC_STATUS_ZYXDR_MASK | MMA8653FC_STATUS_ZYXOW_MASK);
+                pthread_cond_signal(&readCond);
+            }
+            drdy_update();
+            break;
+        }
+        case MMA8653FC_REGADDR_SYSMOD:
+            regs[MMA8653FC_REGADDR_INT_SOURCE] &= ~MMA8653FC_INT_SOURCE_ASLP_MASK;
+            int1_update();
+            break;
+        case MMA8653FC_REGADDR_FF_MT_SRC:
+            if (regs[MMA8653FC_REGADDR_FF_MT_CFG] & MMA8653FC_FF_MT_CFG_ELE_MASK)
+            {
+                regs[MMA8653FC_REGADDR_FF_MT_SRC] = 0;
+            }
+            regs[MMA8653FC_REGADDR_INT_SOURCE] &= ~MMA8653FC_INT_SOURCE_FF_MT_MASK;
+            int1_update();
+            break;
+        default:
+            break;
+    }
+
+    // Auto-increment, data registries wrap back to STATUS
+    if (addr <= MMA8653FC_REGADDR_OUT_Z_LSB)
+    {
+        if (fast_read())
+        {
+            regPointer = (addr == MMA8653FC_REGADDR_STATUS) ? MMA8653FC_REGADDR_OUT_X_MSB :
+                         (addr >= MMA8653FC_REGADDR_OUT_Z_MSB) ? MMA8653FC_REGADDR_STATUS : (uint8_t)((addr + 1) | 1);
+        }
+        else
+        {
+            regPointer = (addr == MMA8653FC_REGADDR_OUT_Z_LSB) ? MMA8653FC_REGADDR_STATUS : addr + 1;
+        }
+    }
+    else
+    {
+        regPointer = (addr + 1 < MMA_SIM_REGS) ? addr + 1 : 0;
+    }
+    return value;
+}
+
+void mma_sim_i2c_stop (void)
+{
+    firstWrite = false;
+}
@@ -0,0 +1,30 @@
+/**
+ * @file mma8653fc_sim.h
+ *
+ * @author agent
+ * @license MIT
+ *
+ * Copyright agent, 2026
+ */
+
+#ifndef MMA8653FC_SIM_H_
+#define MMA8653FC_SIM_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Public functions
+void mma_sim_start(void);
+uint8_t mma_sim_register(uint8_t addr);
+void mma_sim_nack(uint32_t skip, uint32_t transfers);
+
+// I2C slave interface, one transfer is START, address, bytes ..., STOP
+void mma_sim_i2c_lock(void);
+void mma_sim_i2c_unlock(void);
+bool mma_sim_i2c_address(uint8_t addr);
+void mma_sim_i2c_start(void);
+void mma_sim_i2c_write(uint8_t data);
+uint8_t mma_sim_i2c_read(void);
+void mma_sim_i2c_stop(void);
+
+#endif // MMA8653FC_SIM_H_
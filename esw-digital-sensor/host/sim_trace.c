@@ -0,0 +1,178 @@
+/**
+ * @file sim_trace.c
+ *
+ * @brief   Reading and writing accelerometer trace files, see sim_trace.h for the format.
+ *
+ * @author agent
+ * @license MIT
+ *
+ * Copyright agent, 2026
+ */
+
+#include <string.h>
+
+#include "sim_trace.h"
+
+static const char traceMagic[4] = { 'M', 'M', 'A', 'T' };
+
+static uint32_t get_le32 (const uint8_t * p)
+{
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static void put_le32 (uint8_t * p, uint32_t v)
+{
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+    p[2] = (uint8_t)(v >> 16);
+    p[3] = (uint8_t)(v >> 24);
+}
+
+// 10 bit 2's complement field to count
+static int16_t unpack_count (uint32_t word, uint8_t shift)
+{
+    int16_t v = (int16_t)((word >> shift) & 0x3FF);
+
+    return (v & 0x200) ? (int16_t)(v - 0x400) : v;
+}
+
+static uint32_t pack_count (int16_t count, uint8_t shift)
+{
+    if (count > 511)
+    {
+        count = 511;
+    }
+    if (count < -512)
+    {
+        count = -512;
+    }
+    return ((uint32_t)count & 0x3FF) << shift;
+}
+
+/**
+ * @brief   Open a trace for reading and check the header.
+ *
+ * @return  -1 if the file can not be opened or is not a trace
+ *           0 otherwise
+ */
+int8_t sim_trace_open_read (sim_trace_t * t, const char * path)
+{
+    uint8_t hdr[SIM_TRACE_HEADER_LEN];
+
+    memset(t, 0, sizeof(*t));
+    t->f = fopen(path, "rb");
+    if (t->f == NULL)
+    {
+        return -1;
+    }
+    if ((fread(hdr, sizeof(hdr), 1, t->f) != 1) || (memcmp(hdr, traceMagic, sizeof(traceMagic)) != 0) ||
+        (hdr[4] != SIM_TRACE_VERSION))
+    {
+        fclose(t->f);
+        t->f = NULL;
+        return -1;
+    }
+    t->info.range = hdr[5];
+    t->info.resolution = hdr[6];
+    t->info.odrMhz = get_le32(&hdr[8]);
+    t->info.samples = get_le32(&hdr[12]);
+    return 0;
+}
+
+/**
+ * @brief   Read the next sample.
+ *
+ * @return  false at the end of the trace
+ */
+bool sim_trace_read (sim_trace_t * t, int16_t xyz[3])
+{
+    uint8_t buf[4];
+    uint32_t word;
+
+    if ((t->info.samples != SIM_TRACE_SAMPLES_UNKNOWN) && (t->pos >= t->info.samples))
+    {
+        return false;
+    }
+    if (fread(buf, sizeof(buf), 1, t->f) != 1)
+    {
+        return false;
+    }
+    word = get_le32(buf);
+    xyz[0] = unpack_count(word, 0);
+    xyz[1] = unpack_count(word, 10);
+    xyz[2] = unpack_count(word, 20);
+    t->pos++;
+    return true;
+}
+
+/**
+ * @brief   Create a trace. The sample count in the header is filled in by sim_trace_close().
+ *
+ * @return  -1 if the file can not be created
+ *           0 otherwise
+ */
+int8_t sim_trace_open_write (sim_trace_t * t, const char * path, const sim_trace_info_t * info)
+{
+    uint8_t hdr[SIM_TRACE_HEADER_LEN];
+
+    memset(t, 0, sizeof(*t));
+    t->f = fopen(path, "wb");
+    if (t->f == NULL)
+    {
+        return -1;
+    }
+    t->info = *info;
+    t->info.samples = SIM_TRACE_SAMPLES_UNKNOWN;
+    t->write = true;
+
+    memset(hdr, 0, sizeof(hdr));
+    memcpy(hdr, traceMagic, sizeof(traceMagic));
+    hdr[4] = SIM_TRACE_VERSION;
+    hdr[5] = t->info.range;
+    hdr[6] = t->info.resolution;
+    put_le32(&hdr[8], t->info.odrMhz);
+    put_le32(&hdr[12], t->info.samples);
+    if (fwrite(hdr, sizeof(hdr), 1, t->f) != 1)
+    {
+        fclose(t->f);
+        t->f = NULL;
+        return -1;
+    }
+    return 0;
+}
+
+/**
+ * @brief   Append a sample, counts are saturated to -512 ... 511.
+ */
+bool sim_trace_write (sim_trace_t * t, const int16_t xyz[3])
+{
+    uint8_t buf[4];
+
+    put_le32(buf, pack_count(xyz[0], 0) | pack_count(xyz[1], 10) | pack_count(xyz[2], 20));
+    if (fwrite(buf, sizeof(buf), 1, t->f) != 1)
+    {
+        return false;
+    }
+    t->pos++;
+    return true;
+}
+
+void sim_trace_close (sim_trace_t * t)
+{
+    if (t->f == NULL)
+    {
+        return;
+    }
+    if (t->write)
+    {
+        uint8_t buf[4];
+
+        put_le32(buf, t->pos);
+        if (fseek(t->f, 12, SEEK_SET) == 0)
+        {
+            fwrite(buf, sizeof(buf), 1, t->f);
+        }
+    }
+    fclose(t->f);
+    t->f = NULL;
+}
@@ -0,0 +1,61 @@
+/**
+ * @file sim_trace.h
+ *
+ * @brief   Accelerometer trace files for replaying recorded sessions in the host simulation.
+ *
+ * @details A trace is a 16 byte header followed by one 32 bit word per sample, all little
+ *          endian:
+ *
+ *          offset  size  field
+ *          0       4     magic "MMAT"
+ *          4       1     format version, SIM_TRACE_VERSION
+ *          5       1     range, MMA8653FC_XYZ_DATA_CFG_*_RANGE the samples were taken with
+ *          6       1     resolution, valid bits of the samples (10 or 8)
+ *          7       1     reserved, 0
+ *          8       4     output data rate in mHz
+ *          12      4     number of samples, SIM_TRACE_SAMPLES_UNKNOWN - until end of file
+ *
+ *          Sample word: x in bits 0...9, y in bits 10...19, z in bits 20...29, each a 10 bit
+ *          2's complement count (-512 ... 511), bits 30 and 31 are 0.
+ *
+ * @author agent
+ * @license MIT
+ *
+ * Copyright agent, 2026
+ */
+
+#ifndef SIM_TRACE_H_
+#define SIM_TRACE_H_
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#define SIM_TRACE_VERSION           1
+#define SIM_TRACE_HEADER_LEN        16
+#define SIM_TRACE_SAMPLES_UNKNOWN   0xFFFFFFFFUL
+
+typedef struct
+{
+    uint8_t range;          // MMA8653FC_XYZ_DATA_CFG_*_RANGE
+    uint8_t resolution;     // Valid bits of the samples
+    uint32_t odrMhz;        // Output data rate in mHz
+    uint32_t samples;       // Number of samples, SIM_TRACE_SAMPLES_UNKNOWN if not known
+} sim_trace_info_t;
+
+typedef struct
+{
+    FILE * f;
+    sim_trace_info_t info;
+    uint32_t pos;           // Samples read or written
+    bool write;
+} sim_trace_t;
+
+// Public functions
+int8_t sim_trace_open_read(sim_trace_t * t, const char * path);
+bool sim_trace_read(sim_trace_t * t, int16_t xyz[3]);
+int8_t sim_trace_open_write(sim_trace_t * t, const char * path, const sim_trace_info_t * info);
+bool sim_trace_write(sim_trace_t * t, const int16_t xyz[3]);
+void sim_trace_close(sim_trace_t * t);
+
+#endif // SIM_TRACE_H_
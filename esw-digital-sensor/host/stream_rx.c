@@ -0,0 +1,243 @@
+/**
+ * @file stream_rx.c
+ *
+ * @brief   Receiver for the sample stream of a SAMPLE_STREAM=1 build (sample_stream.h).
+ *
+ * @details Usage:
+ *          digi-sensor-stream [-o samples.csv] [input]
+ *
+ *          Reads frames from input (a capture file or a serial port set up with stty,
+ *          stdin if not given), checks the CRC and the frame and sample sequence. Log text
+ *          from text frames goes to stdout. With -o the samples are written as CSV, x,y,z
+ *          counts per line, which digi-sensor-trace can import; lost samples are marked
+ *          with comment lines. At the end the frame and sample counts, losses and the
+ *          throughput over the sender's time span are printed to stderr.
+ *
+ * @author agent
+ * @license MIT
+ *
+ * Copyright agent, 2026
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "checksum.h"
+#include "sample_stream.h"
+
+#define RX_BUF_LEN      4096
+
+static FILE * csv;
+
+static uint32_t framesOk;
+static uint32_t framesLost;
+static uint32_t crcErrors;
+static uint32_t skippedBytes;
+static uint32_t frameBytes;
+static uint32_t samplesRx;
+static uint32_t samplesLost;
+
+static bool haveSeq;
+static uint8_t nextSeq;
+static bool haveIndex;
+static uint32_t nextIndex;
+static uint32_t firstMs;
+static uint32_t lastMs;
+static uint32_t lastOdrMhz;
+static uint8_t lastCount;
+
+static uint16_t get_le16 (const uint8_t * p)
+{
+    return (uint16_t)(p[0] | (p[1] << 8));
+}
+
+static uint32_t get_le32 (const uint8_t * p)
+{
+    return get_le16(p) | ((uint32_t)get_le16(p + 2) << 16);
+}
+
+static int16_t sign10 (uint32_t v)
+{
+    return (int16_t)((v & 0x200) ? (int32_t)(v & 0x3FF) - 1024 : (int32_t)(v & 0x3FF));
+}
+
+static void samples_frame (const uint8_t * p, uint16_t len)
+{
+    uint32_t index = get_le32(&p[0]);
+    uint32_t ms = get_le32(&p[4]);
+    uint32_t odrMhz = get_le32(&p[8]);
+    uint8_t count = p[12];
+    uint8_t i;
+
+    if ((len < SAMPLE_STREAM_BATCH_HDR_LEN) ||
+        (len < SAMPLE_STREAM_BATCH_HDR_LEN + (uint32_t)count * SAMPLE_STREAM_SAMPLE_LEN))
+    {
+        return;
+    }
+
+    if (haveIndex && (index != nextIndex))
+    {
+        samplesLost += index - nextIndex;
+        if (csv != NULL)
+        {
+            fprintf(csv, "# lost %u samples at %u\n", index - nextIndex, nextIndex);
+        }
+    }
+    if (!haveIndex)
+    {
+        firstMs = ms;
+    }
+    haveIndex = true;
+    nextIndex = index + count;
+    lastMs = ms;
+    lastCount = count;
+
+    if ((csv != NULL) && (odrMhz != lastOdrMhz))
+    {
+        fprintf(csv, "# odr %u mHz, resolution %u\n", odrMhz, p[13]);
+    }
+    lastOdrMhz = odrMhz;
+
+    for (i = 0; i < count; i++)
+    {
+        uint32_t s = get_le32(&p[SAMPLE_STREAM_BATCH_HDR_LEN + i * SAMPLE_STREAM_SAMPLE_LEN]);
+
+        if (csv != NULL)
+        {
+            fprintf(csv, "%d,%d,%d\n", sign10(s), sign10(s >> 10), sign10(s >> 20));
+        }
+    }
+    samplesRx += count;
+}
+
+/**
+ * @brief   Parse frames from buf.
+ *
+ * @return  Bytes consumed, the rest is an incomplete frame.
+ */
+static size_t parse (const uint8_t * buf, size_t n)
+{
+    size_t pos = 0;
+
+    while (pos + SAMPLE_STREAM_HDR_LEN <= n)
+    {
+        const uint8_t * f = &buf[pos];
+        uint16_t len;
+
+        if ((f[0] != SAMPLE_STREAM_SYNC0) || (f[1] != SAMPLE_STREAM_SYNC1))
+        {
+            pos++;
+            skippedBytes++;
+            continue;
+        }
+        len = get_le16(&f[4]);
+        if (len > SAMPLE_STREAM_PAYLOAD_MAX)
+        {
+            pos++;
+            skippedBytes++;
+            continue;
+        }
+        if (pos + SAMPLE_STREAM_HDR_LEN + len + SAMPLE_STREAM_CRC_LEN > n)
+        {
+            break;
+        }
+        if (crc_ccitt_ffff(&f[2], SAMPLE_STREAM_HDR_LEN - 2 + len) != get_le16(&f[SAMPLE_STREAM_HDR_LEN + len]))
+        {
+            // Not a frame or a damaged one, look for the next sync
+            crcErrors++;
+            pos++;
+            skippedBytes++;
+            continue;
+        }
+
+        if (haveSeq && (f[3] != nextSeq))
+        {
+            framesLost += (uint8_t)(f[3] - nextSeq);
+        }
+        haveSeq = true;
+        nextSeq = f[3] + 1;
+        framesOk++;
+        frameBytes += SAMPLE_STREAM_HDR_LEN + len + SAMPLE_STREAM_CRC_LEN;
+
+        if (f[2] == SAMPLE_STREAM_TYPE_SAMPLES)
+        {
+            samples_frame(&f[SAMPLE_STREAM_HDR_LEN], len);
+        }
+        else if (f[2] == SAMPLE_STREAM_TYPE_TEXT)
+        {
+            fwrite(&f[SAMPLE_STREAM_HDR_LEN], len, 1, stdout);
+        }
+        pos += SAMPLE_STREAM_HDR_LEN + len + SAMPLE_STREAM_CRC_LEN;
+    }
+    return pos;
+}
+
+int main (int argc, char * argv[])
+{
+    static uint8_t buf[RX_BUF_LEN];
+    FILE * in = stdin;
+    size_t n = 0;
+    size_t got;
+    double spanS;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "o:")) != -1)
+    {
+        if (opt == 'o')
+        {
+            csv = fopen(optarg, "w");
+            if (csv == NULL)
+            {
+                perror(optarg);
+                return 1;
+            }
+        }
+        else
+        {
+            fprintf(stderr, "usage: %s [-o samples.csv] [input]\n", argv[0]);
+            return 2;
+        }
+    }
+    if (optind < argc)
+    {
+        in = fopen(argv[optind], "rb");
+        if (in == NULL)
+        {
+            perror(argv[optind]);
+            return 1;
+        }
+    }
+
+    // Serial ports return what has arrived, files fill the buffer
+    while ((got = fread(&buf[n], 1, sizeof(buf) - n, in)) > 0)
+    {
+        size_t used;
+
+        n += got;
+        used = parse(buf, n);
+        memmove(buf, &buf[used], n - used);
+        n -= used;
+        fflush(stdout);
+    }
+    skippedBytes += n;
+
+    spanS = (lastMs - firstMs) / 1000.0;
+    fprintf(stderr, "stream: %u frames, %u lost, %u crc errors, %u bytes skipped\n", framesOk, framesLost,
+            crcErrors, skippedBytes);
+    fprintf(stderr, "stream: %u samples, %u lost", samplesRx, samplesLost);
+    if (spanS > 0)
+    {
+        fprintf(stderr, ", %.1f samples/s, %.0f bytes/s over %.3f s", (samplesRx - lastCount) / spanS, frameBytes / spanS, spanS);
+    }
+    fprintf(stderr, "\n");
+
+    if (csv != NULL)
+    {
+        fclose(csv);
+    }
+    return ((framesLost > 0) || (crcErrors > 0) || (samplesLost > 0)) ? 1 : 0;
+}
@@ -0,0 +1,75 @@
+/**
+ * @file dsp_intrinsics_emu.h
+ *
+ * @brief   C emulation of the CMSIS SIMD intrinsics used by dsp_stats.c, for building its
+ *          Cortex-M4 path on the host (test_dsp_stats.c).
+ *
+ * @details Follows the ARMv7-M Architecture Reference Manual: SMLAD A7.7.135, SMLALD
+ *          A7.7.137, SSUB16 A7.7.158, SEL A7.7.117. SSUB16 sets the APSR.GE flags of each
+ *          halfword lane (both bits when the difference is >= 0), SEL picks each byte from
+ *          the first operand where its GE bit is set. The GE flags are one variable, so
+ *          the emulation is for one thread.
+ *
+ * @author agent
+ * @license MIT
+ *
+ * Copyright agent, 2026
+ */
+
+#ifndef DSP_INTRINSICS_EMU_H_
+#define DSP_INTRINSICS_EMU_H_
+
+#include <stdint.h>
+
+static uint32_t dspEmuGe;   // APSR.GE[3:0]
+
+static inline int32_t dsp_emu_lo (uint32_t x)
+{
+    return (int16_t)(x & 0xFFFF);
+}
+
+static inline int32_t dsp_emu_hi (uint32_t x)
+{
+    return (int16_t)(x >> 16);
+}
+
+// Dual 16 bit multiply, both products added to a 32 bit accumulator, wraps on overflow
+static inline uint32_t __SMLAD (uint32_t x, uint32_t y, uint32_t sum)
+{
+    int64_t r = (int64_t)(int32_t)sum + (int64_t)dsp_emu_lo(x) * dsp_emu_lo(y) + (int64_t)dsp_emu_hi(x) * dsp_emu_hi(y);
+
+    return (uint32_t)r;
+}
+
+// Dual 16 bit multiply, both products added to a 64 bit accumulator
+static inline uint64_t __SMLALD (uint32_t x, uint32_t y, uint64_t sum)
+{
+    return sum + (uint64_t)((int64_t)dsp_emu_lo(x) * dsp_emu_lo(y)) + (uint64_t)((int64_t)dsp_emu_hi(x) * dsp_emu_hi(y));
+}
+
+// Dual 16 bit signed subtract, sets GE per lane
+static inline uint32_t __SSUB16 (uint32_t x, uint32_t y)
+{
+    int32_t lo = dsp_emu_lo(x) - dsp_emu_lo(y);
+    int32_t hi = dsp_emu_hi(x) - dsp_emu_hi(y);
+
+    dspEmuGe = ((lo >= 0) ? 0x3 : 0) | ((hi >= 0) ? 0xC : 0);
+    return ((uint32_t)hi << 16) | ((uint32_t)lo & 0xFFFF);
+}
+
+// Bytes of x where GE is set, of y elsewhere
+static inline uint32_t __SEL (uint32_t x, uint32_t y)
+{
+    uint32_t r = 0;
+    uint32_t i;
+
+    for (i = 0; i < 4; i++)
+    {
+        uint32_t mask = 0xFFUL << (8 * i);
+
+        r |= ((dspEmuGe >> i) & 1) ? (x & mask) : (y & mask);
+    }
+    return r;
+}
+
+#endif // DSP_INTRINSICS_EMU_H_
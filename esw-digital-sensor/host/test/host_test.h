@@ -0,0 +1,57 @@
+/**
+ * @file host_test.h
+ *
+ * @brief   Checks of the host tests, see 'make -C host test'.
+ *
+ * @details A failed check prints the file, line and message and is counted,
+ *          host_test_end() prints the totals and gives the exit status of the test.
+ *
+ * @author agent
+ * @license MIT
+ *
+ * Copyright agent, 2026
+ */
+
+#ifndef HOST_TEST_H_
+#define HOST_TEST_H_
+
+#include <stdio.h>
+#include <stdarg.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#define HOST_TEST_MAX_PRINTED   20  // Failures printed, the rest are only counted
+
+#define HOST_TEST_CHECK(cond, ...) host_test_check((cond), __FILE__, __LINE__, __VA_ARGS__)
+
+static uint32_t hostTestChecks;
+static uint32_t hostTestFailures;
+
+static inline bool host_test_check (bool ok, const char * file, int line, const char * fmt, ...)
+{
+    va_list args;
+
+    hostTestChecks++;
+    if (ok)
+    {
+        return true;
+    }
+    if (hostTestFailures < HOST_TEST_MAX_PRINTED)
+    {
+        fprintf(stderr, "%s:%d: ", file, line);
+        va_start(args, fmt);
+        vfprintf(stderr, fmt, args);
+        va_end(args);
+        fputc('\n', stderr);
+    }
+    hostTestFailures++;
+    return false;
+}
+
+static inline int host_test_end (const char * name)
+{
+    printf("%s: %u checks, %u failed\n", name, hostTestChecks, hostTestFailures);
+    return (hostTestFailures > 0) ? 1 : 0;
+}
+
+#endif // HOST_TEST_H_
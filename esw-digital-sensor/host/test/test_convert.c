@@ -0,0 +1,160 @@
+/**
+ * @file test_convert.c
+ *
+ * @brief   Exhaustive test of the MMA8653FC sample conversions (mma8653fc_driver.c).
+ *
+ * @details All 1024 10-bit codes, left-justified as read from OUT_X_MSB/LSB, with the
+ *          unused low 6 bits clear and set, in the 2g, 4g and 8g ranges. Counts, Q15 and
+ *          g must equal the exact values, mg the exact value rounded half up. The block
+ *          conversions must give the same results as the scalar ones and must not write
+ *          past n. The fast read mode conversions are checked over all 256 codes.
+ *
+ * @author agent
+ * @license MIT
+ *
+ * Copyright agent, 2026
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <math.h>
+
+#include "mma8653fc_driver.h"
+#include "mma8653fc_reg.h"
+
+#include "host_test.h"
+
+#define TEST_CODES              1024    // 10-bit samples
+#define TEST_CODES8             256     // Fast read mode samples
+#define TEST_GUARD              4       // Elements after n that the block conversions must leave alone
+#define TEST_GUARD_VALUE        0x5A5A
+
+static const uint8_t ranges[] = { MMA8653FC_XYZ_DATA_CFG_2G_RANGE,
+                                  MMA8653FC_XYZ_DATA_CFG_4G_RANGE,
+                                  MMA8653FC_XYZ_DATA_CFG_8G_RANGE };
+static const uint16_t lowBits[] = { 0x00, 0x3F };
+
+static uint16_t raw[TEST_CODES];
+static int16_t out[TEST_CODES + TEST_GUARD];
+
+static int32_t code_to_count (uint32_t code)
+{
+    return (code >= TEST_CODES / 2) ? (int32_t)code - TEST_CODES : (int32_t)code;
+}
+
+static void clear_out (void)
+{
+    uint32_t i;
+
+    for (i = 0; i < TEST_CODES + TEST_GUARD; i++)
+    {
+        out[i] = (int16_t)TEST_GUARD_VALUE;
+    }
+}
+
+static void check_guard (const char * name)
+{
+    uint32_t i;
+
+    for (i = TEST_CODES; i < TEST_CODES + TEST_GUARD; i++)
+    {
+        HOST_TEST_CHECK(out[i] == (int16_t)TEST_GUARD_VALUE, "%s wrote past n at %u", name, i);
+    }
+}
+
+static void check_counts (uint16_t low)
+{
+    uint32_t c;
+    int32_t count;
+
+    for (c = 0; c < TEST_CODES; c++)
+    {
+        raw[c] = (uint16_t)((c << 6) | low);
+    }
+
+    clear_out();
+    convert_block_to_count(raw, out, TEST_CODES);
+    check_guard("count block");
+    for (c = 0; c < TEST_CODES; c++)
+    {
+        count = code_to_count(c);
+        HOST_TEST_CHECK(convert_to_count(raw[c]) == count, "count of 0x%04X: %d, expected %d",
+                        raw[c], convert_to_count(raw[c]), count);
+        HOST_TEST_CHECK(out[c] == count, "count block of 0x%04X: %d, expected %d", raw[c], out[c], count);
+    }
+
+    clear_out();
+    convert_block_to_q15(raw, out, TEST_CODES);
+    check_guard("q15 block");
+    for (c = 0; c < TEST_CODES; c++)
+    {
+        // Full scale of every range is 1.0 in Q15, 64 steps per count
+        count = code_to_count(c) * 64;
+        HOST_TEST_CHECK(out[c] == count, "q15 of 0x%04X: %d, expected %d", raw[c], out[c], count);
+    }
+}
+
+static void check_range (uint8_t range, uint16_t low)
+{
+    uint32_t c;
+    double fullScale = (double)(2 << range);
+    double g, mg;
+    int32_t expected;
+    float result;
+
+    clear_out();
+    convert_block_to_mg(raw, out, TEST_CODES, range);
+    check_guard("mg block");
+    for (c = 0; c < TEST_CODES; c++)
+    {
+        // 512 counts per full scale, exact in float for every code
+        g = code_to_count(c) * fullScale / (TEST_CODES / 2);
+        result = convert_to_g(raw[c], range);
+        HOST_TEST_CHECK((double)result == g, "g of 0x%04X (range %u, low 0x%02X): %.9f, expected %.9f",
+                        raw[c], range, low, result, g);
+
+        mg = g * 1000.0;
+        expected = (int32_t)floor(mg + 0.5);
+        HOST_TEST_CHECK(out[c] == expected, "mg of 0x%04X (range %u, low 0x%02X): %d, expected %d (%.4f)",
+                        raw[c], range, low, out[c], expected, mg);
+    }
+}
+
+static void check_fast_read (void)
+{
+    uint32_t c, r;
+    int8_t code;
+    double g;
+    float result;
+
+    for (c = 0; c < TEST_CODES8; c++)
+    {
+        code = (int8_t)c;
+        // Same scale as the 10-bit count, the lowest 2 bits are zero
+        HOST_TEST_CHECK(convert8_to_count(code) == code * 4, "count of 8-bit %d: %d",
+                        code, convert8_to_count(code));
+        for (r = 0; r < sizeof(ranges) / sizeof(ranges[0]); r++)
+        {
+            g = code * (double)(2 << ranges[r]) / (TEST_CODES8 / 2);
+            result = convert8_to_g(code, ranges[r]);
+            HOST_TEST_CHECK((double)result == g, "g of 8-bit %d (range %u): %.9f, expected %.9f",
+                            code, ranges[r], result, g);
+        }
+    }
+}
+
+int main (void)
+{
+    uint32_t l, r;
+
+    for (l = 0; l < sizeof(lowBits) / sizeof(lowBits[0]); l++)
+    {
+        check_counts(lowBits[l]);
+        for (r = 0; r < sizeof(ranges) / sizeof(ranges[0]); r++)
+        {
+            check_range(ranges[r], lowBits[l]);
+        }
+    }
+    check_fast_read();
+    return host_test_end("convert");
+}
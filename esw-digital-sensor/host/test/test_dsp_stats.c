@@ -0,0 +1,161 @@
+/**
+ * @file test_dsp_stats.c
+ *
+ * @brief   Test that the Cortex-M4 SIMD path of dsp_stats.c gives the same results as the
+ *          portable C path, bit for bit.
+ *
+ * @details The SIMD path is built on the host with the intrinsics emulated
+ *          (dsp_intrinsics_emu.h) as dsp_stats_block_simd(), see the Makefile. Both paths
+ *          run over the same blocks: 0 to 2049 samples at even and odd (unaligned) start
+ *          addresses, random values over the int16 range, only extremes, constant blocks,
+ *          the minimum or maximum in the last (odd) sample and the longest blocks of
+ *          SIGNAL_STATS_MAX_N samples at full scale. The C path is also checked against
+ *          a plain reference calculation.
+ *
+ * @author agent
+ * @license MIT
+ *
+ * Copyright agent, 2026
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "dsp_stats.h"
+
+#include "host_test.h"
+
+#define TEST_MAX_LENGTH         2049
+#define TEST_RANDOM_BLOCKS      20
+
+void dsp_stats_block_simd(const int16_t buf[], uint32_t n, dsp_stats_t * out);
+void dsp_stats_xyz_simd(const int16_t x[], const int16_t y[], const int16_t z[], uint32_t n, dsp_stats_t out[3]);
+
+typedef enum
+{
+    FILL_RANDOM = 0,
+    FILL_EXTREMES,          // Only -32768 and 32767
+    FILL_CONSTANT,
+    FILL_LAST_MIN,          // Small values, -32768 in the last sample
+    FILL_LAST_MAX,          // Small values, 32767 in the last sample
+    FILL_COUNT
+} fill_t;
+
+static const char * const fillNames[FILL_COUNT] = { "random", "extremes", "constant", "last min", "last max" };
+
+static int16_t storage[SIGNAL_STATS_MAX_N + 1];
+static uint32_t randState = 1;
+
+static uint32_t test_rand (void)
+{
+    // xorshift32
+    randState ^= randState << 13;
+    randState ^= randState >> 17;
+    randState ^= randState << 5;
+    return randState;
+}
+
+static void fill (int16_t buf[], uint32_t n, fill_t how)
+{
+    int16_t c = (int16_t)test_rand();
+    uint32_t i;
+
+    for (i = 0; i < n; i++)
+    {
+        switch (how)
+        {
+            case FILL_RANDOM:   buf[i] = (int16_t)test_rand(); break;
+            case FILL_EXTREMES: buf[i] = (test_rand() & 1) ? INT16_MAX : INT16_MIN; break;
+            case FILL_CONSTANT: buf[i] = c; break;
+            default:            buf[i] = (int16_t)(test_rand() % 1024) - 512; break;
+        }
+    }
+    if ((n > 0) && (how == FILL_LAST_MIN))
+    {
+        buf[n - 1] = INT16_MIN;
+    }
+    if ((n > 0) && (how == FILL_LAST_MAX))
+    {
+        buf[n - 1] = INT16_MAX;
+    }
+}
+
+static bool same (const dsp_stats_t * a, const dsp_stats_t * b)
+{
+    return (a->acc.n == b->acc.n) && (a->acc.sum == b->acc.sum) && (a->acc.sumSq == b->acc.sumSq) &&
+           (a->min == b->min) && (a->max == b->max);
+}
+
+static void check_block (const int16_t buf[], uint32_t n, const char * what, uint32_t offset)
+{
+    dsp_stats_t c, simd;
+    int64_t sum = 0, sumSq = 0;
+    int16_t min = 0, max = 0;
+    uint32_t i;
+
+    for (i = 0; i < n; i++)
+    {
+        sum += buf[i];
+        sumSq += (int64_t)buf[i] * buf[i];
+        min = ((i == 0) || (buf[i] < min)) ? buf[i] : min;
+        max = ((i == 0) || (buf[i] > max)) ? buf[i] : max;
+    }
+
+    memset(&c, 0x55, sizeof(c));
+    memset(&simd, 0xAA, sizeof(simd));
+    dsp_stats_block(buf, n, &c);
+    dsp_stats_block_simd(buf, n, &simd);
+
+    HOST_TEST_CHECK((c.acc.n == n) && (c.acc.sum == sum) && (c.acc.sumSq == sumSq) && (c.min == min) &&
+                    (c.max == max), "%s n %u offset %u: C path sum %d sumSq %lld min %d max %d, reference %lld %lld %d %d",
+                    what, n, offset, c.acc.sum, (long long)c.acc.sumSq, c.min, c.max, (long long)sum,
+                    (long long)sumSq, min, max);
+    HOST_TEST_CHECK(same(&c, &simd), "%s n %u offset %u: SIMD sum %d sumSq %lld min %d max %d, C %d %lld %d %d",
+                    what, n, offset, simd.acc.sum, (long long)simd.acc.sumSq, simd.min, simd.max, c.acc.sum,
+                    (long long)c.acc.sumSq, c.min, c.max);
+}
+
+int main (void)
+{
+    dsp_stats_t c[3], simd[3];
+    uint32_t n, offset, f, r;
+
+    for (n = 0; n <= TEST_MAX_LENGTH; n++)
+    {
+        for (offset = 0; offset < 2; offset++)
+        {
+            for (f = 0; f < FILL_COUNT; f++)
+            {
+                for (r = 0; r < ((f == FILL_RANDOM) && (n < 64) ? TEST_RANDOM_BLOCKS : 1); r++)
+                {
+                    fill(&storage[offset], n, (fill_t)f);
+                    check_block(&storage[offset], n, fillNames[f], offset);
+                }
+            }
+        }
+    }
+
+    // Longest blocks, sums at the limits of their types
+    for (offset = 0; offset < 2; offset++)
+    {
+        for (f = 0; f < FILL_COUNT; f++)
+        {
+            fill(&storage[offset], SIGNAL_STATS_MAX_N - offset, (fill_t)f);
+            check_block(&storage[offset], SIGNAL_STATS_MAX_N - offset, fillNames[f], offset);
+        }
+        for (n = 0; n < SIGNAL_STATS_MAX_N; n++)
+        {
+            storage[offset + n] = INT16_MIN;
+        }
+        check_block(&storage[offset], SIGNAL_STATS_MAX_N - offset, "all min", offset);
+    }
+
+    // Three axes
+    fill(storage, 3 * 257, FILL_RANDOM);
+    dsp_stats_xyz(&storage[0], &storage[257], &storage[514], 257, c);
+    dsp_stats_xyz_simd(&storage[0], &storage[257], &storage[514], 257, simd);
+    HOST_TEST_CHECK(same(&c[0], &simd[0]) && same(&c[1], &simd[1]) && same(&c[2], &simd[2]), "xyz results differ");
+
+    return host_test_end("dsp_stats");
+}
@@ -0,0 +1,234 @@
+/**
+ * @file test_fft.c
+ *
+ * @brief   Test of fft_analyze() (fft.c) against a direct DFT in double.
+ *
+ * @details fft.c is built with tables for FFT_LENGTH 8, 32 and 256, as
+ *          fft_analyze_8() and so on, see the Makefile. Every build analyzes every
+ *          valid length up to its FFT_LENGTH, so the shorter lengths also run on the
+ *          strided tables of a longer FFT_LENGTH. The signals are a tone in each bin,
+ *          an impulse, a constant, full scale at Nyquist, uniform noise over the int16
+ *          range and sensor-like counts (a tone between bins and noise on an offset).
+ *          The reference removes the mean, applies the periodic Hann window and sums
+ *          |X[k]|^2 per band. Band energies and the dominant power must be within a
+ *          small fraction of the total energy, the dominant bin must have the highest
+ *          reference power (within the same tolerance) and be the tone bin for tones.
+ *
+ * @author agent
+ * @license MIT
+ *
+ * Copyright agent, 2026
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <math.h>
+
+#include "fft.h"
+
+#include "host_test.h"
+
+#define TEST_MAX_LENGTH         256
+#define TEST_REL_TOL            1e-5    // Of the total energy, float FFT against double DFT
+#define TEST_ABS_TOL            1e-3
+#define TEST_RATE_MHZ           100000  // Sample rate of the bin frequency checks
+#define PI                      3.14159265358979323846
+
+#define FFT_TEST_FUNCTIONS(l)                                                           \
+    bool fft_length_valid_##l(uint32_t n);                                              \
+    void fft_analyze_##l(const int16_t in[], uint32_t n, float work[], fft_result_t * res); \
+    uint32_t fft_bin_to_mhz_##l(uint16_t bin, uint32_t n, uint32_t sampleRateMhz);
+
+FFT_TEST_FUNCTIONS(8)
+FFT_TEST_FUNCTIONS(32)
+FFT_TEST_FUNCTIONS(256)
+
+typedef struct
+{
+    uint32_t tableLength;
+    bool (*valid)(uint32_t n);
+    void (*analyze)(const int16_t in[], uint32_t n, float work[], fft_result_t * res);
+    uint32_t (*to_mhz)(uint16_t bin, uint32_t n, uint32_t sampleRateMhz);
+} fft_build_t;
+
+static const fft_build_t builds[] = {
+    { 8, fft_length_valid_8, fft_analyze_8, fft_bin_to_mhz_8 },
+    { 32, fft_length_valid_32, fft_analyze_32, fft_bin_to_mhz_32 },
+    { 256, fft_length_valid_256, fft_analyze_256, fft_bin_to_mhz_256 },
+};
+
+typedef enum
+{
+    SIGNAL_TONE = 0,        // Cosine in bin toneBin
+    SIGNAL_IMPULSE,
+    SIGNAL_CONSTANT,
+    SIGNAL_NYQUIST,         // Alternating -32768 and 32767
+    SIGNAL_NOISE,           // Uniform over int16
+    SIGNAL_SENSOR,          // Tone of 300 counts between bins and noise of 20 on an offset of 16000
+    SIGNAL_COUNT
+} signal_t;
+
+static const char * const signalNames[SIGNAL_COUNT] = { "tone", "impulse", "constant", "nyquist", "noise", "sensor" };
+
+static int16_t samples[TEST_MAX_LENGTH];
+static float work[TEST_MAX_LENGTH];
+static double refPower[TEST_MAX_LENGTH / 2 + 1];
+static uint32_t randState = 1;
+
+static uint32_t test_rand (void)
+{
+    // xorshift32
+    randState ^= randState << 13;
+    randState ^= randState >> 17;
+    randState ^= randState << 5;
+    return randState;
+}
+
+static void fill (signal_t signal, uint32_t n, uint32_t toneBin)
+{
+    uint32_t i;
+
+    for (i = 0; i < n; i++)
+    {
+        switch (signal)
+        {
+            case SIGNAL_TONE:
+                samples[i] = (int16_t)lround(1000.0 + 8000.0 * cos(2 * PI * toneBin * i / n + 0.3));
+                break;
+            case SIGNAL_IMPULSE:
+                samples[i] = (i == n / 3) ? 20000 : 0;
+                break;
+            case SIGNAL_CONSTANT:
+                samples[i] = -1234;
+                break;
+            case SIGNAL_NYQUIST:
+                samples[i] = (i & 1) ? 32767 : -32768;
+                break;
+            case SIGNAL_NOISE:
+                samples[i] = (int16_t)(test_rand() >> 16);
+                break;
+            default:
+                samples[i] = (int16_t)lround(16000.0 + 300.0 * sin(2 * PI * 2.37 * i / n) +
+                                             (double)(test_rand() % 41) - 20.0);
+                break;
+        }
+    }
+}
+
+// Power of bins 1 ... n/2 of the mean removed, Hann windowed samples, returns the total
+static double reference (uint32_t n)
+{
+    double mean = 0.0, total = 0.0;
+    double xr, xi, v;
+    uint32_t i, k;
+
+    for (i = 0; i < n; i++)
+    {
+        mean += samples[i];
+    }
+    mean /= n;
+
+    for (k = 1; k <= n / 2; k++)
+    {
+        xr = 0.0;
+        xi = 0.0;
+        for (i = 0; i < n; i++)
+        {
+            v = (samples[i] - mean) * 0.5 * (1 - cos(2 * PI * i / n));
+            xr += v * cos(2 * PI * (double)((k * i) % n) / n);
+            xi -= v * sin(2 * PI * (double)((k * i) % n) / n);
+        }
+        refPower[k] = xr * xr + xi * xi;
+        total += refPower[k];
+    }
+    return total;
+}
+
+static void check_signal (const fft_build_t * build, signal_t signal, uint32_t n, uint32_t toneBin)
+{
+    fft_result_t res;
+    double total, tol, band, max = 0.0;
+    uint32_t binsPerBand = (n / 2) / FFT_BANDS;
+    uint32_t b, k;
+
+    fill(signal, n, toneBin);
+    total = reference(n);
+    tol = TEST_REL_TOL * total + TEST_ABS_TOL;
+    build->analyze(samples, n, work, &res);
+
+    for (b = 0; b < FFT_BANDS; b++)
+    {
+        band = 0.0;
+        for (k = b * binsPerBand + 1; k <= (b + 1) * binsPerBand; k++)
+        {
+            band += refPower[k];
+        }
+        HOST_TEST_CHECK(fabs(res.bandEnergy[b] - band) <= tol,
+                        "FFT_LENGTH %u, n %u, %s %u: band %u energy %.6g, expected %.6g",
+                        build->tableLength, n, signalNames[signal], toneBin, b, res.bandEnergy[b], band);
+    }
+
+    for (k = 1; k <= n / 2; k++)
+    {
+        max = (refPower[k] > max) ? refPower[k] : max;
+    }
+    if (!HOST_TEST_CHECK((res.dominantBin >= 1) && (res.dominantBin <= n / 2),
+                         "FFT_LENGTH %u, n %u, %s %u: dominant bin %u out of range",
+                         build->tableLength, n, signalNames[signal], toneBin, res.dominantBin))
+    {
+        return;
+    }
+    HOST_TEST_CHECK(refPower[res.dominantBin] >= max - tol,
+                    "FFT_LENGTH %u, n %u, %s %u: dominant bin %u has power %.6g, highest is %.6g",
+                    build->tableLength, n, signalNames[signal], toneBin, res.dominantBin,
+                    refPower[res.dominantBin], max);
+    HOST_TEST_CHECK(fabs(res.dominantPower - refPower[res.dominantBin]) <= tol,
+                    "FFT_LENGTH %u, n %u, %s %u: dominant power %.6g, expected %.6g",
+                    build->tableLength, n, signalNames[signal], toneBin, res.dominantPower,
+                    refPower[res.dominantBin]);
+    if (signal == SIGNAL_TONE)
+    {
+        HOST_TEST_CHECK(res.dominantBin == toneBin, "FFT_LENGTH %u, n %u: dominant bin %u of a tone in bin %u",
+                        build->tableLength, n, res.dominantBin, toneBin);
+    }
+}
+
+static void check_build (const fft_build_t * build)
+{
+    uint32_t n, s, k;
+
+    // Powers of two from 2 * FFT_BANDS to FFT_LENGTH
+    for (n = 0; n <= 2 * TEST_MAX_LENGTH; n++)
+    {
+        bool expected = (n >= 2 * FFT_BANDS) && (n <= build->tableLength) && ((n & (n - 1)) == 0);
+
+        HOST_TEST_CHECK(build->valid(n) == expected, "FFT_LENGTH %u: length %u valid %d",
+                        build->tableLength, n, build->valid(n));
+    }
+
+    for (n = 2 * FFT_BANDS; n <= build->tableLength; n *= 2)
+    {
+        HOST_TEST_CHECK(build->to_mhz(n / 2, n, TEST_RATE_MHZ) == TEST_RATE_MHZ / 2,
+                        "FFT_LENGTH %u, n %u: Nyquist bin at %u mHz", build->tableLength, n,
+                        build->to_mhz(n / 2, n, TEST_RATE_MHZ));
+        for (k = 1; k <= n / 2; k++)
+        {
+            check_signal(build, SIGNAL_TONE, n, k);
+        }
+        for (s = SIGNAL_IMPULSE; s < SIGNAL_COUNT; s++)
+        {
+            check_signal(build, (signal_t)s, n, 0);
+        }
+    }
+}
+
+int main (void)
+{
+    uint32_t b;
+
+    for (b = 0; b < sizeof(builds) / sizeof(builds[0]); b++)
+    {
+        check_build(&builds[b]);
+    }
+    return host_test_end("fft");
+}
@@ -0,0 +1,241 @@
+/**
+ * @file test_i2c_handler.c
+ *
+ * @brief   Test of the interrupt driven I2C transfers (i2c_handler.c) on the simulated bus
+ *          (host_i2c.c) and sensor.
+ *
+ * @details - A blocking transaction sleeps while the bytes move on the bus: the calling
+ *            thread uses a small part of the transfer time on the CPU and is switched out
+ *            only a few times.
+ *          - A blocking transaction on a bus owned by an asynchronous transfer or claimed
+ *            by another driver sleeps until the bus is freed instead of checking for it
+ *            every tick.
+ *          - Every transaction returns its own result, also when an asynchronous transfer
+ *            with a different result finishes right before or after it.
+ *
+ * @author agent
+ * @license MIT
+ *
+ * Copyright agent, 2026
+ */
+
+#define _GNU_SOURCE
+
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+#include <pthread.h>
+#include <sys/resource.h>
+
+#include "cmsis_os2.h"
+#include "host_sim.h"
+#include "i2c_handler.h"
+#include "mma8653fc_reg.h"
+
+#include "host_test.h"
+
+#define TEST_LONG_READ          200     // Bytes, about 18 ms on the 100 kHz bus
+#define TEST_CPU_MAX_PERCENT    10      // Of the transfer time, calling thread on the CPU
+#define TEST_SWITCHES_MAX       8       // Voluntary context switches of the calling thread
+#define TEST_CLAIM_MS           50      // Bus held by the claiming driver
+#define TEST_BAD_ADDRESS        0x50    // Nothing answers
+
+typedef struct
+{
+    uint64_t wallNs;
+    uint64_t cpuNs;
+    long switches;
+} usage_t;
+
+typedef struct
+{
+    uint8_t addr;
+    I2C_TransferReturn_TypeDef ret;
+    usage_t used;
+} transaction_t;
+
+static uint8_t rxBuf[TEST_LONG_READ];
+static volatile I2C_TransferReturn_TypeDef asyncRet;
+static volatile bool asyncDone;
+
+static uint64_t clock_ns (clockid_t clock)
+{
+    struct timespec ts;
+
+    clock_gettime(clock, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+static long thread_switches (void)
+{
+    struct rusage ru;
+
+    getrusage(RUSAGE_THREAD, &ru);
+    return ru.ru_nvcsw;
+}
+
+static void usage_begin (usage_t * u)
+{
+    u->wallNs = clock_ns(CLOCK_MONOTONIC);
+    u->cpuNs = clock_ns(CLOCK_THREAD_CPUTIME_ID);
+    u->switches = thread_switches();
+}
+
+static void usage_end (usage_t * u)
+{
+    u->wallNs = clock_ns(CLOCK_MONOTONIC) - u->wallNs;
+    u->cpuNs = clock_ns(CLOCK_THREAD_CPUTIME_ID) - u->cpuNs;
+    u->switches = thread_switches() - u->switches;
+}
+
+// Registry read, tx holds the registry address
+static void read_seq (I2C_TransferSeq_TypeDef * seq, uint8_t addr, uint8_t * tx, uint8_t * buf, uint16_t len)
+{
+    tx[0] = MMA8653FC_REGADDR_WHO_AM_I;
+    seq->addr = addr;
+    seq->flags = I2C_FLAG_WRITE_READ;
+    seq->buf[0].data = tx;
+    seq->buf[0].len = 1;
+    seq->buf[1].data = buf;
+    seq->buf[1].len = len;
+}
+
+static void * transaction_thread (void * arg)
+{
+    transaction_t * t = arg;
+    I2C_TransferSeq_TypeDef seq;
+    uint8_t tx[1];
+
+    read_seq(&seq, t->addr, tx, rxBuf, TEST_LONG_READ);
+    usage_begin(&t->used);
+    t->ret = i2c_transaction(&seq);
+    usage_end(&t->used);
+    return NULL;
+}
+
+static void async_done (I2C_TransferSeq_TypeDef * seq, I2C_TransferReturn_TypeDef ret, void * ctx)
+{
+    (void)seq;
+    (void)ctx;
+    asyncRet = ret;
+    asyncDone = true;
+}
+
+static void claim_irq (void)
+{
+}
+
+static void wait_async (void)
+{
+    while (!asyncDone)
+    {
+        osDelay(1);
+    }
+}
+
+// The calling thread sleeps during the transfer
+static void test_blocking_sleeps (void)
+{
+    transaction_t t = { .addr = MMA8653FC_SLAVE_ADDRESS_READ };
+
+    transaction_thread(&t);
+    HOST_TEST_CHECK(t.ret == i2cTransferDone, "long read result %d", t.ret);
+    HOST_TEST_CHECK(rxBuf[0] == 0x5A, "WHO_AM_I %02X", rxBuf[0]);
+    HOST_TEST_CHECK(t.used.cpuNs * 100 < t.used.wallNs * TEST_CPU_MAX_PERCENT,
+                    "caller on the CPU %llu of %llu us of the transfer",
+                    (unsigned long long)t.used.cpuNs / 1000, (unsigned long long)t.used.wallNs / 1000);
+    HOST_TEST_CHECK(t.used.switches <= TEST_SWITCHES_MAX, "caller switched out %ld times", t.used.switches);
+    printf("i2c: %u byte read %llu us, caller on the CPU %llu us, switched out %ld times\n", TEST_LONG_READ,
+           (unsigned long long)t.used.wallNs / 1000, (unsigned long long)t.used.cpuNs / 1000, t.used.switches);
+}
+
+// A blocking transaction waits for a bus owned by an asynchronous transfer without polling
+static void test_busy_bus (void)
+{
+    static uint8_t asyncBuf[TEST_LONG_READ];
+    static uint8_t asyncTx[1];
+    I2C_TransferSeq_TypeDef asyncSeq;
+    transaction_t t = { .addr = MMA8653FC_SLAVE_ADDRESS_READ };
+
+    read_seq(&asyncSeq, MMA8653FC_SLAVE_ADDRESS_READ, asyncTx, asyncBuf, TEST_LONG_READ);
+    asyncDone = false;
+    HOST_TEST_CHECK(i2c_transaction_submit(&asyncSeq, async_done, NULL) == 0, "submit failed");
+    HOST_TEST_CHECK(i2c_transaction_submit(&asyncSeq, NULL, NULL) == -1, "submit on the busy bus accepted");
+    transaction_thread(&t);
+    HOST_TEST_CHECK(asyncDone, "blocking transaction done before the asynchronous one");
+    wait_async();
+
+    HOST_TEST_CHECK(t.ret == i2cTransferDone, "result after the busy bus %d", t.ret);
+    HOST_TEST_CHECK(t.used.switches <= TEST_SWITCHES_MAX, "waiting caller switched out %ld times in %llu us",
+                    t.used.switches, (unsigned long long)t.used.wallNs / 1000);
+    printf("i2c: busy bus %llu us, caller switched out %ld times\n",
+           (unsigned long long)t.used.wallNs / 1000, t.used.switches);
+}
+
+// A blocking transaction waits for a claimed bus without polling
+static void test_claimed_bus (void)
+{
+    transaction_t t = { .addr = MMA8653FC_SLAVE_ADDRESS_READ, .ret = i2cTransferInProgress };
+    I2C_TransferSeq_TypeDef seq;
+    uint8_t tx[1];
+    pthread_t thread;
+
+    HOST_TEST_CHECK(i2c_bus_claim(claim_irq) == 0, "claim of the free bus failed");
+    read_seq(&seq, MMA8653FC_SLAVE_ADDRESS_READ, tx, rxBuf, 1);
+    HOST_TEST_CHECK(i2c_transaction_submit(&seq, NULL, NULL) == -1, "submit on the claimed bus accepted");
+    pthread_create(&thread, NULL, transaction_thread, &t);
+    osDelay(TEST_CLAIM_MS);
+    HOST_TEST_CHECK(t.ret == i2cTransferInProgress, "transaction done on the claimed bus");
+    i2c_bus_release();
+    pthread_join(thread, NULL);
+
+    HOST_TEST_CHECK(t.ret == i2cTransferDone, "result after release %d", t.ret);
+    HOST_TEST_CHECK(t.used.wallNs >= TEST_CLAIM_MS * 1000000ULL, "waited only %llu us",
+                    (unsigned long long)t.used.wallNs / 1000);
+    HOST_TEST_CHECK(t.used.switches <= TEST_SWITCHES_MAX, "waiting caller switched out %ld times in %u ms",
+                    t.used.switches, TEST_CLAIM_MS);
+    printf("i2c: claimed bus %llu us, caller switched out %ld times\n",
+           (unsigned long long)t.used.wallNs / 1000, t.used.switches);
+}
+
+// Results of blocking and asynchronous transfers do not mix
+static void test_results (void)
+{
+    static uint8_t asyncBuf[TEST_LONG_READ];
+    static uint8_t asyncTx[1];
+    I2C_TransferSeq_TypeDef asyncSeq;
+    transaction_t t;
+    uint32_t i;
+
+    for (i = 0; i < 2; i++)
+    {
+        // Asynchronous transfer first, the blocking one waits for the bus and finishes after it
+        bool asyncNack = (i == 0);
+
+        read_seq(&asyncSeq, asyncNack ? TEST_BAD_ADDRESS : MMA8653FC_SLAVE_ADDRESS_READ, asyncTx, asyncBuf,
+                 TEST_LONG_READ);
+        asyncDone = false;
+        HOST_TEST_CHECK(i2c_transaction_submit(&asyncSeq, async_done, NULL) == 0, "submit failed");
+
+        t.addr = asyncNack ? MMA8653FC_SLAVE_ADDRESS_READ : TEST_BAD_ADDRESS;
+        transaction_thread(&t);
+        wait_async();
+
+        HOST_TEST_CHECK(asyncRet == (asyncNack ? i2cTransferNack : i2cTransferDone), "async result %d", asyncRet);
+        HOST_TEST_CHECK(t.ret == (asyncNack ? i2cTransferDone : i2cTransferNack), "blocking result %d", t.ret);
+    }
+}
+
+int main (void)
+{
+    sim_init();
+    i2c_init();
+    i2c_enable();
+
+    test_blocking_sleeps();
+    test_busy_bus();
+    test_claimed_bus();
+    test_results();
+    return host_test_end("i2c_handler");
+}
@@ -0,0 +1,161 @@
+/**
+ * @file test_mma_acq.c
+ *
+ * @brief   Test of the burst acquisition (mma_acq.c) from the data ready interrupt of the
+ *          emulated sensor, read with interrupt driven I2C transfers.
+ *
+ * @details INT1 stays asserted until the sample is read, a trigger that does not read the
+ *          sample stops the data ready edges.
+ *          - Full ring: the consumer takes nothing until the ring is full, bursts are still
+ *            read and counted as overruns. After draining the ring samples arrive again.
+ *          - Busy bus: while another driver holds the bus the trigger cannot start the
+ *            read. After the bus is released mma_acq_poll() reads the sample and samples
+ *            arrive again.
+ *
+ * @author agent
+ * @license MIT
+ *
+ * Copyright agent, 2026
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+
+#include "cmsis_os2.h"
+#include "host_sim.h"
+#include "i2c_handler.h"
+#include "gpio_handler.h"
+#include "mma8653fc_reg.h"
+#include "mma8653fc_driver.h"
+#include "mma_acq.h"
+#include "sample_time.h"
+#include "sample_window.h"
+
+#include "host_test.h"
+
+#define TEST_FLAG               0x01
+#define TEST_BATCH              4
+#define TEST_PERIOD_MS          10      // 100 Hz output data rate
+#define TEST_FULL_PERIODS       (MMA_ACQ_RING_SLOTS + 8)
+#define TEST_CLAIM_PERIODS      5
+#define TEST_WAIT_MS            500     // For TEST_BATCH samples after recovery
+
+// 100 Hz, +-2g, data ready interrupt on INT1 (active low, push-pull)
+static const mma_config_t testConfig = MMA8653FC_CONFIG(
+    MMA8653FC_CTRL_REG1_DR_100HZ, MMA8653FC_XYZ_DATA_CFG_2G_RANGE, MMA8653FC_CTRL_REG2_POWMOD_NORMAL,
+    MMA8653FC_CTRL_REG3_POLARITY_LOW, MMA8653FC_CTRL_REG3_PINMODE_PP,
+    MMA8653FC_CTRL_REG4_DRDY_INT_MASK, MMA8653FC_CTRL_REG5_DRDY_INTSEL_MASK);
+
+static uint32_t drain (void)
+{
+    xyz_rawdata_t data;
+    uint32_t n = 0;
+
+    while (mma_acq_get(&data))
+    {
+        n++;
+    }
+    return n;
+}
+
+// Samples taken like the acquisition thread does, until n or TEST_WAIT_MS
+static uint32_t wait_samples (uint32_t n)
+{
+    uint32_t start = osKernelGetTickCount();
+    uint32_t received = 0;
+
+    while ((received < n) && ((osKernelGetTickCount() - start) < TEST_WAIT_MS))
+    {
+        mma_acq_wait(TEST_PERIOD_MS);
+        received += drain();
+        mma_acq_poll();
+    }
+    return received;
+}
+
+static void claim_irq (void)
+{
+}
+
+// Bursts are read with the ring full, samples arrive again once it is drained
+static void test_full_ring (void)
+{
+    uint32_t transfers, overruns, n;
+
+    osDelay(TEST_FULL_PERIODS * TEST_PERIOD_MS);
+    overruns = mma_acq_overruns();
+    transfers = simStats.i2cTransfers;
+    HOST_TEST_CHECK(overruns > 0, "ring not full after %u periods", TEST_FULL_PERIODS);
+
+    osDelay(TEST_BATCH * TEST_PERIOD_MS);
+    HOST_TEST_CHECK(simStats.i2cTransfers > transfers, "no bursts read with the ring full");
+    HOST_TEST_CHECK(mma_acq_overruns() > overruns, "overruns %u did not grow with the ring full", overruns);
+
+    n = drain();
+    HOST_TEST_CHECK(n == MMA_ACQ_RING_SLOTS, "%u samples in the full ring", n);
+    n = wait_samples(TEST_BATCH);
+    HOST_TEST_CHECK(n >= TEST_BATCH, "%u samples after draining the full ring", n);
+    printf("mma_acq: full ring, %u overruns, %u samples after draining\n", mma_acq_overruns(), n);
+}
+
+// A trigger on the claimed bus is read by mma_acq_poll() after the bus is released
+static void test_busy_bus (void)
+{
+    uint32_t overruns, retriggers, n, tries;
+
+    drain();
+    overruns = mma_acq_overruns();
+    retriggers = mma_acq_retriggers();
+    // The bus is free between bursts
+    for (tries = 0; (i2c_bus_claim(claim_irq) != 0) && (tries < TEST_PERIOD_MS); tries++)
+    {
+        osDelay(1);
+    }
+    HOST_TEST_CHECK(tries < TEST_PERIOD_MS, "claim of the bus failed");
+    osDelay(TEST_CLAIM_PERIODS * TEST_PERIOD_MS);
+    i2c_bus_release();
+    HOST_TEST_CHECK(mma_acq_overruns() > overruns, "no trigger lost on the claimed bus");
+
+    n = wait_samples(TEST_BATCH);
+    HOST_TEST_CHECK(n >= TEST_BATCH, "%u samples after the bus was released", n);
+    HOST_TEST_CHECK(mma_acq_retriggers() > retriggers, "lost trigger not read again");
+    printf("mma_acq: busy bus, %u retriggers, %u samples after the release\n", mma_acq_retriggers(), n);
+}
+
+static void acq_thread (void * arg)
+{
+    (void)arg;
+
+    i2c_init();
+    i2c_enable();
+    sensor_reset();
+    mma_apply_config(&testConfig);
+    mma_acq_init(&mma_acq_i2c_channel, osThreadGetId(), TEST_FLAG, TEST_BATCH);
+    mma_acq_set_read_mode(mma_get_read_mode());
+    gpio_external_interrupt_init();
+    gpio_exti_register_callback(GPIO_EXTI_NUM, mma_acq_trigger);
+    gpio_exti_enable(GPIO_EXTI_NUM);
+    set_sensor_active();
+
+    test_full_ring();
+    test_busy_bus();
+    exit(host_test_end("mma_acq"));
+}
+
+int main (void)
+{
+    const osThreadAttr_t attr = { .name = "acquisition" };
+
+    sim_init();
+    sample_time_init();
+    gpio_exti_init();
+    // The sensor model reports samples by window, nothing is analyzed
+    sample_window_init(NULL, 0);
+
+    // Thread flags need kernel threads, the acquisition thread ends the test
+    osKernelInitialize();
+    osThreadNew(acq_thread, NULL, &attr);
+    osKernelStart();
+    return 1;
+}
@@ -0,0 +1,152 @@
+/**
+ * @file test_mma_config.c
+ *
+ * @brief   Test of the registry shadow writes (mma_commit_config()) to the emulated sensor.
+ *
+ * @details Only the ACTIVE bit of CTRL_REG1 can be changed while the sensor is active, the
+ *          model drops other changes and counts them in simStats.ignoredWrites.
+ *          - A change of a CTRL_REG1 field (data rate, auto-sleep rate) while active must put
+ *            the sensor to standby, reach the model registry and leave the sensor active.
+ *          - A change of the ACTIVE bit alone is one registry write.
+ *          - A read mode switch while active changes F_READ in the sensor, data is then read
+ *            with the burst length and resolution of the new mode.
+ *          - A failed write (no acknowledge from the sensor) is reported by the commit, the
+ *            registry stays dirty and the next commit writes it. A failed standby write
+ *            leaves the sensor as it was.
+ *
+ * @author agent
+ * @license MIT
+ *
+ * Copyright agent, 2026
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+
+#include "host_sim.h"
+#include "i2c_handler.h"
+#include "mma8653fc_reg.h"
+#include "mma8653fc_driver.h"
+#include "mma8653fc_sim.h"
+#include "sample_window.h"
+
+#include "host_test.h"
+
+// 100 Hz, +-2g, data ready interrupt on INT1 (active low, push-pull)
+static const mma_config_t testConfig = MMA8653FC_CONFIG(
+    MMA8653FC_CTRL_REG1_DR_100HZ, MMA8653FC_XYZ_DATA_CFG_2G_RANGE, MMA8653FC_CTRL_REG2_POWMOD_NORMAL,
+    MMA8653FC_CTRL_REG3_POLARITY_LOW, MMA8653FC_CTRL_REG3_PINMODE_PP,
+    MMA8653FC_CTRL_REG4_DRDY_INT_MASK, MMA8653FC_CTRL_REG5_DRDY_INTSEL_MASK);
+
+// CTRL_REG1 of the model against the shadow, the sensor must be active
+static void check_ctrl_reg1 (const char * change)
+{
+    uint8_t reg = mma_sim_register(MMA8653FC_REGADDR_CTRL_REG1);
+    uint8_t shadow = (uint8_t)mma_get_field(MMA8653FC_REGADDR_CTRL_REG1, 0xFF, 0);
+
+    HOST_TEST_CHECK(reg == shadow, "%s: CTRL_REG1 0x%02X in the sensor, 0x%02X wanted", change, reg, shadow);
+    HOST_TEST_CHECK(reg & MMA8653FC_CTRL_REG1_SAMODE_MASK, "%s: sensor left in standby", change);
+}
+
+// CTRL_REG1 fields other than ACTIVE changed while active
+static void test_ctrl_reg1_fields (void)
+{
+    uint32_t ignored = simStats.ignoredWrites;
+
+    configure_xyz_data(MMA8653FC_CTRL_REG1_DR_50HZ, MMA8653FC_XYZ_DATA_CFG_2G_RANGE, MMA8653FC_CTRL_REG2_POWMOD_NORMAL);
+    check_ctrl_reg1("data rate");
+    HOST_TEST_CHECK(mma_get_data_rate_mhz() == 50000, "data rate %u mHz", mma_get_data_rate_mhz());
+
+    mma_set_field(MMA8653FC_REGADDR_CTRL_REG1, MMA8653FC_CTRL_REG1_ASPL_DR_MASK, MMA8653FC_CTRL_REG1_ASPL_DR_SHIFT,
+                  MMA8653FC_CTRL_REG1_ASLP_DR_6Hz);
+    mma_commit_config();
+    check_ctrl_reg1("auto-sleep rate");
+
+    HOST_TEST_CHECK(simStats.ignoredWrites == ignored, "%u writes ignored by the active sensor",
+                    simStats.ignoredWrites - ignored);
+}
+
+// ACTIVE alone is written without a standby round trip
+static void test_active_only (void)
+{
+    uint32_t count = mma_get_transaction_count();
+
+    set_sensor_standby();
+    HOST_TEST_CHECK((mma_sim_register(MMA8653FC_REGADDR_CTRL_REG1) & MMA8653FC_CTRL_REG1_SAMODE_MASK) == 0,
+                    "sensor not in standby");
+    set_sensor_active();
+    check_ctrl_reg1("active");
+    HOST_TEST_CHECK(mma_get_transaction_count() - count == 2, "%u transactions for standby and active",
+                    mma_get_transaction_count() - count);
+}
+
+// Fast and back to normal read mode while active
+static void test_read_mode (void)
+{
+    uint32_t ignored = simStats.ignoredWrites;
+    xyz_rawdata_t data;
+
+    HOST_TEST_CHECK(mma_set_read_mode(MMA8653FC_CTRL_REG1_FAST_READ) == 0, "fast read mode refused");
+    check_ctrl_reg1("fast read");
+    HOST_TEST_CHECK(mma_sim_register(MMA8653FC_REGADDR_CTRL_REG1) & MMA8653FC_CTRL_REG1_READ_MOD_MASK,
+                    "F_READ not set in the sensor");
+    data = get_xyz_data();
+    HOST_TEST_CHECK(data.resolution == MMA8653FC_RESOLUTION_FAST, "%u bit data in fast read mode", data.resolution);
+
+    HOST_TEST_CHECK(mma_set_read_mode(MMA8653FC_CTRL_REG1_NORMAL_READ) == 0, "normal read mode refused");
+    check_ctrl_reg1("normal read");
+    HOST_TEST_CHECK((mma_sim_register(MMA8653FC_REGADDR_CTRL_REG1) & MMA8653FC_CTRL_REG1_READ_MOD_MASK) == 0,
+                    "F_READ left set in the sensor");
+    data = get_xyz_data();
+    HOST_TEST_CHECK(data.resolution == MMA8653FC_RESOLUTION_NORMAL, "%u bit data in normal read mode", data.resolution);
+
+    HOST_TEST_CHECK(simStats.ignoredWrites == ignored, "%u writes ignored by the active sensor",
+                    simStats.ignoredWrites - ignored);
+}
+
+// Transfers failed by the sensor model
+static void test_write_errors (void)
+{
+    uint8_t reg1 = mma_sim_register(MMA8653FC_REGADDR_CTRL_REG1);
+    uint8_t ths = 0x10;
+
+    // Standby write fails, nothing else is written
+    mma_sim_nack(0, 1);
+    HOST_TEST_CHECK(configure_xyz_data(MMA8653FC_CTRL_REG1_DR_100HZ, MMA8653FC_XYZ_DATA_CFG_2G_RANGE,
+                                       MMA8653FC_CTRL_REG2_POWMOD_NORMAL) == -1, "failed standby write not reported");
+    HOST_TEST_CHECK(mma_sim_register(MMA8653FC_REGADDR_CTRL_REG1) == reg1, "CTRL_REG1 0x%02X after a failed standby write",
+                    mma_sim_register(MMA8653FC_REGADDR_CTRL_REG1));
+    HOST_TEST_CHECK(mma_commit_config() == 0, "data rate retry failed");
+    check_ctrl_reg1("data rate retry");
+
+    // Registry write fails, the sensor is made active again
+    mma_set_field(MMA8653FC_REGADDR_FF_MT_THS, MMA8653FC_FF_MT_THS_THS_MASK, MMA8653FC_FF_MT_THS_THS_SHIFT, ths);
+    mma_sim_nack(1, 1);
+    HOST_TEST_CHECK(mma_commit_config() == -1, "failed registry write not reported");
+    check_ctrl_reg1("failed registry write");
+    HOST_TEST_CHECK(mma_sim_register(MMA8653FC_REGADDR_FF_MT_THS) != ths, "FF_MT_THS written by a failed transfer");
+    HOST_TEST_CHECK(mma_commit_config() == 0, "registry retry failed");
+    HOST_TEST_CHECK(mma_sim_register(MMA8653FC_REGADDR_FF_MT_THS) == ths, "FF_MT_THS 0x%02X after the retry",
+                    mma_sim_register(MMA8653FC_REGADDR_FF_MT_THS));
+    check_ctrl_reg1("registry retry");
+}
+
+int main (void)
+{
+    sim_init();
+    // The sensor model reports samples by window, nothing is analyzed
+    sample_window_init(NULL, 0);
+    i2c_init();
+    i2c_enable();
+
+    sensor_reset();
+    mma_apply_config(&testConfig);
+    set_sensor_active();
+    check_ctrl_reg1("start");
+
+    test_ctrl_reg1_fields();
+    test_active_only();
+    test_read_mode();
+    test_write_errors();
+    return host_test_end("mma_config");
+}
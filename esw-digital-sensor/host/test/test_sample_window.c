@@ -0,0 +1,88 @@
+/**
+ * @file test_sample_window.c
+ *
+ * @brief   Test of the missed window count of the window pool (sample_window.c).
+ *
+ * @details Runs in one thread without analysis: all windows are filled and not released,
+ *          so further samples are dropped. Every window length of dropped samples must
+ *          count as one missed window when it is dropped, with the length in effect
+ *          then, and a later length change must not change the count. Released windows
+ *          must take the length set when they are started.
+ *
+ * @author agent
+ * @license MIT
+ *
+ * Copyright agent, 2026
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+
+#include "sample_window.h"
+
+#include "host_test.h"
+
+static uint32_t put_samples (uint32_t n)
+{
+    uint32_t i, accepted = 0;
+
+    for (i = 0; i < n; i++)
+    {
+        accepted += sample_window_put((int16_t)i, (int16_t)-i, 1, 10) ? 1 : 0;
+    }
+    return accepted;
+}
+
+int main (void)
+{
+    sample_window_t * w;
+    uint32_t accepted;
+
+    sample_window_init(NULL, 0);
+    HOST_TEST_CHECK(sample_window_set_length(4) == -1, "length 4 accepted");
+    HOST_TEST_CHECK(sample_window_set_length(24) == -1, "length 24 accepted");
+    HOST_TEST_CHECK(sample_window_set_length(2 * SAMPLE_WINDOW_LENGTH) == -1, "length %u accepted",
+                    2 * SAMPLE_WINDOW_LENGTH);
+
+    // Fill all windows, nothing is dropped
+    accepted = put_samples(SAMPLE_WINDOW_DEPTH * SAMPLE_WINDOW_LENGTH);
+    HOST_TEST_CHECK(accepted == SAMPLE_WINDOW_DEPTH * SAMPLE_WINDOW_LENGTH, "%u samples accepted", accepted);
+    HOST_TEST_CHECK(sample_window_swaps() == SAMPLE_WINDOW_DEPTH, "%u swaps", sample_window_swaps());
+    HOST_TEST_CHECK(sample_window_missed() == 0, "%u missed after filling", sample_window_missed());
+
+    // Two and a half window lengths dropped
+    accepted = put_samples(2 * SAMPLE_WINDOW_LENGTH + SAMPLE_WINDOW_LENGTH / 2);
+    HOST_TEST_CHECK(accepted == 0, "%u samples accepted without a free window", accepted);
+    HOST_TEST_CHECK(sample_window_dropped() == 2 * SAMPLE_WINDOW_LENGTH + SAMPLE_WINDOW_LENGTH / 2,
+                    "%u dropped", sample_window_dropped());
+    HOST_TEST_CHECK(sample_window_missed() == 2, "%u missed, expected 2", sample_window_missed());
+
+    // A shorter length counts the windows dropped from now on, not the earlier ones
+    HOST_TEST_CHECK(sample_window_set_length(SAMPLE_WINDOW_MIN_LENGTH) == 0, "min length refused");
+    HOST_TEST_CHECK(sample_window_missed() == 2, "%u missed after the length change, expected 2",
+                    sample_window_missed());
+    put_samples(2 * SAMPLE_WINDOW_MIN_LENGTH);
+    HOST_TEST_CHECK(sample_window_missed() == 4, "%u missed at the min length, expected 4",
+                    sample_window_missed());
+
+    // And a longer length does not take the earlier ones back
+    HOST_TEST_CHECK(sample_window_set_length(SAMPLE_WINDOW_LENGTH) == 0, "max length refused");
+    HOST_TEST_CHECK(sample_window_missed() == 4, "%u missed after the length change, expected 4",
+                    sample_window_missed());
+
+    // A released window starts with the length set now
+    HOST_TEST_CHECK(sample_window_set_length(SAMPLE_WINDOW_MIN_LENGTH) == 0, "min length refused");
+    w = sample_window_wait(0);
+    if (HOST_TEST_CHECK(w != NULL, "no full window"))
+    {
+        HOST_TEST_CHECK(w->count == SAMPLE_WINDOW_LENGTH, "window of %u samples", w->count);
+        sample_window_release(w);
+    }
+    accepted = put_samples(SAMPLE_WINDOW_MIN_LENGTH);
+    HOST_TEST_CHECK(accepted == SAMPLE_WINDOW_MIN_LENGTH, "%u samples accepted after release", accepted);
+    HOST_TEST_CHECK(sample_window_swaps() == SAMPLE_WINDOW_DEPTH + 1, "%u swaps after release",
+                    sample_window_swaps());
+    HOST_TEST_CHECK(sample_window_missed() == 4, "%u missed after release, expected 4", sample_window_missed());
+
+    return host_test_end("sample_window");
+}
@@ -0,0 +1,164 @@
+/**
+ * @file test_signal_stats.c
+ *
+ * @brief   Test of the single-pass accumulators (signal_stats.c) against a two-pass
+ *          calculation in double.
+ *
+ * @details Signals of 1 to SIGNAL_STATS_MAX_N samples: constant, full scale, uniform
+ *          noise over the int16 range, sensor-like counts (sine and noise of a few hundred
+ *          counts) on offsets up to 32000. Mean, energy and variance of the Q16
+ *          accumulator must be within one Q16 step (plus the rounding of the double
+ *          reference) of the reference, those of the float Welford accumulator within a
+ *          relative error that grows with the window length.
+ *
+ * @author agent
+ * @license MIT
+ *
+ * Copyright agent, 2026
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <math.h>
+
+#include "signal_stats.h"
+
+#include "host_test.h"
+
+#define TEST_Q_ONE              (double)(1 << SIGNAL_STATS_Q)
+#define TEST_Q_REL_TOL          1e-12   // Rounding of the double reference at the largest sums
+#define TEST_F_REL_TOL          1e-6    // Float accumulator, per sqrt(sample)
+#define PI                      3.14159265358979323846
+
+typedef enum
+{
+    SIGNAL_CONSTANT = 0,
+    SIGNAL_FULL_SCALE,      // Alternating -32768 and 32767
+    SIGNAL_MIN,             // All -32768
+    SIGNAL_NOISE,           // Uniform over int16
+    SIGNAL_SENSOR,          // Sine of 300 counts and noise of 20 on the offset
+    SIGNAL_COUNT
+} signal_t;
+
+static const char * const signalNames[SIGNAL_COUNT] = { "constant", "full scale", "min", "noise", "sensor" };
+static const uint32_t lengths[] = { 1, 2, 3, 32, 256, 2048, 32768, SIGNAL_STATS_MAX_N };
+static const int16_t offsets[] = { 0, -512, 1000, 16384, 32000, -32000 };
+
+static int16_t samples[SIGNAL_STATS_MAX_N];
+static uint32_t randState = 1;
+
+static uint32_t test_rand (void)
+{
+    // xorshift32
+    randState ^= randState << 13;
+    randState ^= randState >> 17;
+    randState ^= randState << 5;
+    return randState;
+}
+
+static int16_t clamp16 (double v)
+{
+    return (int16_t)((v > 32767) ? 32767 : ((v < -32768) ? -32768 : lround(v)));
+}
+
+static void make_signal (signal_t sig, int16_t offset, uint32_t n)
+{
+    uint32_t i;
+
+    for (i = 0; i < n; i++)
+    {
+        switch (sig)
+        {
+            case SIGNAL_CONSTANT:   samples[i] = offset; break;
+            case SIGNAL_FULL_SCALE: samples[i] = (i & 1) ? 32767 : -32768; break;
+            case SIGNAL_MIN:        samples[i] = -32768; break;
+            case SIGNAL_NOISE:      samples[i] = (int16_t)(test_rand() & 0xFFFF); break;
+            default:
+                samples[i] = clamp16(offset + 300 * sin(2 * PI * i / 23.7) + (double)(test_rand() % 41) - 20);
+                break;
+        }
+    }
+}
+
+static bool near (double got, double ref, double absTol, double relTol)
+{
+    return fabs(got - ref) <= absTol + relTol * fabs(ref);
+}
+
+static void check_signal (signal_t sig, int16_t offset, uint32_t n)
+{
+    signal_stats_q_t q;
+    signal_stats_f_t f;
+    double mean = 0.0, energy = 0.0, variance;
+    double fTol = TEST_F_REL_TOL * sqrt((double)n);
+    uint32_t i;
+
+    make_signal(sig, offset, n);
+
+    // Two-pass reference
+    for (i = 0; i < n; i++)
+    {
+        mean += samples[i];
+    }
+    mean /= n;
+    for (i = 0; i < n; i++)
+    {
+        energy += (samples[i] - mean) * (samples[i] - mean);
+    }
+    variance = energy / n;
+
+    signal_stats_q_reset(&q);
+    signal_stats_f_reset(&f);
+    for (i = 0; i < n; i++)
+    {
+        signal_stats_q_add(&q, samples[i]);
+        signal_stats_f_add(&f, (float)samples[i]);
+    }
+
+    HOST_TEST_CHECK(near(signal_stats_q_mean(&q), mean * TEST_Q_ONE, 1.0, TEST_Q_REL_TOL),
+                    "%s offset %d n %u: q mean %.6f, reference %.6f", signalNames[sig], offset, n,
+                    signal_stats_q_mean(&q) / TEST_Q_ONE, mean);
+    HOST_TEST_CHECK(near((double)signal_stats_q_energy(&q), energy * TEST_Q_ONE, 1.0, TEST_Q_REL_TOL),
+                    "%s offset %d n %u: q energy %.6f, reference %.6f", signalNames[sig], offset, n,
+                    signal_stats_q_energy(&q) / TEST_Q_ONE, energy);
+    HOST_TEST_CHECK(near((double)signal_stats_q_variance(&q), variance * TEST_Q_ONE, 1.0, TEST_Q_REL_TOL),
+                    "%s offset %d n %u: q variance %.6f, reference %.6f", signalNames[sig], offset, n,
+                    signal_stats_q_variance(&q) / TEST_Q_ONE, variance);
+
+    // Float results relative to the spread of the signal, the mean also to its size
+    HOST_TEST_CHECK(near(signal_stats_f_mean(&f), mean, fTol * (sqrt(variance) + 1.0), fTol),
+                    "%s offset %d n %u: f mean %.6f, reference %.6f", signalNames[sig], offset, n,
+                    signal_stats_f_mean(&f), mean);
+    HOST_TEST_CHECK(near(signal_stats_f_energy(&f), energy, fTol * n, fTol),
+                    "%s offset %d n %u: f energy %.3f, reference %.3f", signalNames[sig], offset, n,
+                    signal_stats_f_energy(&f), energy);
+    HOST_TEST_CHECK(near(signal_stats_f_variance(&f), variance, fTol, fTol),
+                    "%s offset %d n %u: f variance %.6f, reference %.6f", signalNames[sig], offset, n,
+                    signal_stats_f_variance(&f), variance);
+}
+
+int main (void)
+{
+    signal_stats_q_t q;
+    signal_stats_f_t f;
+    uint32_t s, l, o;
+
+    // Empty accumulators
+    signal_stats_q_reset(&q);
+    signal_stats_f_reset(&f);
+    HOST_TEST_CHECK((signal_stats_q_mean(&q) == 0) && (signal_stats_q_energy(&q) == 0) &&
+                    (signal_stats_q_variance(&q) == 0), "q results without samples");
+    HOST_TEST_CHECK(signal_stats_f_variance(&f) == 0.0f, "f variance without samples");
+
+    for (s = 0; s < SIGNAL_COUNT; s++)
+    {
+        for (l = 0; l < sizeof(lengths) / sizeof(lengths[0]); l++)
+        {
+            for (o = 0; o < sizeof(offsets) / sizeof(offsets[0]); o++)
+            {
+                check_signal((signal_t)s, offsets[o], lengths[l]);
+            }
+        }
+    }
+    return host_test_end("signal_stats");
+}
@@ -0,0 +1,215 @@
+/**
+ * @file test_spsc_ring.c
+ *
+ * @brief   Test of the SPSC ring (spsc_ring.c) with a producer and a consumer thread.
+ *
+ * @details - Full ring: reserve and push fail and count overruns, the high-water mark is
+ *            the capacity, the elements come out in order.
+ *          - Lossless run: the producer retries while the ring is full, the consumer waits
+ *            for batches. Every element arrives once and in order, the overrun count is
+ *            the number of failed pushes.
+ *          - Lossy run: the producer never retries and the consumer is slow. The elements
+ *            that arrive are in order, received plus overruns is produced and the ring has
+ *            been full.
+ *
+ * @author agent
+ * @license MIT
+ *
+ * Copyright agent, 2026
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+
+#include "cmsis_os2.h"
+#include "host_sim.h"
+#include "spsc_ring.h"
+
+#include "host_test.h"
+
+#define TEST_CAPACITY           16
+#define TEST_BATCH              4
+#define TEST_FLAG               0x01
+#define TEST_LOSSLESS_COUNT     200000
+#define TEST_LOSSY_COUNT        200000
+#define TEST_WAIT_TICKS         10
+#define TEST_LOSSY_SLEEP_EVERY  8       // Consumer passes between 1 tick sleeps
+
+static spsc_ring_t ring;
+static uint32_t storage[TEST_CAPACITY];
+static osThreadId_t consumerId;
+
+static volatile uint32_t produced;
+static volatile uint32_t failedPushes;
+static volatile bool producerDone;
+
+// Sequence numbers from 0, lossless waits for room
+static void producer (void * arg)
+{
+    bool lossless = (arg != NULL);
+    uint32_t i;
+
+    for (i = 0; i < (lossless ? TEST_LOSSLESS_COUNT : TEST_LOSSY_COUNT); i++)
+    {
+        while (!spsc_ring_push(&ring, &i))
+        {
+            failedPushes++;
+            if (!lossless)
+            {
+                break;
+            }
+            osThreadYield();
+        }
+        produced++;
+        if (!lossless)
+        {
+            // Give the consumer a chance to keep up now and then
+            osThreadYield();
+        }
+    }
+    __atomic_store_n(&producerDone, true, __ATOMIC_RELEASE);
+}
+
+static void start_producer (bool lossless)
+{
+    const osThreadAttr_t attr = { .name = "producer" };
+
+    spsc_ring_init(&ring, storage, TEST_CAPACITY, sizeof(uint32_t));
+    spsc_ring_set_notify(&ring, consumerId, TEST_FLAG, TEST_BATCH);
+    produced = 0;
+    failedPushes = 0;
+    producerDone = false;
+    osThreadNew(producer, lossless ? &ring : NULL, &attr);
+}
+
+static void test_full_ring (void)
+{
+    uint32_t i, v;
+
+    spsc_ring_init(&ring, storage, TEST_CAPACITY, sizeof(uint32_t));
+    HOST_TEST_CHECK(spsc_ring_init(&ring, storage, TEST_CAPACITY - 1, sizeof(uint32_t)) == -1,
+                    "capacity not a power of two accepted");
+    for (i = 0; i < TEST_CAPACITY; i++)
+    {
+        HOST_TEST_CHECK(spsc_ring_push(&ring, &i), "push %u of %u failed", i, TEST_CAPACITY);
+    }
+    HOST_TEST_CHECK(spsc_ring_reserve(&ring) == NULL, "reserve on a full ring");
+    HOST_TEST_CHECK(!spsc_ring_push(&ring, &i), "push on a full ring");
+    HOST_TEST_CHECK(spsc_ring_overruns(&ring) == 2, "overruns %u, expected 2", spsc_ring_overruns(&ring));
+    HOST_TEST_CHECK(spsc_ring_high_water(&ring) == TEST_CAPACITY, "high water %u", spsc_ring_high_water(&ring));
+    HOST_TEST_CHECK(spsc_ring_count(&ring) == TEST_CAPACITY, "count %u", spsc_ring_count(&ring));
+
+    for (i = 0; i < TEST_CAPACITY / 2; i++)
+    {
+        HOST_TEST_CHECK(spsc_ring_pop(&ring, &v) && (v == i), "pop %u gave %u", i, v);
+    }
+    // Wraps around the end of the storage
+    for (i = TEST_CAPACITY; i < TEST_CAPACITY + TEST_CAPACITY / 2; i++)
+    {
+        HOST_TEST_CHECK(spsc_ring_push(&ring, &i), "push %u after pops failed", i);
+    }
+    for (i = TEST_CAPACITY / 2; i < TEST_CAPACITY + TEST_CAPACITY / 2; i++)
+    {
+        HOST_TEST_CHECK(spsc_ring_pop(&ring, &v) && (v == i), "pop %u gave %u", i, v);
+    }
+    HOST_TEST_CHECK(!spsc_ring_pop(&ring, &v), "pop on an empty ring");
+    HOST_TEST_CHECK(spsc_ring_high_water(&ring) == TEST_CAPACITY, "high water %u after draining",
+                    spsc_ring_high_water(&ring));
+}
+
+static void test_lossless (void)
+{
+    uint32_t next = 0;
+    uint32_t v;
+    bool inOrder = true;
+
+    start_producer(true);
+    while (next < TEST_LOSSLESS_COUNT)
+    {
+        spsc_ring_wait(&ring, TEST_WAIT_TICKS);
+        while (spsc_ring_pop(&ring, &v))
+        {
+            if (inOrder && !HOST_TEST_CHECK(v == next, "lossless got %u, expected %u", v, next))
+            {
+                inOrder = false;
+            }
+            next++;
+        }
+    }
+    while (!__atomic_load_n(&producerDone, __ATOMIC_ACQUIRE))
+    {
+        osThreadYield();
+    }
+    HOST_TEST_CHECK(!spsc_ring_pop(&ring, &v), "element after the last one");
+    HOST_TEST_CHECK(spsc_ring_overruns(&ring) == failedPushes, "overruns %u, failed pushes %u",
+                    spsc_ring_overruns(&ring), failedPushes);
+    HOST_TEST_CHECK(spsc_ring_high_water(&ring) <= TEST_CAPACITY, "high water %u", spsc_ring_high_water(&ring));
+    printf("spsc_ring: lossless %u elements, %u failed pushes, high water %u\n", next, failedPushes,
+           spsc_ring_high_water(&ring));
+}
+
+static void test_lossy (void)
+{
+    uint32_t received = 0;
+    uint32_t passes = 0;
+    uint32_t last = 0;
+    uint32_t v;
+    bool done = false;
+    bool inOrder = true;
+
+    start_producer(false);
+    while (!done)
+    {
+        // Done once the producer has finished and everything it put in is out
+        done = __atomic_load_n(&producerDone, __ATOMIC_ACQUIRE);
+        while (spsc_ring_pop(&ring, &v))
+        {
+            if (inOrder && (received > 0) && !HOST_TEST_CHECK(v > last, "lossy got %u after %u", v, last))
+            {
+                inOrder = false;
+            }
+            last = v;
+            received++;
+        }
+        if ((++passes % TEST_LOSSY_SLEEP_EVERY) == 0)
+        {
+            osDelay(1);
+        }
+        else
+        {
+            osThreadYield();
+        }
+    }
+    HOST_TEST_CHECK(received + spsc_ring_overruns(&ring) == TEST_LOSSY_COUNT, "received %u + overruns %u != %u",
+                    received, spsc_ring_overruns(&ring), TEST_LOSSY_COUNT);
+    HOST_TEST_CHECK(spsc_ring_overruns(&ring) == failedPushes, "overruns %u, failed pushes %u",
+                    spsc_ring_overruns(&ring), failedPushes);
+    HOST_TEST_CHECK(spsc_ring_high_water(&ring) == TEST_CAPACITY, "high water %u of %u",
+                    spsc_ring_high_water(&ring), TEST_CAPACITY);
+    printf("spsc_ring: lossy %u produced, %u received, %u overruns, high water %u\n", produced, received,
+           spsc_ring_overruns(&ring), spsc_ring_high_water(&ring));
+}
+
+static void consumer (void * arg)
+{
+    (void)arg;
+
+    test_lossless();
+    test_lossy();
+    exit(host_test_end("spsc_ring"));
+}
+
+int main (void)
+{
+    const osThreadAttr_t attr = { .name = "consumer" };
+
+    sim_init();
+    test_full_ring();
+
+    // Thread flags need kernel threads, the consumer ends the test
+    osKernelInitialize();
+    consumerId = osThreadNew(consumer, NULL, &attr);
+    osKernelStart();
+    return 1;
+}
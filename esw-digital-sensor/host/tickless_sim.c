@@ -0,0 +1,415 @@
+/**
+ * @file tickless_sim.c
+ *
+ * @brief   Check of the RTOS tick and tickless idle (tickless_idle.c) against a simulated
+ *          RTCC and kernel.
+ *
+ * @details Usage:
+ *          digi-sensor-tickless [-s seconds] [-t max_timeout_ticks] [-w early_wake_percent]
+ *                               [-l max_wake_latency_counts] [-r seed]
+ *
+ *          The RTCC counts one step at a time from just before its wrap, a compare match sets
+ *          the interrupt flag. The kernel is a tick count and one task that blocks for a
+ *          random number of ticks, an external interrupt (sensor data ready) wakes it early
+ *          in a share of the runs, part of those with EM2 blocked like during an I2C transfer.
+ *          The task runs for a while after waking, sometimes with interrupts masked for more
+ *          than a tick. EM2 wake-up takes a random number of counts up to the latency limit.
+ *
+ *          After every interrupt the kernel tick count must equal the ticks the RTCC has
+ *          passed since the kernel started, the kernel must never be stepped past the task
+ *          timeout and the task must run at its timeout. The ticks suppressed, the sleeps and
+ *          the measured wake-up latency are printed; the exit status is 1 on any error.
+ *
+ * @author agent
+ * @license MIT
+ *
+ * Copyright agent, 2026
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <unistd.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "em_core.h"
+#include "em_emu.h"
+#include "em_rtcc.h"
+#include "em_usart.h"
+
+#include "tickless_idle.h"
+
+#define SIM_RTCC_START          0xFFFF0000UL    // Wraps 2 s into the run
+#define SIM_BUSY_MAX_COUNTS     200             // Task run time after waking
+#define SIM_MASKED_MAX_COUNTS   120             // Longest masked section, over 3 ticks
+#define SIM_MAX_ERRORS          10              // Printed
+
+void vPortSetupTimerInterrupt(void);
+void vPortSuppressTicksAndSleep(TickType_t xExpectedIdleTime);
+void RTCC_IRQHandler(void);
+
+USART_TypeDef host_usart0 = { .STATUS = USART_STATUS_TXC | USART_STATUS_TXIDLE };
+
+// RTCC
+static uint32_t rtccCnt = SIM_RTCC_START;
+static uint32_t rtccCcv;
+static uint32_t rtccIf;
+static uint32_t rtccIen;
+static bool irqMasked;
+
+// External interrupt
+static bool extArmed;
+static uint32_t extCnt;
+static bool extPending;
+static bool extBlocksEm2;
+
+// Kernel
+static tickless_clock_t refClock;   // Ticks that should have been counted
+static uint32_t kernelTick;
+static uint32_t taskTimeout;        // Kernel tick the task unblocks at
+static bool taskReady;
+static bool taskWokenEarly;         // By the external interrupt
+
+static uint32_t maxLatency = 2;
+static uint32_t wakeLatencyInjected;
+static uint32_t taskRuns;
+static uint32_t earlyWakes;
+static uint32_t errors;
+static uint32_t randState = 1;
+
+static uint32_t sim_rand (uint32_t n)
+{
+    // xorshift32
+    randState ^= randState << 13;
+    randState ^= randState >> 17;
+    randState ^= randState << 5;
+    return (n > 0) ? randState % n : 0;
+}
+
+static void sim_error (const char * what, uint32_t value)
+{
+    if (errors < SIM_MAX_ERRORS)
+    {
+        fprintf(stderr, "tickless: %s at RTCC %08X, kernel tick %u, ideal %u, value %u\n", what,
+                rtccCnt, kernelTick, tickless_clock_elapsed(&refClock, rtccCnt), value);
+    }
+    errors++;
+}
+
+// One count of the 32768 Hz clock
+static void rtcc_step (void)
+{
+    rtccCnt++;
+    if (rtccCnt == rtccCcv)
+    {
+        rtccIf |= RTCC_IF_CC1;
+    }
+    if (extArmed && (rtccCnt == extCnt))
+    {
+        extArmed = false;
+        extPending = true;
+    }
+}
+
+static bool irq_pending (void)
+{
+    return (rtccIf & rtccIen) || extPending;
+}
+
+// Handlers of pending interrupts, if not masked
+static void run_irqs (void)
+{
+    if (irqMasked)
+    {
+        return;
+    }
+    if (rtccIf & rtccIen)
+    {
+        RTCC_IRQHandler();
+        if (kernelTick != tickless_clock_elapsed(&refClock, rtccCnt))
+        {
+            sim_error("tick count differs after the tick interrupt", kernelTick);
+        }
+    }
+    if (extPending)
+    {
+        extPending = false;
+        if (extBlocksEm2)
+        {
+            extBlocksEm2 = false;
+            tickless_em2_unblock();
+        }
+        if (!taskReady)
+        {
+            earlyWakes++;
+            taskWokenEarly = true;
+        }
+        taskReady = true;
+    }
+}
+
+// The task ran, block it again until a timeout and maybe an external interrupt
+static void task_block (uint32_t maxTimeout, uint32_t earlyPercent)
+{
+    uint32_t timeout = 1 + sim_rand(maxTimeout);
+
+    taskTimeout = kernelTick + timeout;
+    if (!extArmed && !extPending && (sim_rand(100) < earlyPercent))
+    {
+        extArmed = true;
+        extCnt = rtccCnt + 1 + sim_rand(timeout * 33);
+        if (!extBlocksEm2 && (sim_rand(4) == 0))
+        {
+            // A transfer runs until the interrupt
+            extBlocksEm2 = true;
+            tickless_em2_block();
+        }
+    }
+}
+
+// ________________________ Hardware and kernel stand-ins ________________________
+
+void __disable_irq (void)
+{
+    irqMasked = true;
+}
+
+void __enable_irq (void)
+{
+    irqMasked = false;
+}
+
+void host_irq_lock (void)
+{
+}
+
+void host_irq_unlock (void)
+{
+}
+
+bool host_irq_context (void)
+{
+    return false;
+}
+
+void NVIC_EnableIRQ (IRQn_Type irq)
+{
+    (void)irq;
+}
+
+void NVIC_ClearPendingIRQ (IRQn_Type irq)
+{
+    (void)irq;
+}
+
+void NVIC_SetPriority (IRQn_Type irq, uint32_t priority)
+{
+    (void)irq;
+    (void)priority;
+}
+
+uint32_t USART_StatusGet (USART_TypeDef * usart)
+{
+    return usart->STATUS;
+}
+
+uint32_t RTCC_CounterGet (void)
+{
+    return rtccCnt;
+}
+
+void RTCC_ChannelInit (int ch, const RTCC_CCChConf_TypeDef * confPtr)
+{
+    if ((ch != TICKLESS_RTCC_CHANNEL) || (confPtr->chMode != rtccCapComChModeCompare))
+    {
+        sim_error("unexpected channel setup", ch);
+    }
+}
+
+void RTCC_ChannelCCVSet (int ch, uint32_t value)
+{
+    (void)ch;
+    rtccCcv = value;
+}
+
+void RTCC_IntClear (uint32_t flags)
+{
+    rtccIf &= ~flags;
+}
+
+void RTCC_IntEnable (uint32_t flags)
+{
+    rtccIen |= flags;
+}
+
+void RTCC_IntSet (uint32_t flags)
+{
+    rtccIf |= flags;
+}
+
+uint32_t RTCC_IntGet (void)
+{
+    return rtccIf;
+}
+
+// WFI, interrupts wake the core also when masked
+void EMU_EnterEM1 (void)
+{
+    while (!irq_pending())
+    {
+        rtcc_step();
+    }
+}
+
+void EMU_EnterEM2 (bool restore)
+{
+    uint32_t latency = sim_rand(maxLatency + 1);
+
+    (void)restore;
+    EMU_EnterEM1();
+    // Oscillator start-up and clock restore
+    if (latency > wakeLatencyInjected)
+    {
+        wakeLatencyInjected = latency;
+    }
+    while (latency-- > 0)
+    {
+        rtcc_step();
+    }
+}
+
+BaseType_t xTaskIncrementTick (void)
+{
+    kernelTick++;
+    if (kernelTick > tickless_clock_elapsed(&refClock, rtccCnt))
+    {
+        sim_error("tick counted early", kernelTick);
+    }
+    if (kernelTick == taskTimeout)
+    {
+        taskReady = true;
+        return pdTRUE;
+    }
+    return pdFALSE;
+}
+
+void vTaskStepTick (TickType_t xTicksToJump)
+{
+    // configASSERT() in the kernel
+    if ((int32_t)(kernelTick + xTicksToJump - taskTimeout) > 0)
+    {
+        sim_error("stepped past the task timeout", xTicksToJump);
+    }
+    kernelTick += xTicksToJump;
+    if (kernelTick > tickless_clock_elapsed(&refClock, rtccCnt))
+    {
+        sim_error("stepped ahead of the RTCC", xTicksToJump);
+    }
+}
+
+eSleepModeStatus eTaskConfirmSleepModeStatus (void)
+{
+    return taskReady ? eAbortSleep : eStandardSleep;
+}
+
+// _____________________________________________________________________________
+
+int main (int argc, char * argv[])
+{
+    uint32_t seconds = 600;
+    uint32_t maxTimeout = 2000;
+    uint32_t earlyPercent = 30;
+    uint64_t counts = 0;
+    uint64_t endCounts;
+    tickless_stats_t st;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "s:t:w:l:r:")) != -1)
+    {
+        switch (opt)
+        {
+            case 's': seconds = strtoul(optarg, NULL, 0); break;
+            case 't': maxTimeout = strtoul(optarg, NULL, 0); break;
+            case 'w': earlyPercent = strtoul(optarg, NULL, 0); break;
+            case 'l': maxLatency = strtoul(optarg, NULL, 0); break;
+            case 'r': randState = strtoul(optarg, NULL, 0) | 1; break;
+            default:
+                fprintf(stderr, "usage: %s [-s seconds] [-t max_timeout_ticks] [-w early_wake_percent] "
+                        "[-l max_wake_latency_counts] [-r seed]\n", argv[0]);
+                return 2;
+        }
+    }
+    endCounts = (uint64_t)seconds * TICKLESS_CLOCK_HZ;
+
+    // Kernel start
+    vPortSetupTimerInterrupt();
+    tickless_clock_init(&refClock, rtccCnt, configTICK_RATE_HZ);
+    task_block(maxTimeout, earlyPercent);
+
+    while (counts < endCounts)
+    {
+        uint32_t before = rtccCnt;
+
+        run_irqs();
+        if (taskReady)
+        {
+            uint32_t busy = sim_rand(SIM_BUSY_MAX_COUNTS);
+
+            if (!taskWokenEarly && ((int32_t)(kernelTick - taskTimeout) < 0))
+            {
+                sim_error("task ran before its timeout", taskTimeout);
+            }
+            taskReady = false;
+            taskWokenEarly = false;
+            // Running, the timeout of the previous wait no longer applies
+            taskTimeout = kernelTick - 1;
+            taskRuns++;
+
+            if (sim_rand(8) == 0)
+            {
+                // A long critical section, tick interrupts are served late
+                uint32_t masked = sim_rand(SIM_MASKED_MAX_COUNTS);
+
+                __disable_irq();
+                while (masked-- > 0)
+                {
+                    rtcc_step();
+                }
+                __enable_irq();
+            }
+            while (busy-- > 0)
+            {
+                rtcc_step();
+                run_irqs();
+            }
+            task_block(maxTimeout, earlyPercent);
+        }
+        else if (taskTimeout - kernelTick >= configEXPECTED_IDLE_TIME_BEFORE_SLEEP)
+        {
+            vPortSuppressTicksAndSleep(taskTimeout - kernelTick);
+        }
+        else
+        {
+            // Too short to suppress, sleep to the next interrupt
+            EMU_EnterEM1();
+        }
+        counts += (uint32_t)(rtccCnt - before);
+    }
+    run_irqs();
+    if (kernelTick != tickless_clock_elapsed(&refClock, rtccCnt))
+    {
+        sim_error("tick count differs at the end", kernelTick);
+    }
+
+    tickless_stats(&st);
+    printf("tickless: %.1f s, %u ticks, %u tick interrupts, %u suppressed (%.1f %%), %u task runs, %u early\n",
+           (double)counts / TICKLESS_CLOCK_HZ, kernelTick, st.ticks, st.suppressed, 100.0 * st.suppressed / (kernelTick ? kernelTick : 1),
+           taskRuns, earlyWakes);
+    printf("tickless: %u sleeps, %u in EM2, %u timer wakes, wake latency mean %u max %u us (injected max %.0f us), "
+           "asleep %.1f %%\n", st.sleeps, st.em2Sleeps, st.timerWakes, st.wakeLatencyMeanUs, st.wakeLatencyMaxUs,
+           wakeLatencyInjected * 1e6 / TICKLESS_CLOCK_HZ, 100.0 * st.sleepCounts / counts);
+    printf("tickless: %u errors\n", errors);
+    return (errors > 0) ? 1 : 0;
+}
@@ -0,0 +1,134 @@
+/**
+ * @file trace_tool.c
+ *
+ * @brief   Converts accelerometer sessions between CSV and the trace format of the host
+ *          simulation (sim_trace.h).
+ *
+ * @details Usage:
+ *          digi-sensor-trace import in.csv out.mmat [odr_mhz [range [resolution]]]
+ *          digi-sensor-trace export in.mmat
+ *          digi-sensor-trace info in.mmat
+ *
+ *          CSV has one sample per line, x, y and z in counts (-512 ... 511) separated by
+ *          commas or spaces, lines starting with # are skipped. Export writes the same format
+ *          to stdout. Defaults for import are 6250 mHz, 2g range, 10 bit resolution.
+ *
+ * @author agent
+ * @license MIT
+ *
+ * Copyright agent, 2026
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "sim_trace.h"
+
+static int trace_import (int argc, char * argv[])
+{
+    sim_trace_info_t info = { .range = 0, .resolution = 10, .odrMhz = 6250 };
+    sim_trace_t t;
+    char line[128];
+    FILE * in;
+
+    if (argc < 4)
+    {
+        return 2;
+    }
+    if (argc > 4)
+    {
+        info.odrMhz = (uint32_t)strtoul(argv[4], NULL, 0);
+    }
+    if (argc > 5)
+    {
+        info.range = (uint8_t)strtoul(argv[5], NULL, 0);
+    }
+    if (argc > 6)
+    {
+        info.resolution = (uint8_t)strtoul(argv[6], NULL, 0);
+    }
+
+    in = fopen(argv[2], "r");
+    if (in == NULL)
+    {
+        perror(argv[2]);
+        return 1;
+    }
+    if (sim_trace_open_write(&t, argv[3], &info) != 0)
+    {
+        perror(argv[3]);
+        fclose(in);
+        return 1;
+    }
+    while (fgets(line, sizeof(line), in) != NULL)
+    {
+        int16_t xyz[3];
+        int x, y, z;
+
+        if ((line[0] == '#') || (sscanf(line, "%d%*[, ]%d%*[, ]%d", &x, &y, &z) != 3))
+        {
+            continue;
+        }
+        xyz[0] = (int16_t)x;
+        xyz[1] = (int16_t)y;
+        xyz[2] = (int16_t)z;
+        if (!sim_trace_write(&t, xyz))
+        {
+            perror(argv[3]);
+            break;
+        }
+    }
+    fprintf(stderr, "%u samples\n", t.pos);
+    sim_trace_close(&t);
+    fclose(in);
+    return 0;
+}
+
+static int trace_export (const char * path, bool samples)
+{
+    sim_trace_t t;
+    int16_t xyz[3];
+
+    if (sim_trace_open_read(&t, path) != 0)
+    {
+        fprintf(stderr, "%s: not a trace\n", path);
+        return 1;
+    }
+    printf("# range %u, resolution %u, odr %u mHz\n", t.info.range, t.info.resolution, t.info.odrMhz);
+    while (sim_trace_read(&t, xyz))
+    {
+        if (samples)
+        {
+            printf("%d,%d,%d\n", xyz[0], xyz[1], xyz[2]);
+        }
+    }
+    printf("# %u samples\n", t.pos);
+    sim_trace_close(&t);
+    return 0;
+}
+
+int main (int argc, char * argv[])
+{
+    int ret = 2;
+
+    if ((argc >= 2) && (strcmp(argv[1], "import") == 0))
+    {
+        ret = trace_import(argc, argv);
+    }
+    else if ((argc == 3) && (strcmp(argv[1], "export") == 0))
+    {
+        ret = trace_export(argv[2], true);
+    }
+    else if ((argc == 3) && (strcmp(argv[1], "info") == 0))
+    {
+        ret = trace_export(argv[2], false);
+    }
+    if (ret == 2)
+    {
+        fprintf(stderr, "usage: %s import in.csv out.mmat [odr_mhz [range [resolution]]]\n"
+                        "       %s export in.mmat\n"
+                        "       %s info in.mmat\n", argv[0], argv[0], argv[0]);
+    }
+    return ret;
+}
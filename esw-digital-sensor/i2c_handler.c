@@ -5,6 +5,14 @@
  
  * @note The accelerometer sensor is always turned on on the TTTW lab-kit. So
  * no power ON or enable has to be done.
+ *
+ * @note Transfers are interrupt driven. I2C_TransferInit() arms the I2C0 interrupts
+ * and I2C0_IRQHandler() advances the emlib transfer state machine, so the CPU is
+ * free while bytes move on the bus. i2c_transaction() blocks the calling thread on
+ * a semaphore until the transfer is done, i2c_transaction_submit() returns right
+ * away and reports completion through a callback. A blocking transaction that finds
+ * the bus owned by an asynchronous transfer or a claiming driver sleeps until the
+ * bus is freed.
  * 
  * @author Johannes Ehala, ProLab.
  * @license MIT
@@ -13,9 +21,38 @@
  */
 
 #include "em_cmu.h"
+#include "em_core.h"
+#include "cmsis_os2.h"
 
 #include "i2c_handler.h"
 #include "gpio_handler.h"
+#include "tickless_idle.h"
+#include "rtos_static.h"
+
+static osMutexId_t i2cBusMutex;        // Serializes blocking transactions between threads
+static osSemaphoreId_t i2cDoneSem;     // Released from IRQ when a blocking transaction finishes
+static osSemaphoreId_t i2cFreeSem;     // Released when the bus is freed while busWaiter is set
+
+// Completion of a blocking transaction, on the stack of the waiting thread
+typedef struct
+{
+    osSemaphoreId_t done;
+    volatile I2C_TransferReturn_TypeDef ret;
+} i2c_blocking_t;
+
+// State of the transfer in flight, only one transfer can be active on I2C0
+static volatile bool i2cBusy;
+static I2C_TransferSeq_TypeDef * volatile activeSeq;
+static volatile i2c_done_cb_t activeCb;
+static void * volatile activeCtx;
+static volatile i2c_irq_handler_t claimHandler; // Set while another driver sequences I2C0 by itself
+static volatile bool busWaiter;                 // A blocking transaction waits for the bus
+
+static bool i2c_bus_take(bool wait);
+static void i2c_bus_free(void);
+static void i2c_transfer_start(I2C_TransferSeq_TypeDef * seq, i2c_done_cb_t cb, void * ctx);
+static void i2c_transfer_complete(I2C_TransferReturn_TypeDef ret);
+static void i2c_blocking_done(I2C_TransferSeq_TypeDef * seq, I2C_TransferReturn_TypeDef ret, void * ctx);
 
 /**
  * @brief Init I2C interface. 
@@ -39,15 +76,45 @@ void i2c_init (void)
     I2C_Init_TypeDef i2c_init = I2C_INIT_DEFAULT;
     i2c_init.enable = false;
     I2C_Init(I2C0, &i2c_init);
+
+    // RTOS objects for waking up the thread that waits for a transfer.
+    if (i2cBusMutex == NULL)
+    {
+        RTOS_SYNC_STATIC(i2cBus);
+        const osMutexAttr_t mutexAttr = { .name = "i2c_bus", RTOS_SYNC_MEM(i2cBus) };
+
+        i2cBusMutex = osMutexNew(&mutexAttr);
+    }
+    if (i2cDoneSem == NULL)
+    {
+        RTOS_SYNC_STATIC(i2cDone);
+        const osSemaphoreAttr_t semAttr = { .name = "i2c_done", RTOS_SYNC_MEM(i2cDone) };
+
+        i2cDoneSem = osSemaphoreNew(1, 0, &semAttr);
+    }
+    if (i2cFreeSem == NULL)
+    {
+        RTOS_SYNC_STATIC(i2cFree);
+        const osSemaphoreAttr_t semAttr = { .name = "i2c_free", RTOS_SYNC_MEM(i2cFree) };
+
+        i2cFreeSem = osSemaphoreNew(1, 0, &semAttr);
+    }
+    i2cBusy = false;
+    busWaiter = false;
 }
 
 void i2c_enable (void)
 {
     I2C_Enable(I2C0, true);
+
+    NVIC_ClearPendingIRQ(I2C0_IRQn);
+    NVIC_SetPriority(I2C0_IRQn, I2C_IRQ_PRIORITY);
+    NVIC_EnableIRQ(I2C0_IRQn);
 }
 
 void i2c_disable (void)
 {
+    NVIC_DisableIRQ(I2C0_IRQn);
     I2C_Enable(I2C0, false);
 }
 
@@ -56,17 +123,211 @@ void i2c_reset (void)
     I2C_Reset(I2C0);
 }
 
-I2C_TransferSeq_TypeDef * i2c_transaction (I2C_TransferSeq_TypeDef * seq)
+/**
+ * @brief   Do an I2C transaction and block the calling thread until it is done.
+ *
+ * @note    The thread sleeps on a semaphore while the transfer runs, other threads
+ *          (or the idle task) get the CPU. Must be called from thread context.
+ *
+ * @param   seq I2C transfer sequence, received data is in seq->buf[1] for read transfers.
+ *
+ * @return  i2cTransferDone on success, error code of this transfer otherwise
+ */
+I2C_TransferReturn_TypeDef i2c_transaction (I2C_TransferSeq_TypeDef * seq)
+{
+    i2c_blocking_t wait = { .done = i2cDoneSem, .ret = i2cTransferInProgress };
+
+    osMutexAcquire(i2cBusMutex, osWaitForever);
+
+    // An asynchronous transfer or a claiming driver may own the bus, sleep until it is
+    // freed. Interrupt context can take it first, then wait again.
+    while (!i2c_bus_take(true))
+    {
+        osSemaphoreAcquire(i2cFreeSem, osWaitForever);
+    }
+    i2c_transfer_start(seq, i2c_blocking_done, &wait);
+    osSemaphoreAcquire(i2cDoneSem, osWaitForever);
+
+    osMutexRelease(i2cBusMutex);
+    return wait.ret;
+}
+
+/**
+ * @brief   Start an I2C transaction and return immediately (non-blocking).
+ *
+ * @note    Can be called from thread or interrupt context. seq and the buffers
+ *          it points to must stay valid until cb is called.
+ *
+ * @param   seq I2C transfer sequence.
+ * @param   cb  Called from I2C0_IRQHandler when the transfer is done, can be NULL.
+ * @param   ctx Passed to cb.
+ *
+ * @return  -1 if another transfer is in progress
+ *           0 if transfer was started
+ */
+int8_t i2c_transaction_submit (I2C_TransferSeq_TypeDef * seq, i2c_done_cb_t cb, void * ctx)
+{
+    if (!i2c_bus_take(false))
+    {
+        return -1;
+    }
+    i2c_transfer_start(seq, cb, ctx);
+    return 0;
+}
+
+/**
+ * @brief   Mark the bus busy if it is free.
+ *
+ * @param   wait Have i2c_bus_free() release i2cFreeSem if the bus is busy.
+ *
+ * @return  true if the bus was taken
+ */
+static bool i2c_bus_take (bool wait)
+{
+    bool taken;
+    CORE_DECLARE_IRQ_STATE;
+
+    CORE_ENTER_CRITICAL();
+    taken = !i2cBusy;
+    if (taken)
+    {
+        i2cBusy = true;
+        tickless_em2_block(); // I2C0 stops in EM2
+    }
+    else if (wait)
+    {
+        busWaiter = true;
+    }
+    CORE_EXIT_CRITICAL();
+    return taken;
+}
+
+/**
+ * @brief   Mark the bus free and wake a blocking transaction waiting for it.
+ */
+static void i2c_bus_free (void)
+{
+    bool wake;
+    CORE_DECLARE_IRQ_STATE;
+
+    CORE_ENTER_CRITICAL();
+    i2cBusy = false;
+    tickless_em2_unblock();
+    wake = busWaiter;
+    busWaiter = false;
+    CORE_EXIT_CRITICAL();
+
+    if (wake)
+    {
+        osSemaphoreRelease(i2cFreeSem);
+    }
+}
+
+/**
+ * @brief   Start a transfer on a bus taken with i2c_bus_take().
+ */
+static void i2c_transfer_start (I2C_TransferSeq_TypeDef * seq, i2c_done_cb_t cb, void * ctx)
 {
     I2C_TransferReturn_TypeDef ret;
-    
-    // Do a polled transfer
+
+    activeSeq = seq;
+    activeCb = cb;
+    activeCtx = ctx;
+
+    // I2C_TransferInit() enables the I2C interrupts, keep the handler from running
+    // before the first step of the transfer has been done.
+    NVIC_DisableIRQ(I2C0_IRQn);
     ret = I2C_TransferInit(I2C0, seq);
-    while (ret == i2cTransferInProgress)
+    NVIC_EnableIRQ(I2C0_IRQn);
+
+    if (ret != i2cTransferInProgress)
     {
-      ret = I2C_Transfer(I2C0);
+        // Failed (or finished) right away, no interrupt will follow.
+        i2c_transfer_complete(ret);
     }
+}
 
-    return seq;
+/**
+ * @brief   Release the bus and notify the owner of the finished transfer.
+ */
+static void i2c_transfer_complete (I2C_TransferReturn_TypeDef ret)
+{
+    I2C_TransferSeq_TypeDef * seq = activeSeq;
+    i2c_done_cb_t cb = activeCb;
+    void * ctx = activeCtx;
+
+    // Bus is free before the callback runs, so the callback can chain the next transfer.
+    i2c_bus_free();
+
+    if (cb != NULL)
+    {
+        cb(seq, ret, ctx);
+    }
+}
+
+static void i2c_blocking_done (I2C_TransferSeq_TypeDef * seq, I2C_TransferReturn_TypeDef ret, void * ctx)
+{
+    i2c_blocking_t * wait = ctx;
+
+    wait->ret = ret;
+    osSemaphoreRelease(wait->done);
 }
 
+/**
+ * @brief   Take exclusive ownership of I2C0 and its interrupt.
+ *
+ * @note    For drivers that drive the I2C0 registers themselves (e.g. LDMA assisted
+ *          reads). While the bus is claimed I2C0_IRQHandler calls handler instead of
+ *          the emlib transfer state machine. Can be called from interrupt context.
+ *
+ * @param   handler I2C0 interrupt handler of the claiming driver.
+ *
+ * @return  -1 if a transfer is in progress
+ *           0 if bus was claimed
+ */
+int8_t i2c_bus_claim (i2c_irq_handler_t handler)
+{
+    CORE_DECLARE_IRQ_STATE;
+
+    CORE_ENTER_CRITICAL();
+    if (i2cBusy)
+    {
+        CORE_EXIT_CRITICAL();
+        return -1;
+    }
+    i2cBusy = true;
+    tickless_em2_block();
+    claimHandler = handler;
+    CORE_EXIT_CRITICAL();
+    return 0;
+}
+
+/**
+ * @brief   Give back a bus taken with i2c_bus_claim().
+ */
+void i2c_bus_release (void)
+{
+    claimHandler = NULL;
+    i2c_bus_free();
+}
+
+/**
+ * @brief   I2C0 interrupt, advances the transfer in progress by one step.
+ */
+void I2C0_IRQHandler (void)
+{
+    I2C_TransferReturn_TypeDef ret;
+    i2c_irq_handler_t handler = claimHandler;
+
+    if (handler != NULL)
+    {
+        handler();
+        return;
+    }
+
+    ret = I2C_Transfer(I2C0);
+    if (ret != i2cTransferInProgress)
+    {
+        i2c_transfer_complete(ret);
+    }
+}
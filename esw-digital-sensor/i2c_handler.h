@@ -12,14 +12,35 @@
 
 #include "em_i2c.h"
 
-#define MMA8653FC_SCL_LOC   I2C_ROUTELOC0_SCLLOC_LOC1 
+#define MMA8653FC_SCL_LOC   I2C_ROUTELOC0_SCLLOC_LOC1
 #define MMA8653FC_SDA_LOC   3
 
+#define I2C_IRQ_PRIORITY    3 // Same as GPIO, so a transfer can be submitted from the GPIO ISR.
+
+/**
+ * @brief Transfer completion callback, called from I2C0_IRQHandler context (or from the
+ *        submitting context if the transfer fails to start).
+ *
+ * @param seq   transfer that finished
+ * @param ret   i2cTransferDone on success, error code otherwise
+ * @param ctx   user context given to i2c_transaction_submit()
+ */
+typedef void (*i2c_done_cb_t)(I2C_TransferSeq_TypeDef * seq, I2C_TransferReturn_TypeDef ret, void * ctx);
+
+/**
+ * @brief Interrupt handler of a driver that has claimed the bus for its own (non-emlib)
+ *        transfer sequencing, see i2c_bus_claim().
+ */
+typedef void (*i2c_irq_handler_t)(void);
+
 // Public functions
 void i2c_init(void);
 void i2c_enable(void);
 void i2c_disable(void);
 void i2c_reset(void);
-I2C_TransferSeq_TypeDef * i2c_transaction(I2C_TransferSeq_TypeDef * seq);
+I2C_TransferReturn_TypeDef i2c_transaction(I2C_TransferSeq_TypeDef * seq);
+int8_t i2c_transaction_submit(I2C_TransferSeq_TypeDef * seq, i2c_done_cb_t cb, void * ctx);
+int8_t i2c_bus_claim(i2c_irq_handler_t handler);
+void i2c_bus_release(void);
 
 #endif // I2C_HANDLER_H_
@@ -10,32 +10,95 @@
  * Copyright ProLab, TTÜ. 2021
  */
 
+#include <string.h>
+#include <stdbool.h>
+
 #include "cmsis_os2.h" // For osDelay() in sensor_reset() function.
 #include "mma8653fc_reg.h"
 #include "mma8653fc_driver.h"
 #include "em_i2c.h"
 #include "i2c_handler.h"
+#include "sample_time.h"
 
 #include "loglevels.h"
 #define __MODUUL__ "sdrv"
 #define __LOG_LEVEL__ (LOG_LEVEL_mmadrv & BASE_LOG_LEVEL)
 #include "log.h"
 
-static uint8_t read_registry(uint8_t regAddr);
+/**
+ * Shadow copies of the configuration registries.  ASLP_COUNT..CTRL_REG5 must stay in
+ * registry address order, mma_apply_config() writes them as one burst. The freefall/motion
+ * registries follow, they are not part of the configuration table. Field updates only change the shadow,
+ * mma_commit_config() writes the registries whose shadow differs from the value last
+ * written to the sensor. After sensor_reset() the registry values are known (all 0x00),
+ * so no read-modify-write round trips are needed.
+ */
+typedef enum
+{
+    SHADOW_XYZ_DATA_CFG,
+    SHADOW_ASLP_COUNT,
+    SHADOW_CTRL_REG1,
+    SHADOW_CTRL_REG2,
+    SHADOW_CTRL_REG3,
+    SHADOW_CTRL_REG4,
+    SHADOW_CTRL_REG5,
+    SHADOW_FF_MT_CFG,
+    SHADOW_FF_MT_THS,
+    SHADOW_FF_MT_COUNT,
+    SHADOW_REG_COUNT
+} shadow_reg_t;
+
+static const uint8_t shadowAddr[SHADOW_REG_COUNT] =
+{
+    MMA8653FC_REGADDR_XYZ_DATA_CFG,
+    MMA8653FC_REGADDR_ASLP_COUNT,
+    MMA8653FC_REGADDR_CTRL_REG1,
+    MMA8653FC_REGADDR_CTRL_REG2,
+    MMA8653FC_REGADDR_CTRL_REG3,
+    MMA8653FC_REGADDR_CTRL_REG4,
+    MMA8653FC_REGADDR_CTRL_REG5,
+    MMA8653FC_REGADDR_FF_MT_CFG,
+    MMA8653FC_REGADDR_FF_MT_THS,
+    MMA8653FC_REGADDR_FF_MT_COUNT
+};
+
+static uint8_t shadowVal[SHADOW_REG_COUNT];     // Wanted registry values
+static uint8_t sensorVal[SHADOW_REG_COUNT];     // Registry values in the sensor
+static uint16_t shadowDirty;                    // Bit per shadow_reg_t, set if shadowVal != sensorVal
+static bool shadowValid;                        // sensorVal is known
+
+static uint32_t transactionCount;               // I2C transactions done by the driver
+
+static I2C_TransferReturn_TypeDef read_registry(uint8_t regAddr, uint8_t *regVal);
 static void read_multiple_registries(uint8_t startRegAddr, uint8_t *rxBuf, uint16_t rxBufLen);
-static void write_registry(uint8_t regAddr, uint8_t regVal);
+static I2C_TransferReturn_TypeDef write_registry(uint8_t regAddr, uint8_t regVal);
+static I2C_TransferReturn_TypeDef write_multiple_registries(uint8_t startRegAddr, const uint8_t *txBuf, uint16_t txBufLen);
+static int8_t shadow_index(uint8_t regAddr);
+static void shadow_load(void);
+static void shadow_update_dirty(void);
+static void shadow_set_field(shadow_reg_t reg, uint8_t mask, uint8_t shift, uint8_t value);
 
 /**
  * @brief   Reset MMA8653FC sensor (software reset).
+ *
+ * @note    All configuration registries are 0x00 after reset, the shadow is set accordingly.
+ *          If the reset write fails the registry values are not known, the shadow is read
+ *          from the sensor on next use.
  */
 void sensor_reset (void)
 {
-    uint8_t regVal;
-    
-    regVal = read_registry(MMA8653FC_REGADDR_CTRL_REG2);
-    regVal = (regVal & ~MMA8653FC_CTRL_REG2_SOFTRST_MASK) | (MMA8653FC_CTRL_REG2_SOFTRST_EN << MMA8653FC_CTRL_REG2_SOFTRST_SHIFT);
-    write_registry(MMA8653FC_REGADDR_CTRL_REG2, regVal);
+    // Other bits of CTRL_REG2 are reset anyway, no need to read it first.
+    if (write_registry(MMA8653FC_REGADDR_CTRL_REG2, MMA8653FC_CTRL_REG2_SOFTRST_EN << MMA8653FC_CTRL_REG2_SOFTRST_SHIFT) != i2cTransferDone)
+    {
+        shadowValid = false;
+        return;
+    }
     osDelay(5*osKernelGetTickFreq()/1000); // Wait a little for reset to finish.
+
+    memset(shadowVal, 0, sizeof(shadowVal));
+    memset(sensorVal, 0, sizeof(sensorVal));
+    shadowDirty = 0;
+    shadowValid = true;
 }
 
 /**
@@ -43,32 +106,69 @@ void sensor_reset (void)
  */
 void set_sensor_active ()
 {
-    uint8_t reg_val;
-    reg_val = read_registry(MMA8653FC_REGADDR_CTRL_REG1);
-    reg_val = (reg_val & ~MMA8653FC_CTRL_REG1_SAMODE_MASK) | (MMA8653FC_CTRL_REG1_SAMODE_ACTIVE << MMA8653FC_CTRL_REG1_SAMODE_SHIFT);
-    
-    // Change mode to ACTIVE
-    write_registry(MMA8653FC_REGADDR_CTRL_REG1, reg_val);
+    shadow_set_field(SHADOW_CTRL_REG1, MMA8653FC_CTRL_REG1_SAMODE_MASK, MMA8653FC_CTRL_REG1_SAMODE_SHIFT, MMA8653FC_CTRL_REG1_SAMODE_ACTIVE);
+    mma_commit_config();
 }
 
 /**
  * @brief   Sets sensor to standby mode. Sensor must be in standby mode when writing to
  *          different config registries.
+ *
+ * @note    mma_commit_config() switches to standby by itself when needed.
  */
 void set_sensor_standby ()
 {
-    // Change mode to STANDBY
-    uint8_t reg_val;
-    reg_val = read_registry(MMA8653FC_REGADDR_CTRL_REG1);
-    reg_val = (reg_val & ~MMA8653FC_CTRL_REG1_SAMODE_MASK) | (MMA8653FC_CTRL_REG1_SAMODE_STANDBY << MMA8653FC_CTRL_REG1_SAMODE_SHIFT);
-    
-    // Change mode to STANDBY
-    write_registry(MMA8653FC_REGADDR_CTRL_REG1, reg_val);
+    shadow_set_field(SHADOW_CTRL_REG1, MMA8653FC_CTRL_REG1_SAMODE_MASK, MMA8653FC_CTRL_REG1_SAMODE_SHIFT, MMA8653FC_CTRL_REG1_SAMODE_STANDBY);
+    mma_commit_config();
 }
 
+/**
+ * @brief   Read WHO_AM_I.
+ *
+ * @return  0 if the read failed
+ */
 uint8_t read_whoami()
 {
-    return read_registry(MMA8653FC_REGADDR_WHO_AM_I);
+    uint8_t reg = 0;
+
+    read_registry(MMA8653FC_REGADDR_WHO_AM_I, &reg);
+    return reg;
+}
+
+/**
+ * @brief   Read INT_SOURCE, the interrupt sources that are active.
+ *
+ * @note    Reading does not clear them: data ready is cleared by reading the data, freefall/
+ *          motion by reading FF_MT_SRC and auto-sleep by reading SYSMOD.
+ */
+uint8_t read_int_source (void)
+{
+    uint8_t reg = 0;
+
+    read_registry(MMA8653FC_REGADDR_INT_SOURCE, &reg);
+    return reg;
+}
+
+/**
+ * @brief   Read SYSMOD (standby, wake or sleep), clears the auto-sleep interrupt source.
+ */
+uint8_t read_sysmod (void)
+{
+    uint8_t reg = 0;
+
+    read_registry(MMA8653FC_REGADDR_SYSMOD, &reg);
+    return reg & MMA8653FC_SYSMOD_MOD_MASK;
+}
+
+/**
+ * @brief   Read FF_MT_SRC, clears latched freefall/motion event flags and the interrupt source.
+ */
+uint8_t read_ff_mt_source (void)
+{
+    uint8_t reg = 0;
+
+    read_registry(MMA8653FC_REGADDR_FF_MT_SRC, &reg);
+    return reg;
 }
 
 
@@ -79,31 +179,16 @@ uint8_t read_whoami()
  * @param   range Set dynamic range (+- 2g, +- 4g, +- 8g)
  * @param   powerMod Set power mode (normal, low-noise-low-power, highres, low-power)
  * 
- * @return  -1 if sensor is not in standby mode
- *           0 if configuration succeeded (no check)
+ * @return  -1 if an I2C transaction failed, see mma_commit_config()
+ *           0 otherwise
  */
 int8_t configure_xyz_data (uint8_t dataRate, uint8_t range, uint8_t powerMod)
 {
-    uint8_t reg_val;
-    // TODO Check if sensor is in standby mode, control registers can only be modified in standby mode.
-    set_sensor_standby();
-    
-    // TODO Set data rate.
-    reg_val = read_registry(MMA8653FC_REGADDR_CTRL_REG1);
-    reg_val = (reg_val & ~MMA8653FC_CTRL_REG1_DATA_RATE_MASK) | (dataRate << MMA8653FC_CTRL_REG1_DATA_RATE_SHIFT) ;
-    write_registry(MMA8653FC_REGADDR_CTRL_REG1, reg_val);
-    
-    // TODO Set dynamic range.
-    reg_val = read_registry(MMA8653FC_REGADDR_XYZ_DATA_CFG);
-    reg_val = (reg_val & ~MMA8653FC_XYZ_DATA_CFG_RANGE_MASK) | (range << MMA8653FC_XYZ_DATA_CFG_RANGE_SHIFT) ;
-    write_registry(MMA8653FC_REGADDR_XYZ_DATA_CFG, reg_val);
-
-    // TODO Set power mode (oversampling). 
-    reg_val = read_registry(MMA8653FC_REGADDR_CTRL_REG2);
-    reg_val = (reg_val & ~(MMA8653FC_CTRL_REG2_ACTIVEPOW_MASK)) | powerMod; //MODS0 ja MODS1 on 2 esimest bitti seega ei pea shiftima
-    write_registry(MMA8653FC_REGADDR_CTRL_REG2, reg_val);
-    
-    return 0;
+    shadow_set_field(SHADOW_CTRL_REG1, MMA8653FC_CTRL_REG1_DATA_RATE_MASK, MMA8653FC_CTRL_REG1_DATA_RATE_SHIFT, dataRate);
+    shadow_set_field(SHADOW_XYZ_DATA_CFG, MMA8653FC_XYZ_DATA_CFG_RANGE_MASK, MMA8653FC_XYZ_DATA_CFG_RANGE_SHIFT, range);
+    shadow_set_field(SHADOW_CTRL_REG2, MMA8653FC_CTRL_REG2_ACTIVEPOW_MASK, MMA8653FC_CTRL_REG2_ACTIVEPOW_SHIFT, powerMod);
+
+    return mma_commit_config();
 }
 
 /**
@@ -114,60 +199,431 @@ int8_t configure_xyz_data (uint8_t dataRate, uint8_t range, uint8_t powerMod)
  * @param   interrupt Set interrupts to use.
  * @param   int_select Route interrupts to selected pin.
  *
- * @return  -1 if sensor is not in standby mode
- *           0 if configuration succeeded (no check)
+ * @return  -1 if an I2C transaction failed, see mma_commit_config()
+ *           0 otherwise
  */
 int8_t configure_interrupt (uint8_t polarity, uint8_t pinmode, uint8_t interrupt, uint8_t int_select)
 {
-    uint8_t reg_val;
-    // TODO Check if sensor is in standby mode, control registers can only be modified in standby mode.
-    set_sensor_standby();
-    reg_val = read_registry(MMA8653FC_REGADDR_CTRL_REG1);
-    info1("REG1 PEAB OLEMA 1 - %u", reg_val);
-    // TODO Configure interrupt pin pinmode and interrupt transition direction
-    	   
-    reg_val = read_registry(MMA8653FC_REGADDR_CTRL_REG3);
-    reg_val = (reg_val & ~MMA8653FC_CTRL_REG3_POLARITY_MASK) | (polarity << MMA8653FC_CTRL_REG3_POLARITY_SHIFT) ;
-    write_registry(MMA8653FC_REGADDR_CTRL_REG3, reg_val);
-    // pinmode
-    
-    reg_val = read_registry(MMA8653FC_REGADDR_CTRL_REG3);
-    reg_val = (reg_val & ~MMA8653FC_CTRL_REG3_PINMODE_MASK) | (pinmode << MMA8653FC_CTRL_REG3_PINMODE_SHIFT) ;
-    write_registry(MMA8653FC_REGADDR_CTRL_REG3, reg_val);
-    // TODO Enable data ready interrupt
-    
-    reg_val = read_registry(MMA8653FC_REGADDR_CTRL_REG4);
-    reg_val = (reg_val & ~MMA8653FC_CTRL_REG4_DRDY_INT_MASK) | (interrupt << MMA8653FC_CTRL_REG4_DRDY_INT_SHIFT) ;
-    write_registry(MMA8653FC_REGADDR_CTRL_REG4, reg_val);    
-    
-    // TODO Route data ready interrupt to sensor INT1 output pin (connected to port PA1 on the TTTW uC)
+    shadow_set_field(SHADOW_CTRL_REG3, MMA8653FC_CTRL_REG3_POLARITY_MASK, MMA8653FC_CTRL_REG3_POLARITY_SHIFT, polarity);
+    shadow_set_field(SHADOW_CTRL_REG3, MMA8653FC_CTRL_REG3_PINMODE_MASK, MMA8653FC_CTRL_REG3_PINMODE_SHIFT, pinmode);
+    shadow_set_field(SHADOW_CTRL_REG4, MMA8653FC_CTRL_REG4_DRDY_INT_MASK, MMA8653FC_CTRL_REG4_DRDY_INT_SHIFT, interrupt);
+    shadow_set_field(SHADOW_CTRL_REG5, MMA8653FC_CTRL_REG5_DRDY_INTSEL_MASK, MMA8653FC_CTRL_REG5_DRDY_INTSEL_SHIFT, int_select);
 
-    reg_val = read_registry(MMA8653FC_REGADDR_CTRL_REG5);
-    reg_val = (reg_val & ~MMA8653FC_CTRL_REG5_DRDY_INTSEL_MASK) | (int_select << MMA8653FC_CTRL_REG5_DRDY_INTSEL_SHIFT) ;
-    write_registry(MMA8653FC_REGADDR_CTRL_REG5, reg_val); 
-    
+    return mma_commit_config();
+}
+
+/**
+ * @brief   Change a bit field of a configuration registry. Only the shadow copy is changed,
+ *          call mma_commit_config() to write it to the sensor.
+ *
+ * @param   regAddr Address of registry (XYZ_DATA_CFG, FF_MT_CFG, FF_MT_THS, FF_MT_COUNT,
+ *          ASLP_COUNT or CTRL_REG1..5).
+ * @param   mask Bit field mask.
+ * @param   shift Bit field shift.
+ * @param   value Bit field value (not shifted).
+ *
+ * @return  -1 if registry is not shadowed
+ *           0 otherwise
+ */
+int8_t mma_set_field (uint8_t regAddr, uint8_t mask, uint8_t shift, uint8_t value)
+{
+    int8_t idx = shadow_index(regAddr);
+
+    if (idx < 0)
+    {
+        return -1;
+    }
+    shadow_set_field((shadow_reg_t)idx, mask, shift, value);
     return 0;
 }
 
 /**
- * @brief   Reads MMA8653FC STATUS and data registries.
+ * @brief   Get a bit field of a configuration registry from the shadow copy (no I2C).
  *
- * @return  Returns value of STATUS registry and x, y, z, 10 bit raw values (left-justified 2's complement)
+ * @return  Bit field value (not shifted), 0 if registry is not shadowed.
+ */
+uint8_t mma_get_field (uint8_t regAddr, uint8_t mask, uint8_t shift)
+{
+    int8_t idx = shadow_index(regAddr);
+
+    if (idx < 0)
+    {
+        return 0;
+    }
+    if (!shadowValid)
+    {
+        shadow_load();
+    }
+    return (shadowVal[idx] & mask) >> shift;
+}
+
+/**
+ * @brief   Write changed configuration registries to the sensor.
+ *
+ * @note    Configuration registries can only be written in standby mode, in active mode
+ *          only the ACTIVE bit of CTRL_REG1 can be changed. If anything else has changed
+ *          (another registry or another CTRL_REG1 field) and the sensor is active, it is put
+ *          to standby first and CTRL_REG1 (with the wanted mode) is written last.
+ *
+ * @note    A registry whose write fails keeps its old value in the sensor copy and stays
+ *          dirty, the next commit writes it again. If the standby write fails nothing else
+ *          is written, if the registry values are not known (shadow load failed) nothing
+ *          is written at all.
+ *
+ * @return  -1 if an I2C transaction failed
+ *           0 otherwise
+ */
+int8_t mma_commit_config (void)
+{
+    uint8_t i, standbyVal;
+    bool standbyNeeded;
+    int8_t ret = 0;
+
+    if (!shadowValid)
+    {
+        return -1;
+    }
+    if (shadowDirty == 0)
+    {
+        return 0;
+    }
+
+    standbyNeeded = (shadowDirty & ~(1 << SHADOW_CTRL_REG1)) ||
+                    ((sensorVal[SHADOW_CTRL_REG1] ^ shadowVal[SHADOW_CTRL_REG1]) & ~MMA8653FC_CTRL_REG1_SAMODE_MASK);
+
+    if (standbyNeeded && (sensorVal[SHADOW_CTRL_REG1] & MMA8653FC_CTRL_REG1_SAMODE_MASK))
+    {
+        standbyVal = sensorVal[SHADOW_CTRL_REG1] & ~MMA8653FC_CTRL_REG1_SAMODE_MASK;
+        if (write_registry(MMA8653FC_REGADDR_CTRL_REG1, standbyVal) != i2cTransferDone)
+        {
+            return -1;
+        }
+        sensorVal[SHADOW_CTRL_REG1] = standbyVal;
+    }
+
+    for (i = 0; i < SHADOW_REG_COUNT; i++)
+    {
+        if ((i != SHADOW_CTRL_REG1) && (shadowDirty & (1 << i)))
+        {
+            if (write_registry(shadowAddr[i], shadowVal[i]) == i2cTransferDone)
+            {
+                sensorVal[i] = shadowVal[i];
+            }
+            else
+            {
+                ret = -1;
+            }
+        }
+    }
+
+    // The previous mode is restored also if a registry failed
+    if (sensorVal[SHADOW_CTRL_REG1] != shadowVal[SHADOW_CTRL_REG1])
+    {
+        if (write_registry(MMA8653FC_REGADDR_CTRL_REG1, shadowVal[SHADOW_CTRL_REG1]) == i2cTransferDone)
+        {
+            sensorVal[SHADOW_CTRL_REG1] = shadowVal[SHADOW_CTRL_REG1];
+        }
+        else
+        {
+            ret = -1;
+        }
+    }
+
+    shadow_update_dirty();
+    return ret;
+}
+
+/**
+ * @brief   Apply a complete configuration table (see MMA8653FC_CONFIG()).
+ *
+ * @note    ASLP_COUNT and CTRL_REG1..CTRL_REG5 are written in one auto-incrementing
+ *          burst, XYZ_DATA_CFG separately if it changes. The sensor is put to standby
+ *          first if needed and left in standby, activate it with set_sensor_active().
+ *
+ * @note    The table is kept in the shadow also if a write fails, the registries that
+ *          did not reach the sensor stay dirty for mma_commit_config().
+ *
+ * @return  -1 if an I2C transaction failed
+ *           0 otherwise
+ */
+int8_t mma_apply_config (const mma_config_t * cfg)
+{
+    uint8_t standbyVal;
+    int8_t ret = 0;
+
+    if (!shadowValid)
+    {
+        shadow_load();
+    }
+
+    if (sensorVal[SHADOW_CTRL_REG1] & MMA8653FC_CTRL_REG1_SAMODE_MASK)
+    {
+        standbyVal = sensorVal[SHADOW_CTRL_REG1] & ~MMA8653FC_CTRL_REG1_SAMODE_MASK;
+        if (write_registry(MMA8653FC_REGADDR_CTRL_REG1, standbyVal) == i2cTransferDone)
+        {
+            sensorVal[SHADOW_CTRL_REG1] = standbyVal;
+        }
+        else
+        {
+            ret = -1;
+        }
+    }
+
+    // The sensor drops configuration writes while active
+    if (ret == 0)
+    {
+        if (sensorVal[SHADOW_XYZ_DATA_CFG] != cfg->xyz_data_cfg)
+        {
+            if (write_registry(MMA8653FC_REGADDR_XYZ_DATA_CFG, cfg->xyz_data_cfg) == i2cTransferDone)
+            {
+                sensorVal[SHADOW_XYZ_DATA_CFG] = cfg->xyz_data_cfg;
+            }
+            else
+            {
+                ret = -1;
+            }
+        }
+
+        if (memcmp(&sensorVal[SHADOW_ASLP_COUNT], cfg->burst, MMA8653FC_CONFIG_BURST_LEN) != 0)
+        {
+            if (write_multiple_registries(MMA8653FC_REGADDR_ASLP_COUNT, cfg->burst, MMA8653FC_CONFIG_BURST_LEN) == i2cTransferDone)
+            {
+                memcpy(&sensorVal[SHADOW_ASLP_COUNT], cfg->burst, MMA8653FC_CONFIG_BURST_LEN);
+            }
+            else
+            {
+                ret = -1;
+            }
+        }
+    }
+
+    memcpy(shadowVal, sensorVal, sizeof(shadowVal));
+    shadowVal[SHADOW_XYZ_DATA_CFG] = cfg->xyz_data_cfg;
+    memcpy(&shadowVal[SHADOW_ASLP_COUNT], cfg->burst, MMA8653FC_CONFIG_BURST_LEN);
+    shadow_update_dirty();
+    return ret;
+}
+
+/**
+ * @brief   Number of I2C transactions done by the driver since start-up.
+ */
+uint32_t mma_get_transaction_count (void)
+{
+    return transactionCount;
+}
+
+/**
+ * @brief   Find shadow index of a registry.
+ *
+ * @return  -1 if registry is not shadowed
+ */
+static int8_t shadow_index (uint8_t regAddr)
+{
+    int8_t i;
+
+    for (i = 0; i < SHADOW_REG_COUNT; i++)
+    {
+        if (shadowAddr[i] == regAddr)
+        {
+            return i;
+        }
+    }
+    return -1;
+}
+
+/**
+ * @brief   Read configuration registries from the sensor, used if the sensor has not been
+ *          reset by this driver. The shadow stays invalid if a read fails.
+ */
+static void shadow_load (void)
+{
+    uint8_t i;
+
+    shadowValid = true;
+    for (i = 0; i < SHADOW_REG_COUNT; i++)
+    {
+        if (read_registry(shadowAddr[i], &sensorVal[i]) != i2cTransferDone)
+        {
+            shadowValid = false;
+        }
+        shadowVal[i] = sensorVal[i];
+    }
+    shadowDirty = 0;
+}
+
+/**
+ * @brief   Mark the registries whose shadow differs from the sensor copy dirty.
+ */
+static void shadow_update_dirty (void)
+{
+    uint8_t i;
+
+    shadowDirty = 0;
+    for (i = 0; i < SHADOW_REG_COUNT; i++)
+    {
+        if (shadowVal[i] != sensorVal[i])
+        {
+            shadowDirty |= (1 << i);
+        }
+    }
+}
+
+/**
+ * @brief   Update a bit field in the shadow and mark the registry dirty if it changed.
+ */
+static void shadow_set_field (shadow_reg_t reg, uint8_t mask, uint8_t shift, uint8_t value)
+{
+    if (!shadowValid)
+    {
+        shadow_load();
+    }
+
+    shadowVal[reg] = (shadowVal[reg] & ~mask) | ((value << shift) & mask);
+
+    if (shadowVal[reg] != sensorVal[reg])
+    {
+        shadowDirty |= (1 << reg);
+    }
+    else
+    {
+        shadowDirty &= ~(1 << reg);
+    }
+}
+
+/**
+ * @brief   Select normal (10 bit) or fast (8 bit) read mode.
+ *
+ * @note    In fast read mode the sensor skips the LSB registries when reading in a burst,
+ *          so a sample is 4 bytes instead of 7. F_READ can only be changed in standby:
+ *          mma_commit_config() puts an active sensor to standby first and then writes
+ *          CTRL_REG1 with the new mode and ACTIVE set again, a sensor in standby stays in
+ *          standby. The burst length of mma_acq is set separately, mma_acq_set_read_mode().
+ *
+ * @param   readMode MMA8653FC_CTRL_REG1_NORMAL_READ or MMA8653FC_CTRL_REG1_FAST_READ
+ *
+ * @return  -1 if readMode is not valid
+ *           0 configuration succeeded (no check)
+ */
+int8_t mma_set_read_mode (uint8_t readMode)
+{
+    if ((readMode != MMA8653FC_CTRL_REG1_NORMAL_READ) && (readMode != MMA8653FC_CTRL_REG1_FAST_READ))
+    {
+        return -1;
+    }
+    shadow_set_field(SHADOW_CTRL_REG1, MMA8653FC_CTRL_REG1_READ_MOD_MASK, MMA8653FC_CTRL_REG1_READ_MOD_SHIFT, readMode);
+    return mma_commit_config();
+}
+
+/**
+ * @brief   Current read mode (from the shadow, no I2C).
+ *
+ * @return  MMA8653FC_CTRL_REG1_NORMAL_READ or MMA8653FC_CTRL_REG1_FAST_READ
+ */
+uint8_t mma_get_read_mode (void)
+{
+    return mma_get_field(MMA8653FC_REGADDR_CTRL_REG1, MMA8653FC_CTRL_REG1_READ_MOD_MASK, MMA8653FC_CTRL_REG1_READ_MOD_SHIFT);
+}
+
+/**
+ * @brief   Output data rate in active (wake) mode (from the shadow, no I2C).
+ *
+ * @return  Data rate in mHz, 1563 ... 800000
+ */
+uint32_t mma_get_data_rate_mhz (void)
+{
+    static const uint32_t rates[8] = { 800000, 400000, 200000, 100000, 50000, 12500, 6250, 1563 };
+
+    return rates[mma_get_field(MMA8653FC_REGADDR_CTRL_REG1, MMA8653FC_CTRL_REG1_DATA_RATE_MASK, MMA8653FC_CTRL_REG1_DATA_RATE_SHIFT)];
+}
+
+/**
+ * @brief   Number of bytes in a STATUS + xyz data burst for a read mode.
+ */
+uint8_t mma_burst_len (uint8_t readMode)
+{
+    return (readMode == MMA8653FC_CTRL_REG1_FAST_READ) ? MMA8653FC_BURST_LEN_FAST : MMA8653FC_BURST_LEN_NORMAL;
+}
+
+/**
+ * @brief   Reads MMA8653FC STATUS and data registries. Reads 7 bytes in normal read mode
+ *          and 4 bytes in fast read mode.
+ *
+ * @return  Returns value of STATUS registry and x, y, z, 10 bit raw values (left-justified 2's complement),
+ *          resolution tells how many of the bits are valid, stamp is the time of the read.
  */
 xyz_rawdata_t get_xyz_data()
 {
+    uint8_t rx_buf[MMA8653FC_BURST_LEN_NORMAL];
+    uint8_t readMode = mma_get_read_mode();
+    uint32_t stamp = sample_time_now();
     xyz_rawdata_t data;
-    uint8_t rx_buf[7];
     
     // Read multiple registries for status and x, y, z raw data
-    read_multiple_registries(MMA8653FC_REGADDR_STATUS, rx_buf, 7);
-    
-    data.status = rx_buf[0];
-    data.out_x = (uint16_t)(rx_buf[1] << 8) | (0x0000 | rx_buf[2]);
-    data.out_y = (uint16_t)(rx_buf[3] << 8) | (0x0000 | rx_buf[4]);
-    data.out_z = (uint16_t)(rx_buf[5] << 8) | (0x0000 | rx_buf[6]);
-    
+    read_multiple_registries(MMA8653FC_REGADDR_STATUS, rx_buf, mma_burst_len(readMode));
     
+    data = parse_xyz_data(rx_buf, readMode);
+    data.stamp = stamp;
+    return data;
+}
+
+/**
+ * @brief   Unpacks MMA8653FC STATUS and data registries read in one burst.
+ *
+ * @param   rxBuf Registry values starting from STATUS (7 bytes normal, 4 bytes fast read mode).
+ * @param   readMode Read mode the burst was read in.
+ *
+ * @return  Returns value of STATUS registry and x, y, z, 10 bit raw values (left-justified 2's complement)
+ */
+xyz_rawdata_t parse_xyz_data(const uint8_t rxBuf[], uint8_t readMode)
+{
+    xyz_rawdata_t data;
+
+    data.status = rxBuf[0];
+    if (readMode == MMA8653FC_CTRL_REG1_FAST_READ)
+    {
+        data.out_x = (uint16_t)(rxBuf[1] << 8);
+        data.out_y = (uint16_t)(rxBuf[2] << 8);
+        data.out_z = (uint16_t)(rxBuf[3] << 8);
+        data.resolution = MMA8653FC_RESOLUTION_FAST;
+    }
+    else
+    {
+        data.out_x = (uint16_t)(rxBuf[1] << 8) | (0x0000 | rxBuf[2]);
+        data.out_y = (uint16_t)(rxBuf[3] << 8) | (0x0000 | rxBuf[4]);
+        data.out_z = (uint16_t)(rxBuf[5] << 8) | (0x0000 | rxBuf[6]);
+        data.resolution = MMA8653FC_RESOLUTION_NORMAL;
+    }
+    data.stamp = 0;
+
+    return data;
+}
+
+/**
+ * @brief   Reads MMA8653FC STATUS and 8 bit data registries. Sensor must be in fast read mode.
+ *
+ * @return  Returns value of STATUS registry and x, y, z, 8 bit 2's complement values.
+ */
+xyz_rawdata8_t get_xyz_data8()
+{
+    uint8_t rx_buf[MMA8653FC_BURST_LEN_FAST];
+
+    read_multiple_registries(MMA8653FC_REGADDR_STATUS, rx_buf, MMA8653FC_BURST_LEN_FAST);
+
+    return parse_xyz_data8(rx_buf);
+}
+
+/**
+ * @brief   Unpacks a fast read mode burst (STATUS + OUT_X/Y/Z MSB).
+ */
+xyz_rawdata8_t parse_xyz_data8(const uint8_t rxBuf[])
+{
+    xyz_rawdata8_t data;
+
+    data.status = rxBuf[0];
+    data.out_x = (int8_t)rxBuf[1];
+    data.out_y = (int8_t)rxBuf[2];
+    data.out_z = (int8_t)rxBuf[3];
+
     return data;
 }
 
@@ -175,13 +631,14 @@ xyz_rawdata_t get_xyz_data()
  * @brief   Read value of one registry of MMA8653FC.
  *
  * @param   regAddr Address of registry to read.
+ * @param   *regVal Value of registry with address regAddr, not changed if the read fails.
  *
- * @return  value of registry with address regAddr.
+ * @return  i2cTransferDone or the error of the transfer
  */
-static uint8_t read_registry(uint8_t regAddr)
+static I2C_TransferReturn_TypeDef read_registry(uint8_t regAddr, uint8_t *regVal)
 {
-    uint8_t reg;
-    I2C_TransferSeq_TypeDef *ret, seq;
+    I2C_TransferReturn_TypeDef ret;
+    I2C_TransferSeq_TypeDef seq;
     static uint8_t tx_buf[1], rx_buf[1];
     
     // Configure I2C_TransferSeq_TypeDef
@@ -197,10 +654,13 @@ static uint8_t read_registry(uint8_t regAddr)
     
     // Read a value from MMA8653FC registry
     ret = i2c_transaction(&seq);
-    reg = ret->buf[1].data[0];
+    transactionCount++;
+    if (ret == i2cTransferDone)
+    {
+        *regVal = rx_buf[0];
+    }
     
-    //info1("REG - %u", reg);
-    return reg;
+    return ret;
 }
 
 /**
@@ -209,13 +669,16 @@ static uint8_t read_registry(uint8_t regAddr)
  * @param   regAddr Address of registry to read.
  * @param   regVal Value to write to MMA8653FC registry.
  *
- * @note    rxBuf is not used I think, maybe replace with NULL pointer.
+ * @note    Only one buffer is sent (I2C_FLAG_WRITE). Sending a second buffer would write
+ *          into the next registry, MMA8653FC increments the registry address on writes.
+ *
+ * @return  i2cTransferDone or the error of the transfer
  */
-static void write_registry(uint8_t regAddr, uint8_t regVal)
+static I2C_TransferReturn_TypeDef write_registry(uint8_t regAddr, uint8_t regVal)
 {
-    uint8_t reg;
-    I2C_TransferSeq_TypeDef *ret, seq;
-    static uint8_t tx_buf[2], rx_buf[1];
+    I2C_TransferReturn_TypeDef ret;
+    I2C_TransferSeq_TypeDef seq;
+    static uint8_t tx_buf[2];
     
     // Configure I2C_TransferSeq_TypeDef
     seq.addr = MMA8653FC_SLAVE_ADDRESS_WRITE;
@@ -223,17 +686,43 @@ static void write_registry(uint8_t regAddr, uint8_t regVal)
     tx_buf[1] = regVal;
     seq.buf[0].data = tx_buf;
     seq.buf[0].len = 2;
+    seq.flags = I2C_FLAG_WRITE;    
     
-    rx_buf[0] = 0;
-    seq.buf[1].data = rx_buf;
-    seq.buf[1].len = 1;
-    seq.flags = I2C_FLAG_WRITE_WRITE;    
-    
-    // Read a value from MMA8653FC registry
+    // Write a value to MMA8653FC registry
     ret = i2c_transaction(&seq);
-    //info1("Write - %u", regVal);
+    transactionCount++;
     
-    return ;
+    return ret;
+}
+
+/**
+ * @brief   Write consecutive registries of MMA8653FC in one go, MMA8653FC increments
+ *          the registry address after every byte.
+ *
+ * @param   startRegAddr Address of first registry to write.
+ * @param   *txBuf Values to write.
+ * @param   txBufLen Number of registries to write.
+ *
+ * @return  i2cTransferDone or the error of the transfer
+ */
+static I2C_TransferReturn_TypeDef write_multiple_registries(uint8_t startRegAddr, const uint8_t *txBuf, uint16_t txBufLen)
+{
+    I2C_TransferReturn_TypeDef ret;
+    I2C_TransferSeq_TypeDef seq;
+    static uint8_t tx_buf[1];
+
+    // Registry address in the first buffer, values follow without a repeated start
+    seq.addr = MMA8653FC_SLAVE_ADDRESS_WRITE;
+    tx_buf[0] = startRegAddr;
+    seq.buf[0].data = tx_buf;
+    seq.buf[0].len = 1;
+    seq.buf[1].data = (uint8_t *)txBuf;
+    seq.buf[1].len = txBufLen;
+    seq.flags = I2C_FLAG_WRITE_WRITE;
+
+    ret = i2c_transaction(&seq);
+    transactionCount++;
+    return ret;
 }
 
 /**
@@ -248,34 +737,22 @@ static void write_registry(uint8_t regAddr, uint8_t regVal)
  */
 static void read_multiple_registries(uint8_t startRegAddr, uint8_t *rxBuf, uint16_t rxBufLen)
 {
-    info1("Kohal");
-    // TODO Configure I2C_TransferSeq_TypeDef 
-    
-    // TODO Do I2C transaction
-    
-    uint8_t reg;
-    I2C_TransferSeq_TypeDef *ret, seq;
-    static uint8_t tx_buf[7], rx_buf[7];
-    
-    // Configure I2C_TransferSeq_TypeDef
+    I2C_TransferSeq_TypeDef seq;
+    static uint8_t tx_buf[1];
+
+    // Registry address in the first buffer, repeated start, then read
     seq.addr = MMA8653FC_SLAVE_ADDRESS_READ;
     tx_buf[0] = startRegAddr;
     seq.buf[0].data = tx_buf;
-    seq.buf[0].len = 7;
-    
-    rx_buf[0] = 0;
-    seq.buf[1].data = rx_buf;
-    seq.buf[1].len = rxBufLen;
-    seq.flags = I2C_FLAG_WRITE_READ;    
-    
-    // Read a value from MMA8653FC registry
-    ret = i2c_transaction(&seq);
-    //reg = ret->buf[1].data[0];
-    
-    info1("Read multiple - %u", reg);
+    seq.buf[0].len = 1;
 
+    // Receive straight into caller's buffer
+    seq.buf[1].data = rxBuf;
+    seq.buf[1].len = rxBufLen;
+    seq.flags = I2C_FLAG_WRITE_READ;
 
-    return ;
+    i2c_transaction(&seq);
+    transactionCount++;
 }
 
 /**
@@ -289,10 +766,8 @@ static void read_multiple_registries(uint8_t startRegAddr, uint8_t *rxBuf, uint1
  */
 int16_t convert_to_count(uint16_t raw_val)
 {
-    uint16_t res;
-    // TODO Convert raw sensor data to ADC readout (count) value
-
-    return res;
+    // Arithmetic shift keeps the sign, the 6 unused low bits drop out
+    return (int16_t)raw_val >> 6;
 }
 
 /**
@@ -309,8 +784,119 @@ int16_t convert_to_count(uint16_t raw_val)
  */
 float convert_to_g(uint16_t raw_val, uint8_t sensor_scale)
 {
-    float res;
-    // TODO Convert raw sensor data to g-force acceleration value
-    
-    return res;
+    // 512 counts per 2g, 4g or 8g
+    return (float)convert_to_count(raw_val) * (float)(2 << sensor_scale) / 512;
+}
+
+/**
+ * @brief   Converts a block of MMA8653FC output values (left-justified 10-bit 2's
+ *          complement numbers) to counts, see convert_to_count().
+ *
+ * @param raw_val   n left-justified 10-bit 2's complement numbers
+ * @param count     n results, -512 ... 511
+ */
+void convert_block_to_count(const uint16_t raw_val[], int16_t count[], uint32_t n)
+{
+    uint32_t i;
+
+    for (i = 0; i < n; i++)
+    {
+        count[i] = (int16_t)raw_val[i] >> 6;
+    }
+}
+
+/**
+ * @brief   Converts a block of MMA8653FC output values to Q15 fractions of the sensor
+ *          range (multiply by 2, 4 or 8 to get g). The output register layout already is
+ *          Q15, only the unused low bits are cleared.
+ *
+ * @param raw_val   n left-justified 10-bit 2's complement numbers
+ * @param q15       n results, -1.0 ... 0.998 in Q15
+ */
+void convert_block_to_q15(const uint16_t raw_val[], int16_t q15[], uint32_t n)
+{
+    uint32_t i;
+
+    for (i = 0; i < n; i++)
+    {
+        q15[i] = (int16_t)(raw_val[i] & 0xFFC0);
+    }
+}
+
+/*
+ * milli-g per count is 2000, 4000 or 8000 / 512, so mg = count * 1000 * 2^range / 256,
+ * rounded to nearest. One loop is generated per range, the scale is a compile time
+ * constant and the loop body is shift, multiply, add, shift without branches.
+ */
+#define CONVERT_BLOCK_TO_MG(name, range)                                             \
+static void convert_block_to_mg_##name(const uint16_t raw_val[], int16_t mg[], uint32_t n) \
+{                                                                                   \
+    uint32_t i;                                                                     \
+    for (i = 0; i < n; i++)                                                         \
+    {                                                                               \
+        int32_t count = (int16_t)raw_val[i] >> 6;                                   \
+        mg[i] = (int16_t)((count * (1000 << (range)) + 128) >> 8);                  \
+    }                                                                               \
+}
+
+CONVERT_BLOCK_TO_MG(2g, MMA8653FC_XYZ_DATA_CFG_2G_RANGE)
+CONVERT_BLOCK_TO_MG(4g, MMA8653FC_XYZ_DATA_CFG_4G_RANGE)
+CONVERT_BLOCK_TO_MG(8g, MMA8653FC_XYZ_DATA_CFG_8G_RANGE)
+
+/**
+ * @brief   Converts a block of MMA8653FC output values to acceleration in milli-g.
+ *
+ * @param raw_val       n left-justified 10-bit 2's complement numbers
+ * @param mg            n results, rounded to nearest milli-g
+ *                      +/- 2g  ->  range -2000 ... 1996
+ *                      +/- 4g  ->  range -4000 ... 3992
+ *                      +/- 8g  ->  range -8000 ... 7984
+ * @param sensor_scale  sensor scale 2g, 4g or 8g (MMA8653FC_XYZ_DATA_CFG_*_RANGE)
+ */
+void convert_block_to_mg(const uint16_t raw_val[], int16_t mg[], uint32_t n, uint8_t sensor_scale)
+{
+    switch (sensor_scale)
+    {
+        case MMA8653FC_XYZ_DATA_CFG_4G_RANGE:
+            convert_block_to_mg_4g(raw_val, mg, n);
+            break;
+        case MMA8653FC_XYZ_DATA_CFG_8G_RANGE:
+            convert_block_to_mg_8g(raw_val, mg, n);
+            break;
+        default:
+            convert_block_to_mg_2g(raw_val, mg, n);
+            break;
+    }
+}
+
+/**
+ * @brief   Converts MMA8653FC fast read mode output value (8-bit 2's complement, MSB
+ *          of the 10-bit value) to the 10-bit count scale used by convert_to_count(), so
+ *          results from both read modes can be compared. The two lowest bits are 0.
+ *
+ * @param raw_val   8-bit 2's complement number
+ *
+ * @return          decimal number ranging between -512 ... 508
+ */
+int16_t convert8_to_count(int8_t raw_val)
+{
+    return (int16_t)raw_val * 4;
+}
+
+/**
+ * @brief   Converts MMA8653FC fast read mode output value (8-bit 2's complement) to
+ *          floating point number representing acceleration rate in g.
+ *
+ * @param raw_val       8-bit 2's complement number
+ * @param sensor_scale  sensor scale 2g, 4g or 8g (MMA8653FC_XYZ_DATA_CFG_*_RANGE)
+ *
+ * @return          floating point number, value depending on chosen sensor range
+ *                  +/- 2g  ->  range -2 ... 1.984
+ *                  +/- 4g  ->  range -4 ... 3.969
+ *                  +/- 8g  ->  range -8 ... 7.938
+ */
+float convert8_to_g(int8_t raw_val, uint8_t sensor_scale)
+{
+    // 128 counts per 2g, 4g or 8g
+    return (float)raw_val * (float)(2 << sensor_scale) / 128;
 }
@@ -10,24 +10,113 @@
 #ifndef MMA8653FC_DRIVER_H_
 #define MMA8653FC_DRIVER_H_
 
+#include <stdint.h>
+
+#define MMA8653FC_BURST_LEN_NORMAL  7   // STATUS + OUT_X/Y/Z MSB and LSB
+#define MMA8653FC_BURST_LEN_FAST    4   // STATUS + OUT_X/Y/Z MSB
+
+#define MMA8653FC_RESOLUTION_NORMAL 10  // Bits of data in normal read mode
+#define MMA8653FC_RESOLUTION_FAST   8   // Bits of data in fast read mode
+
 typedef struct
 {
     uint8_t status;     // Status registry value
     uint16_t out_x;     // Left-justified 2's complement format
     uint16_t out_y;     // Left-justified 2's complement format
     uint16_t out_z;     // Left-justified 2's complement format
+    uint8_t resolution; // Valid bits in out_x/y/z, MMA8653FC_RESOLUTION_NORMAL or _FAST (lower bits are 0)
+    uint32_t stamp;     // sample_time_now() when the sample was ready, see sample_time.h
 } xyz_rawdata_t;
 
+// Fast read mode sample, MSB registries only
+typedef struct
+{
+    uint8_t status;     // Status registry value
+    int8_t out_x;       // 8 bit 2's complement
+    int8_t out_y;       // 8 bit 2's complement
+    int8_t out_z;       // 8 bit 2's complement
+} xyz_rawdata8_t;
+
+/**
+ * Complete sensor configuration, applied with mma_apply_config(). Declare it as a
+ * static const table with MMA8653FC_CONFIG() so that the field values are checked
+ * at compile time.
+ */
+#define MMA8653FC_CONFIG_BURST_LEN  6   // ASLP_COUNT (0x29) .. CTRL_REG5 (0x2E)
+
+typedef struct
+{
+    uint8_t xyz_data_cfg;                       // XYZ_DATA_CFG
+    uint8_t burst[MMA8653FC_CONFIG_BURST_LEN];  // ASLP_COUNT, CTRL_REG1 .. CTRL_REG5, written in one go
+} mma_config_t;
+
+/**
+ * @brief   Place a value in a registry bit field. The build fails (negative array size) if
+ *          the value does not fit in the field. Arguments must be compile-time constants
+ *          when used in a static initializer.
+ */
+#define MMA8653FC_FIELD(value, mask, shift) \
+    ((uint8_t)((((value) << (shift)) & (mask)) + \
+               0 * sizeof(char[((((value) << (shift)) & ~(mask)) == 0) ? 1 : -1])))
+
+/**
+ * @brief   Build a mma_config_t initializer. The sensor is left in standby, CTRL_REG1 ACTIVE
+ *          bit is never part of the table.
+ *
+ * @param   dataRate    MMA8653FC_CTRL_REG1_DR_*
+ * @param   range       MMA8653FC_XYZ_DATA_CFG_*_RANGE
+ * @param   powerMod    MMA8653FC_CTRL_REG2_POWMOD_*
+ * @param   polarity    MMA8653FC_CTRL_REG3_POLARITY_*
+ * @param   pinmode     MMA8653FC_CTRL_REG3_PINMODE_*
+ * @param   intEnable   Interrupts to enable, OR-ed MMA8653FC_CTRL_REG4_*_INT_MASK
+ * @param   intRoute    Interrupts routed to INT1, OR-ed MMA8653FC_CTRL_REG5_*_INTSEL_MASK (others go to INT2)
+ */
+#define MMA8653FC_CONFIG(dataRate, range, powerMod, polarity, pinmode, intEnable, intRoute) \
+{ \
+    .xyz_data_cfg = MMA8653FC_FIELD(range, MMA8653FC_XYZ_DATA_CFG_RANGE_MASK, MMA8653FC_XYZ_DATA_CFG_RANGE_SHIFT), \
+    .burst = \
+    { \
+        0, /* ASLP_COUNT */ \
+        MMA8653FC_FIELD(dataRate, MMA8653FC_CTRL_REG1_DATA_RATE_MASK, MMA8653FC_CTRL_REG1_DATA_RATE_SHIFT), \
+        MMA8653FC_FIELD(powerMod, MMA8653FC_CTRL_REG2_ACTIVEPOW_MASK, MMA8653FC_CTRL_REG2_ACTIVEPOW_SHIFT), \
+        MMA8653FC_FIELD(polarity, MMA8653FC_CTRL_REG3_POLARITY_MASK, MMA8653FC_CTRL_REG3_POLARITY_SHIFT) | \
+        MMA8653FC_FIELD(pinmode, MMA8653FC_CTRL_REG3_PINMODE_MASK, MMA8653FC_CTRL_REG3_PINMODE_SHIFT), \
+        MMA8653FC_FIELD(intEnable, MMA8653FC_CTRL_REG4_INT_EN_MASK, 0), \
+        MMA8653FC_FIELD(intRoute, MMA8653FC_CTRL_REG5_INTSEL_MASK, 0) \
+    } \
+}
+
 // Public functions
 uint8_t read_whoami();
+uint8_t read_int_source(void);
+uint8_t read_sysmod(void);
+uint8_t read_ff_mt_source(void);
 void sensor_reset (void);
 void set_sensor_active ();
 void set_sensor_standby ();
 int8_t configure_xyz_data (uint8_t dataRate, uint8_t range, uint8_t powerMod);
 int8_t configure_interrupt (uint8_t polarity, uint8_t pinmode, uint8_t interrupt, uint8_t int_select);
+int8_t mma_set_field(uint8_t regAddr, uint8_t mask, uint8_t shift, uint8_t value);
+uint8_t mma_get_field(uint8_t regAddr, uint8_t mask, uint8_t shift);
+int8_t mma_commit_config(void);
+int8_t mma_apply_config(const mma_config_t * cfg);
+uint32_t mma_get_transaction_count(void);
+
+int8_t mma_set_read_mode(uint8_t readMode);
+uint8_t mma_get_read_mode(void);
+uint8_t mma_burst_len(uint8_t readMode);
+uint32_t mma_get_data_rate_mhz(void);
 
 xyz_rawdata_t get_xyz_data();
+xyz_rawdata_t parse_xyz_data(const uint8_t rxBuf[], uint8_t readMode);
+xyz_rawdata8_t get_xyz_data8();
+xyz_rawdata8_t parse_xyz_data8(const uint8_t rxBuf[]);
 int16_t convert_to_count(uint16_t raw_val);
 float convert_to_g(uint16_t raw_val, uint8_t sensor_scale);
+void convert_block_to_count(const uint16_t raw_val[], int16_t count[], uint32_t n);
+void convert_block_to_q15(const uint16_t raw_val[], int16_t q15[], uint32_t n);
+void convert_block_to_mg(const uint16_t raw_val[], int16_t mg[], uint32_t n, uint8_t sensor_scale);
+int16_t convert8_to_count(int8_t raw_val);
+float convert8_to_g(int8_t raw_val, uint8_t sensor_scale);
 
 #endif // MMA8653FC_DRIVER_H_
@@ -33,7 +33,10 @@
 #define MMA8653FC_REGADDR_WHO_AM_I          0x0D
 #define MMA8653FC_REGADDR_XYZ_DATA_CFG      0x0E
 // TODO PL registries
-// TODO FF registries
+#define MMA8653FC_REGADDR_FF_MT_CFG         0x15
+#define MMA8653FC_REGADDR_FF_MT_SRC         0x16
+#define MMA8653FC_REGADDR_FF_MT_THS         0x17
+#define MMA8653FC_REGADDR_FF_MT_COUNT       0x18
 #define MMA8653FC_REGADDR_ASLP_COUNT        0x29
 #define MMA8653FC_REGADDR_CTRL_REG1         0x2A
 #define MMA8653FC_REGADDR_CTRL_REG2         0x2B
@@ -76,8 +79,47 @@
 #define MMA8653FC_XYZ_DATA_CFG_RANGE_SHIFT  0x00
 
 /* TODO PL registries bit fields */
-/* TODO FF_MT registries bit fields */
-/* TODO ASLP registry bit fields */
+/* Bit fields for MMA8653FC FF_MT_CFG registry */
+
+#define MMA8653FC_FF_MT_CFG_XEFE_MASK       0x08    // Event on X
+#define MMA8653FC_FF_MT_CFG_YEFE_MASK       0x10    // Event on Y
+#define MMA8653FC_FF_MT_CFG_ZEFE_MASK       0x20    // Event on Z
+#define MMA8653FC_FF_MT_CFG_AXES_MASK       0x38
+
+#define MMA8653FC_FF_MT_CFG_FREEFALL        0x00    // All enabled axes below the threshold (AND)
+#define MMA8653FC_FF_MT_CFG_MOTION          0x01    // Any enabled axis above the threshold (OR)
+#define MMA8653FC_FF_MT_CFG_OAE_MASK        0x40
+#define MMA8653FC_FF_MT_CFG_OAE_SHIFT       0x06
+
+#define MMA8653FC_FF_MT_CFG_ELE_EN          0x01    // Event flags latched until FF_MT_SRC is read
+#define MMA8653FC_FF_MT_CFG_ELE_MASK        0x80
+#define MMA8653FC_FF_MT_CFG_ELE_SHIFT       0x07
+
+/* Bit fields for MMA8653FC FF_MT_SRC registry */
+
+#define MMA8653FC_FF_MT_SRC_XHP_MASK        0x01    // Polarity of the X event, 1 - negative
+#define MMA8653FC_FF_MT_SRC_XHE_MASK        0x02
+#define MMA8653FC_FF_MT_SRC_YHP_MASK        0x04
+#define MMA8653FC_FF_MT_SRC_YHE_MASK        0x08
+#define MMA8653FC_FF_MT_SRC_ZHP_MASK        0x10
+#define MMA8653FC_FF_MT_SRC_ZHE_MASK        0x20
+#define MMA8653FC_FF_MT_SRC_EA_MASK         0x80    // Event active
+
+/* Bit fields for MMA8653FC FF_MT_THS registry */
+
+#define MMA8653FC_FF_MT_THS_MG_PER_LSB      63      // Threshold step, independent of the range
+#define MMA8653FC_FF_MT_THS_THS_MASK        0x7F
+#define MMA8653FC_FF_MT_THS_THS_SHIFT       0x00
+
+#define MMA8653FC_FF_MT_THS_DBCNTM_DEC      0x00    // Debounce counter counts down when the condition is false
+#define MMA8653FC_FF_MT_THS_DBCNTM_CLEAR    0x01    // Debounce counter is cleared when the condition is false
+#define MMA8653FC_FF_MT_THS_DBCNTM_MASK     0x80
+#define MMA8653FC_FF_MT_THS_DBCNTM_SHIFT    0x07
+
+/* ASLP_COUNT registry, inactivity time before sleep in steps of 320 ms (640 ms at 1.56 Hz) */
+
+#define MMA8653FC_ASLP_COUNT_STEP_MS        320
+#define MMA8653FC_ASLP_COUNT_STEP_MS_1HZ    640
 
 /* Bit fields for MMA8653FC CTRL_REG1 registry */
 
@@ -86,8 +128,8 @@
 #define MMA8653FC_CTRL_REG1_SAMODE_MASK     0x01
 #define MMA8653FC_CTRL_REG1_SAMODE_SHIFT    0x00
 
-#define MMA8653FC_CTRL_REG1_FAST_READ       0x00
-#define MMA8653FC_CTRL_REG1_NORMAL_READ     0x01
+#define MMA8653FC_CTRL_REG1_NORMAL_READ     0x00    // 10 bit data, STATUS + MSB/LSB pairs
+#define MMA8653FC_CTRL_REG1_FAST_READ       0x01    // 8 bit data, LSB registries are skipped on burst read
 #define MMA8653FC_CTRL_REG1_READ_MOD_MASK   0x02
 #define MMA8653FC_CTRL_REG1_READ_MOD_SHIFT  0x01
 
@@ -172,6 +214,9 @@
 #define MMA8653FC_CTRL_REG4_ASLP_INT_MASK   0x80
 #define MMA8653FC_CTRL_REG4_ASLP_INT_SHIFT  0x07
 
+#define MMA8653FC_CTRL_REG4_INT_EN_MASK     (MMA8653FC_CTRL_REG4_DRDY_INT_MASK | MMA8653FC_CTRL_REG4_FFMT_INT_MASK | \
+                                             MMA8653FC_CTRL_REG4_LP_INT_MASK | MMA8653FC_CTRL_REG4_ASLP_INT_MASK)
+
 /* Bit fields for MMA8653FC CTRL_REG5 registry */
 
 #define MMA8653FC_CTRL_REG5_DRDY_INTSEL_INT1    0x01
@@ -194,6 +239,9 @@
 #define MMA8653FC_CTRL_REG5_ASLP_INTSEL_MASK    0x80
 #define MMA8653FC_CTRL_REG5_ASLP_INTSEL_SHIFT   0x07
 
+#define MMA8653FC_CTRL_REG5_INTSEL_MASK         (MMA8653FC_CTRL_REG5_DRDY_INTSEL_MASK | MMA8653FC_CTRL_REG5_FFMT_INTSEL_MASK | \
+                                                 MMA8653FC_CTRL_REG5_LP_INTSEL_MASK | MMA8653FC_CTRL_REG5_ASLP_INTSEL_MASK)
+
 /* TODO Bit fields for MMA8653FC OFFSET registries */
 
 #endif // MMA8653FC_REG_H_
@@ -0,0 +1,325 @@
+/**
+ * @file mma_acq.c
+ *
+ * @brief   Burst acquisition of MMA8653FC STATUS and xyz data into a ring of raw sample slots.
+ *
+ * @details The data ready interrupt calls mma_acq_trigger(), which starts a transfer channel
+ *          reading the STATUS+OUT_* burst (7 bytes, 4 in fast read mode) straight into the next
+ *          free slot of the ring. With the LDMA channel the CPU only runs at the start and at
+ *          the end of each transfer, with the I2C channel the transfer is stepped in the I2C0
+ *          interrupt. No thread runs per sample.
+ *
+ *          The ring is a lock-free single-producer/single-consumer ring (spsc_ring), the
+ *          producer is the interrupt side, the consumer is one thread. The consumer is woken
+ *          once per batch of samples (or on timeout) and unpacks them with mma_acq_get().
+ *
+ *          INT1 stays asserted until the sample is read, every data ready edge must lead to
+ *          a read or there is no further edge. With the ring full the burst is read into a
+ *          slot that is thrown away. A burst that could not be started (bus busy) or failed
+ *          is read again by the consumer thread in mma_acq_poll() while INT1 is held.
+ *
+ * @author agent
+ * @license MIT
+ *
+ * Copyright agent, 2026
+ */
+
+#include "em_core.h"
+#include "em_gpio.h"
+#include "em_i2c.h"
+
+#include "i2c_handler.h"
+#include "gpio_handler.h"
+#include "sample_time.h"
+#include "mma8653fc_reg.h"
+#include "spsc_ring.h"
+#include "mma_acq.h"
+
+#include "loglevels.h"
+#define __MODUUL__ "acq"
+#define __LOG_LEVEL__ (LOG_LEVEL_mmadrv & BASE_LOG_LEVEL)
+#include "log.h"
+
+static mma_acq_slot_t ringStorage[MMA_ACQ_RING_SLOTS];
+static spsc_ring_t ring;
+static mma_acq_slot_t dropSlot;             // Burst read with the ring full, released INT1 only
+static mma_acq_slot_t * volatile fillSlot;  // Slot the channel is writing to, NULL if channel is idle
+static volatile uint8_t acqReadMode = MMA8653FC_CTRL_REG1_NORMAL_READ;
+static volatile bool retriggerPending;      // A trigger was not read, mma_acq_poll() checks INT1
+static uint8_t int1Active;                  // INT1 pin level while asserted
+static osThreadId_t consumerId;
+static uint32_t consumerFlag;
+
+static volatile uint32_t busyMisses;        // Triggers lost because the previous burst was still running
+static volatile uint32_t errors;            // Failed transfers
+static volatile uint32_t retriggers;        // Reads started by mma_acq_poll()
+
+static const mma_acq_channel_t * acqChannel;
+
+#if STAGE_TRACE
+static uint32_t lastTraceT0;                // Stamp of the sample last taken with mma_acq_get()
+#endif
+
+static void mma_acq_done(int8_t status);
+static int8_t acq_i2c_start(uint8_t regAddr, uint8_t * dst, uint16_t len, mma_acq_done_f done);
+
+// Interrupt driven I2C channel (i2c_transaction_submit)
+const mma_acq_channel_t mma_acq_i2c_channel = { .start = acq_i2c_start };
+
+static I2C_TransferSeq_TypeDef acqI2cSeq;
+static uint8_t acqI2cRegAddr;
+static mma_acq_done_f acqI2cDone;
+
+static bool int1_held (void)
+{
+    return GPIO_PinInGet(MMA8653FC_INT1_PORT, MMA8653FC_INT1_PIN) == int1Active;
+}
+
+// A trigger was not read, the consumer thread starts the read while INT1 is held
+static void retrigger_request (void)
+{
+    retriggerPending = true;
+    if (consumerId != NULL)
+    {
+        osThreadFlagsSet(consumerId, consumerFlag);
+    }
+}
+
+/**
+ * @brief   Initialize acquisition ring, call after mma_apply_config().
+ *
+ * @param   channel Transfer channel to read sensor registers with.
+ * @param   tID Consumer thread, signalled when a batch of samples is available.
+ * @param   tFlag Thread flag to set for tID.
+ * @param   batch Number of samples to collect before signalling tID.
+ */
+void mma_acq_init (const mma_acq_channel_t * channel, osThreadId_t tID, uint32_t tFlag, uint32_t batch)
+{
+    acqChannel = channel;
+    spsc_ring_init(&ring, ringStorage, MMA_ACQ_RING_SLOTS, sizeof(mma_acq_slot_t));
+    spsc_ring_set_notify(&ring, tID, tFlag, batch);
+    consumerId = tID;
+    consumerFlag = tFlag;
+    int1Active = mma_get_field(MMA8653FC_REGADDR_CTRL_REG3, MMA8653FC_CTRL_REG3_POLARITY_MASK, MMA8653FC_CTRL_REG3_POLARITY_SHIFT);
+    fillSlot = NULL;
+    retriggerPending = false;
+    busyMisses = errors = retriggers = 0;
+}
+
+/**
+ * @brief   Set burst length for the sensor read mode, 7 bytes in normal and 4 bytes in
+ *          fast read mode. Must follow mma_set_read_mode().
+ *
+ * @param   readMode MMA8653FC_CTRL_REG1_NORMAL_READ or MMA8653FC_CTRL_REG1_FAST_READ
+ */
+void mma_acq_set_read_mode (uint8_t readMode)
+{
+    acqReadMode = readMode;
+}
+
+/**
+ * @brief   Start reading one sample into the ring. Called on sensor data ready interrupt.
+ *
+ * @param   stamp Time of the interrupt, kept with the sample.
+ */
+void mma_acq_trigger (uint32_t stamp)
+{
+    mma_acq_slot_t * slot;
+#if STAGE_TRACE
+    uint32_t t0 = STAGE_TRACE_NOW();
+#endif
+
+    if (fillSlot != NULL)
+    {
+        // Previous burst is still on the bus, sample is lost. Its completion wakes the
+        // consumer, which reads the sample if INT1 is still held.
+        busyMisses++;
+        retriggerPending = true;
+        return;
+    }
+
+    slot = spsc_ring_reserve(&ring);
+    if (slot == NULL)
+    {
+        // Consumer has fallen behind, counted as ring overrun. The burst is still read so
+        // that the sensor releases INT1 and signals the next sample.
+        slot = &dropSlot;
+    }
+
+    slot->readMode = acqReadMode;
+    slot->stamp = stamp;
+#if STAGE_TRACE
+    slot->traceT0 = t0;
+#endif
+    fillSlot = slot;
+    if (acqChannel->start(MMA8653FC_REGADDR_STATUS, slot->raw,
+                          mma_burst_len(slot->readMode), mma_acq_done) != 0)
+    {
+        fillSlot = NULL;
+        busyMisses++;
+        retrigger_request();
+        return;
+    }
+#if STAGE_TRACE
+    STAGE_TRACE_MARK(STAGE_TRACE_IRQ, t0);
+#endif
+}
+
+/**
+ * @brief   Channel completion, publishes the filled slot.
+ */
+static void mma_acq_done (int8_t status)
+{
+    mma_acq_slot_t * slot = fillSlot;
+
+#if STAGE_TRACE
+    STAGE_TRACE_MARK(STAGE_TRACE_READ, slot->traceT0);
+#endif
+    fillSlot = NULL;
+    if (status != 0)
+    {
+        errors++;
+        retrigger_request();
+        return;
+    }
+    if (slot != &dropSlot)
+    {
+        spsc_ring_commit(&ring);
+    }
+    if (retriggerPending)
+    {
+        retrigger_request();
+    }
+}
+
+/**
+ * @brief   Read the sample of a trigger that was not read, if INT1 is still held (consumer,
+ *          after mma_acq_wait()). Without the read the sensor gives no further data ready edge.
+ */
+void mma_acq_poll (void)
+{
+    CORE_DECLARE_IRQ_STATE;
+
+    if (!retriggerPending)
+    {
+        return;
+    }
+    CORE_ENTER_ATOMIC();
+    if (retriggerPending && !mma_acq_busy())
+    {
+        retriggerPending = false;
+        if (int1_held())
+        {
+            retriggers++;
+            mma_acq_trigger(sample_time_now());
+        }
+    }
+    CORE_EXIT_ATOMIC();
+}
+
+/**
+ * @brief   Wait for a batch of samples.
+ *
+ * @param   timeout Kernel ticks to wait for a full batch.
+ *
+ * @return  Number of samples in the ring.
+ */
+uint32_t mma_acq_wait (uint32_t timeout)
+{
+    return spsc_ring_wait(&ring, timeout);
+}
+
+/**
+ * @brief   Take the oldest sample from the ring.
+ *
+ * @param   data Unpacked sample.
+ *
+ * @return  false if the ring is empty
+ */
+bool mma_acq_get (xyz_rawdata_t * data)
+{
+    mma_acq_slot_t * slot = spsc_ring_peek(&ring);
+
+    if (slot == NULL)
+    {
+        return false;
+    }
+    *data = parse_xyz_data(slot->raw, slot->readMode);
+    data->stamp = slot->stamp;
+#if STAGE_TRACE
+    lastTraceT0 = slot->traceT0;
+    STAGE_TRACE_MARK(STAGE_TRACE_WAKE, lastTraceT0);
+#endif
+    spsc_ring_release(&ring);
+    return true;
+}
+
+/**
+ * @brief   A burst read is running.
+ */
+bool mma_acq_busy (void)
+{
+    return fillSlot != NULL;
+}
+
+/**
+ * @brief   Samples lost, ring full or previous burst still running.
+ */
+uint32_t mma_acq_overruns (void)
+{
+    return spsc_ring_overruns(&ring) + busyMisses;
+}
+
+/**
+ * @brief   Highest number of samples that have been waiting in the ring.
+ */
+uint32_t mma_acq_high_water (void)
+{
+    return spsc_ring_high_water(&ring);
+}
+
+uint32_t mma_acq_errors (void)
+{
+    return errors;
+}
+
+/**
+ * @brief   Reads started by mma_acq_poll() after a lost trigger.
+ */
+uint32_t mma_acq_retriggers (void)
+{
+    return retriggers;
+}
+
+#if STAGE_TRACE
+/**
+ * @brief   STAGE_TRACE_NOW() stamp of the sample last taken with mma_acq_get() (consumer).
+ */
+uint32_t mma_acq_trace_t0 (void)
+{
+    return lastTraceT0;
+}
+#endif
+
+static void acq_i2c_done (I2C_TransferSeq_TypeDef * seq, I2C_TransferReturn_TypeDef ret, void * ctx)
+{
+    acqI2cDone((ret == i2cTransferDone) ? 0 : -1);
+}
+
+/**
+ * @brief   Start a register burst read with an interrupt driven I2C transfer.
+ */
+static int8_t acq_i2c_start (uint8_t regAddr, uint8_t * dst, uint16_t len, mma_acq_done_f done)
+{
+    acqI2cRegAddr = regAddr;
+    acqI2cDone = done;
+
+    acqI2cSeq.addr = MMA8653FC_SLAVE_ADDRESS_READ;
+    acqI2cSeq.buf[0].data = &acqI2cRegAddr;
+    acqI2cSeq.buf[0].len = 1;
+    acqI2cSeq.buf[1].data = dst;
+    acqI2cSeq.buf[1].len = len;
+    acqI2cSeq.flags = I2C_FLAG_WRITE_READ;
+
+    return i2c_transaction_submit(&acqI2cSeq, acq_i2c_done, NULL);
+}
@@ -0,0 +1,70 @@
+/**
+ * @file mma_acq.h
+ *
+ * @author agent
+ * @license MIT
+ *
+ * Copyright agent, 2026
+ */
+
+#ifndef MMA_ACQ_H_
+#define MMA_ACQ_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "cmsis_os2.h"
+#include "mma8653fc_driver.h"
+#include "stage_trace.h"
+
+#define MMA_ACQ_RING_SLOTS  16  // Must be a power of two
+#define MMA_ACQ_BURST_LEN   MMA8653FC_BURST_LEN_NORMAL  // Longest burst, STATUS + OUT_X/Y/Z MSB and LSB
+
+/**
+ * @brief Called by the channel when a burst has been read (interrupt context).
+ *
+ * @param status 0 on success, -1 on bus error
+ */
+typedef void (*mma_acq_done_f)(int8_t status);
+
+/**
+ * @brief Transfer channel that moves a register burst from the sensor into memory
+ *        without CPU involvement (LDMA on target, a stand-in on host builds).
+ */
+typedef struct
+{
+    // Start reading len bytes starting from sensor register regAddr into dst, call done when finished.
+    // Returns -1 if the channel is busy.
+    int8_t (*start)(uint8_t regAddr, uint8_t * dst, uint16_t len, mma_acq_done_f done);
+} mma_acq_channel_t;
+
+typedef struct
+{
+    uint8_t raw[MMA_ACQ_BURST_LEN]; // Register values as read from the sensor
+    uint8_t readMode;               // Sensor read mode when the burst was read
+    uint32_t stamp;                 // sample_time_now() at the data ready interrupt
+#if STAGE_TRACE
+    uint32_t traceT0;               // STAGE_TRACE_NOW() at the data ready interrupt
+#endif
+} mma_acq_slot_t;
+
+// Acquisition channel reading MMA8653FC registers with interrupt driven I2C transfers
+extern const mma_acq_channel_t mma_acq_i2c_channel;
+
+// Public functions
+void mma_acq_init(const mma_acq_channel_t * channel, osThreadId_t tID, uint32_t tFlag, uint32_t batch);
+void mma_acq_set_read_mode(uint8_t readMode);
+void mma_acq_trigger(uint32_t stamp);
+uint32_t mma_acq_wait(uint32_t timeout);
+bool mma_acq_get(xyz_rawdata_t * data);
+void mma_acq_poll(void);
+bool mma_acq_busy(void);
+uint32_t mma_acq_overruns(void);
+uint32_t mma_acq_high_water(void);
+uint32_t mma_acq_errors(void);
+uint32_t mma_acq_retriggers(void);
+#if STAGE_TRACE
+uint32_t mma_acq_trace_t0(void);
+#endif
+
+#endif // MMA_ACQ_H_
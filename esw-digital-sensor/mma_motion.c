@@ -0,0 +1,309 @@
+/**
+ * @file mma_motion.c
+ *
+ * @brief   Motion gated acquisition with the MMA8653FC freefall/motion and auto-sleep engines.
+ *
+ * @details Both configurations are kept as field changes on the driver shadow, a switch is
+ *          one mma_commit_config(): standby, the changed registries, active. The switches
+ *          are done by the acquisition thread in mma_motion_poll(), the data ready interrupt
+ *          only looks at the state. Edges that come while the sensor is reconfigured are
+ *          ignored; a latched motion event that came then still holds INT1 and is found by
+ *          the check after arming.
+ *
+ * MMA8653FC datasheet (FF_MT p27, auto-wake/sleep p22)
+ * https://www.nxp.com/docs/en/data-sheet/MMA8653FC.pdf
+ *
+ * @author agent
+ * @license MIT
+ *
+ * Copyright agent, 2026
+ */
+
+#include <inttypes.h>
+
+#include "em_core.h"
+#include "em_gpio.h"
+
+#include "mma8653fc_driver.h"
+#include "gpio_handler.h"
+#include "mma_acq.h"
+#include "sample_time.h"
+#include "sample_window.h"
+#include "mma_motion.h"
+
+#include "loglevels.h"
+#define __MODUUL__ "motn"
+#define __LOG_LEVEL__ (LOG_LEVEL_mmadrv & BASE_LOG_LEVEL)
+#include "log.h"
+
+static volatile uint8_t state = MMA_MOTION_SWITCHING;
+static osThreadId_t threadId;
+static uint32_t threadFlag;
+static uint8_t acqDataRate;         // CTRL_REG1 DR of the configuration
+static uint8_t int1Active;          // INT1 pin level while asserted
+
+// Set in the data ready interrupt
+static volatile bool onsetPending;
+static volatile uint32_t onsetStamp;
+static volatile bool firstPending;  // First sample after an onset not yet seen
+static uint32_t latencyRuns;
+static uint32_t latencyTotal;
+static uint32_t latencyMax;
+
+// Acquisition thread
+static uint32_t onsets;
+static uint32_t sleeps;
+static uint32_t checks;
+static uint32_t discarded;
+
+// Time acquiring since the previous mma_motion_stats(), updated with interrupts disabled
+static bool acquiringTime;
+static uint32_t accountStamp;
+static uint32_t acquiringTicks;
+static uint32_t statsStamp;
+
+static void motion_enter(mma_motion_state_t next, bool commit);
+
+static bool int1_held (void)
+{
+    return GPIO_PinInGet(MMA8653FC_INT1_PORT, MMA8653FC_INT1_PIN) == int1Active;
+}
+
+/**
+ * @brief   Set up the motion and auto-sleep engines, call after mma_apply_config() with the
+ *          sensor in standby. Acquisition starts with set_sensor_active(), the sensor is armed
+ *          after MMA_MOTION_SLEEP_MS without motion.
+ *
+ * @param   tID Acquisition thread, signalled when motion is detected.
+ * @param   tFlag Thread flag to set for tID, mma_acq_wait() returns on it.
+ *
+ * @return  -1 if the threshold or the sleep time does not fit in the sensor registries
+ *           0 otherwise
+ */
+int8_t mma_motion_init (osThreadId_t tID, uint32_t tFlag)
+{
+    uint32_t ths = (MMA_MOTION_THS_MG + MMA8653FC_FF_MT_THS_MG_PER_LSB / 2) / MMA8653FC_FF_MT_THS_MG_PER_LSB;
+    uint32_t step, aslpCount;
+
+    threadId = tID;
+    threadFlag = tFlag;
+    acqDataRate = mma_get_field(MMA8653FC_REGADDR_CTRL_REG1, MMA8653FC_CTRL_REG1_DATA_RATE_MASK, MMA8653FC_CTRL_REG1_DATA_RATE_SHIFT);
+    int1Active = mma_get_field(MMA8653FC_REGADDR_CTRL_REG3, MMA8653FC_CTRL_REG3_POLARITY_MASK, MMA8653FC_CTRL_REG3_POLARITY_SHIFT);
+
+    step = (acqDataRate == MMA8653FC_CTRL_REG1_DR_1HZ) ? MMA8653FC_ASLP_COUNT_STEP_MS_1HZ : MMA8653FC_ASLP_COUNT_STEP_MS;
+    aslpCount = (MMA_MOTION_SLEEP_MS + step - 1) / step;
+    if ((ths == 0) || (ths > MMA8653FC_FF_MT_THS_THS_MASK) || (aslpCount == 0) || (aslpCount > 0xFF))
+    {
+        err1("Motion threshold %u mg or sleep time %u ms out of range", MMA_MOTION_THS_MG, MMA_MOTION_SLEEP_MS);
+        return -1;
+    }
+
+    // Motion on any of the axes, the debounce counter restarts when the condition is false
+    mma_set_field(MMA8653FC_REGADDR_FF_MT_CFG, MMA8653FC_FF_MT_CFG_AXES_MASK, 0, MMA_MOTION_AXES);
+    mma_set_field(MMA8653FC_REGADDR_FF_MT_CFG, MMA8653FC_FF_MT_CFG_OAE_MASK, MMA8653FC_FF_MT_CFG_OAE_SHIFT, MMA8653FC_FF_MT_CFG_MOTION);
+    mma_set_field(MMA8653FC_REGADDR_FF_MT_THS, MMA8653FC_FF_MT_THS_THS_MASK, MMA8653FC_FF_MT_THS_THS_SHIFT, (uint8_t)ths);
+    mma_set_field(MMA8653FC_REGADDR_FF_MT_THS, MMA8653FC_FF_MT_THS_DBCNTM_MASK, MMA8653FC_FF_MT_THS_DBCNTM_SHIFT, MMA8653FC_FF_MT_THS_DBCNTM_CLEAR);
+    mma_set_field(MMA8653FC_REGADDR_FF_MT_COUNT, 0xFF, 0, MMA_MOTION_COUNT);
+
+    // Inactivity timer, motion events restart it, sleep power mode as in wake
+    mma_set_field(MMA8653FC_REGADDR_ASLP_COUNT, 0xFF, 0, (uint8_t)aslpCount);
+    mma_set_field(MMA8653FC_REGADDR_CTRL_REG1, MMA8653FC_CTRL_REG1_ASPL_DR_MASK, MMA8653FC_CTRL_REG1_ASPL_DR_SHIFT, MMA_MOTION_SLEEP_DR);
+    mma_set_field(MMA8653FC_REGADDR_CTRL_REG2, MMA8653FC_CTRL_REG2_SLEEPPOW_MASK, MMA8653FC_CTRL_REG2_SLEEPPOW_SHIFT,
+                  mma_get_field(MMA8653FC_REGADDR_CTRL_REG2, MMA8653FC_CTRL_REG2_ACTIVEPOW_MASK, MMA8653FC_CTRL_REG2_ACTIVEPOW_SHIFT));
+    mma_set_field(MMA8653FC_REGADDR_CTRL_REG3, MMA8653FC_CTRL_REG3_WAKE_FFMT_MASK, MMA8653FC_CTRL_REG3_WAKE_FFMT_SHIFT, MMA8653FC_CTRL_REG3_WAKE_FFMT_EN);
+
+    motion_enter(MMA_MOTION_ACQUIRING, false);
+    statsStamp = accountStamp;
+    info1("Motion %u mg, sleep after %"PRIu32" ms", (unsigned)(ths * MMA8653FC_FF_MT_THS_MG_PER_LSB), aslpCount * step);
+    return 0;
+}
+
+// Registry fields of a state, committed by the caller
+static void motion_fields (mma_motion_state_t next)
+{
+    bool acquiring = (next == MMA_MOTION_ACQUIRING);
+
+    mma_set_field(MMA8653FC_REGADDR_CTRL_REG1, MMA8653FC_CTRL_REG1_DATA_RATE_MASK, MMA8653FC_CTRL_REG1_DATA_RATE_SHIFT,
+                  acquiring ? acqDataRate : MMA_MOTION_ARMED_DR);
+    mma_set_field(MMA8653FC_REGADDR_CTRL_REG2, MMA8653FC_CTRL_REG2_ASLEEP_MASK, MMA8653FC_CTRL_REG2_ASLEEP_SHIFT,
+                  acquiring ? MMA8653FC_CTRL_REG2_ASLEEP_EN : 0);
+    mma_set_field(MMA8653FC_REGADDR_FF_MT_CFG, MMA8653FC_FF_MT_CFG_ELE_MASK, MMA8653FC_FF_MT_CFG_ELE_SHIFT,
+                  acquiring ? 0 : MMA8653FC_FF_MT_CFG_ELE_EN);
+    if (acquiring)
+    {
+        // Motion keeps the sensor awake through INT2, which is not wired
+        mma_set_field(MMA8653FC_REGADDR_CTRL_REG4, MMA8653FC_CTRL_REG4_INT_EN_MASK, 0,
+                      MMA8653FC_CTRL_REG4_DRDY_INT_MASK | MMA8653FC_CTRL_REG4_FFMT_INT_MASK | MMA8653FC_CTRL_REG4_ASLP_INT_MASK);
+        mma_set_field(MMA8653FC_REGADDR_CTRL_REG5, MMA8653FC_CTRL_REG5_INTSEL_MASK, 0,
+                      MMA8653FC_CTRL_REG5_DRDY_INTSEL_MASK | MMA8653FC_CTRL_REG5_ASLP_INTSEL_MASK);
+    }
+    else
+    {
+        mma_set_field(MMA8653FC_REGADDR_CTRL_REG4, MMA8653FC_CTRL_REG4_INT_EN_MASK, 0, MMA8653FC_CTRL_REG4_FFMT_INT_MASK);
+        mma_set_field(MMA8653FC_REGADDR_CTRL_REG5, MMA8653FC_CTRL_REG5_INTSEL_MASK, 0, MMA8653FC_CTRL_REG5_FFMT_INTSEL_MASK);
+    }
+}
+
+// Count the time acquiring up to now, interrupts must be disabled
+static void motion_account (uint32_t now)
+{
+    if (acquiringTime)
+    {
+        acquiringTicks += now - accountStamp;
+    }
+    accountStamp = now;
+}
+
+// Reconfigure the sensor for next, commit - the sensor is active and must stay so
+static void motion_enter (mma_motion_state_t next, bool commit)
+{
+    CORE_DECLARE_IRQ_STATE;
+
+    state = MMA_MOTION_SWITCHING;
+    motion_fields(next);
+    if (commit)
+    {
+        mma_set_field(MMA8653FC_REGADDR_CTRL_REG1, MMA8653FC_CTRL_REG1_SAMODE_MASK, MMA8653FC_CTRL_REG1_SAMODE_SHIFT, MMA8653FC_CTRL_REG1_SAMODE_ACTIVE);
+        if (mma_commit_config() != 0)
+        {
+            // The failed registries stay dirty, the next switch writes them again
+            warn1("Sensor reconfiguration failed");
+        }
+    }
+
+    CORE_ENTER_ATOMIC();
+    motion_account(sample_time_now());
+    acquiringTime = (next == MMA_MOTION_ACQUIRING);
+    state = next;
+    CORE_EXIT_ATOMIC();
+}
+
+/**
+ * @brief   Data ready interrupt of the sensor (INT1), register it in place of mma_acq_trigger().
+ *
+ * @param   stamp Time of the interrupt.
+ */
+void mma_motion_irq (uint32_t stamp)
+{
+    switch (state)
+    {
+        case MMA_MOTION_ACQUIRING:
+            if (firstPending)
+            {
+                uint32_t latency = stamp - onsetStamp;
+
+                firstPending = false;
+                latencyRuns++;
+                latencyTotal += latency;
+                if (latency > latencyMax)
+                {
+                    latencyMax = latency;
+                }
+            }
+            mma_acq_trigger(stamp);
+            break;
+        case MMA_MOTION_ARMED:
+            if (!onsetPending)
+            {
+                onsetStamp = stamp;
+                onsetPending = true;
+                osThreadFlagsSet(threadId, threadFlag);
+            }
+            break;
+        default:
+            break;
+    }
+}
+
+/**
+ * @brief   Switch the sensor between armed and acquiring (acquisition thread), call whenever
+ *          mma_acq_wait() returns.
+ */
+void mma_motion_poll (void)
+{
+    CORE_DECLARE_IRQ_STATE;
+
+    if (state == MMA_MOTION_ARMED)
+    {
+        if (onsetPending || int1_held())
+        {
+            // Clear the latched event, the line is released
+            read_ff_mt_source();
+            if (!onsetPending)
+            {
+                // Came while the sensor was being armed
+                onsetStamp = sample_time_now();
+            }
+            // The last armed sample is never read, with ZYXDR set the data ready source
+            // would hold INT1 from the start and give no edge.
+            (void)get_xyz_data();
+            sample_time_restart();
+            firstPending = true;
+            motion_enter(MMA_MOTION_ACQUIRING, true);
+            onsetPending = false;
+            onsets++;
+        }
+    }
+    else if ((state == MMA_MOTION_ACQUIRING) && int1_held())
+    {
+        uint8_t src = read_int_source();
+
+        if ((src & MMA8653FC_INT_SOURCE_ASLP_MASK) && (read_sysmod() == MMA8653FC_SYSMOD_MOD_SLEEP))
+        {
+            // Events of the acquiring period must not trigger the armed sensor
+            read_ff_mt_source();
+            motion_enter(MMA_MOTION_ARMED, true);
+            firstPending = false;
+            discarded += sample_window_discard();
+            sleeps++;
+            debug1("Armed");
+            return;
+        }
+
+        // Woken again before the sleep was noticed, or a data ready edge was lost: read
+        // the sample so that the line is released.
+        checks++;
+        CORE_ENTER_ATOMIC();
+        if (int1_held() && !mma_acq_busy())
+        {
+            mma_acq_trigger(sample_time_now());
+        }
+        CORE_EXIT_ATOMIC();
+    }
+}
+
+mma_motion_state_t mma_motion_state (void)
+{
+    return (mma_motion_state_t)state;
+}
+
+/**
+ * @brief   Counters since start, time acquiring and onset latency since the previous call
+ *          (acquisition or heartbeat thread).
+ */
+void mma_motion_stats (mma_motion_stats_t * stats)
+{
+    uint32_t now, period, acq, runs, total, max;
+    CORE_DECLARE_IRQ_STATE;
+
+    CORE_ENTER_ATOMIC();
+    now = sample_time_now();
+    motion_account(now);
+    acq = acquiringTicks;
+    period = now - statsStamp;
+    acquiringTicks = 0;
+    statsStamp = now;
+    runs = latencyRuns;
+    total = latencyTotal;
+    max = latencyMax;
+    latencyRuns = latencyTotal = latencyMax = 0;
+    CORE_EXIT_ATOMIC();
+
+    stats->onsets = onsets;
+    stats->sleeps = sleeps;
+    stats->checks = checks;
+    stats->discarded = discarded;
+    stats->acquiringPct = (period > 0) ? (uint32_t)((uint64_t)acq * 100 / period) : 0;
+    stats->latencyMeanMs = (runs > 0) ? (uint32_t)((uint64_t)total * 1000 / SAMPLE_TIME_HZ / runs) : 0;
+    stats->latencyMaxMs = (uint32_t)((uint64_t)max * 1000 / SAMPLE_TIME_HZ);
+}
@@ -0,0 +1,85 @@
+/**
+ * @file mma_motion.h
+ *
+ * @brief   Motion gated acquisition with the MMA8653FC freefall/motion (FF_MT) and
+ *          auto-sleep (ASLP) engines.
+ *
+ * @details Only INT1 of the sensor is wired, so data ready and motion can not both have their
+ *          own edge. The sensor is switched between two configurations:
+ *          - armed: the sensor runs at MMA_MOTION_ARMED_DR with only the FF_MT interrupt
+ *            on INT1, latched. Nothing is read, the I2C bus and the MCU stay idle.
+ *          - acquiring: data ready on INT1 at the configured rate like without motion gating.
+ *            Auto-sleep is enabled with FF_MT as its wake source (FF_MT routed to the unwired
+ *            INT2), so every motion event restarts the ASLP_COUNT inactivity timer in the
+ *            sensor. When it expires the sensor goes to sleep and asserts the ASLP source
+ *            on INT1, which holds the line and stops the data ready edges.
+ *          The FF_MT interrupt of the armed sensor switches to acquiring, the acquisition
+ *          thread notices the held line, confirms sleep from INT_SOURCE and arms the sensor
+ *          again. Motion is any of the MMA_MOTION_AXES above MMA_MOTION_THS_MG, on
+ *          MMA_MOTION_COUNT + 1 consecutive samples.
+ *
+ *          Onset latency, from the FF_MT interrupt to the data ready interrupt of the first
+ *          acquired sample, is measured with the sample timestamps. Motion starts up to
+ *          (MMA_MOTION_COUNT + 1) armed sample periods before the FF_MT interrupt.
+ *
+ *          Partial analysis windows are discarded when acquisition stops, the sample timing
+ *          estimator restarts when it resumes.
+ *
+ * @author agent
+ * @license MIT
+ *
+ * Copyright agent, 2026
+ */
+
+#ifndef MMA_MOTION_H_
+#define MMA_MOTION_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "cmsis_os2.h"
+#include "mma8653fc_reg.h"
+
+#ifndef MMA_MOTION
+#define MMA_MOTION              0       // Set from the Makefile
+#endif
+
+#ifndef MMA_MOTION_THS_MG
+#define MMA_MOTION_THS_MG       126     // Set from the Makefile
+#endif
+
+#ifndef MMA_MOTION_SLEEP_MS
+#define MMA_MOTION_SLEEP_MS     10000   // Set from the Makefile
+#endif
+
+#define MMA_MOTION_AXES         (MMA8653FC_FF_MT_CFG_XEFE_MASK | MMA8653FC_FF_MT_CFG_YEFE_MASK) // Z has gravity, board lies flat
+#define MMA_MOTION_COUNT        1       // Debounce, samples above the threshold before the event
+#define MMA_MOTION_ARMED_DR     MMA8653FC_CTRL_REG1_DR_1HZ      // Output data rate while armed
+#define MMA_MOTION_SLEEP_DR     MMA8653FC_CTRL_REG1_ASLP_DR_1Hz // Until the sleep is noticed, not read
+
+typedef enum
+{
+    MMA_MOTION_ARMED = 0,       // Waiting for motion
+    MMA_MOTION_ACQUIRING,       // Reading every sample
+    MMA_MOTION_SWITCHING        // Sensor being reconfigured by the acquisition thread
+} mma_motion_state_t;
+
+typedef struct
+{
+    uint32_t onsets;            // Armed to acquiring, since start
+    uint32_t sleeps;            // Acquiring to armed, since start
+    uint32_t checks;            // Held INT1 without the sleep source, since start
+    uint32_t discarded;         // Samples in partial windows dropped, since start
+    uint32_t acquiringPct;      // Time acquiring since the previous call
+    uint32_t latencyMeanMs;     // Onset latency since the previous call
+    uint32_t latencyMaxMs;
+} mma_motion_stats_t;
+
+// Public functions
+int8_t mma_motion_init(osThreadId_t tID, uint32_t tFlag);
+void mma_motion_irq(uint32_t stamp);
+void mma_motion_poll(void);
+mma_motion_state_t mma_motion_state(void);
+void mma_motion_stats(mma_motion_stats_t * stats);
+
+#endif // MMA_MOTION_H_
@@ -0,0 +1,244 @@
+/**
+ * @file sample_stream.c
+ *
+ * @brief   Streaming of the raw x/y/z samples over the serial port in CRC protected frames,
+ *          see sample_stream.h for the frame format.
+ *
+ * @details The acquisition thread fills a frame with SAMPLE_STREAM_BATCH samples and queues
+ *          it for sending. Frames are sent one at a time with TX DMA (stream_uart.c), the
+ *          next queued frame is started from the TX done interrupt. If no frame buffer is
+ *          free when a batch starts, the samples of that batch are dropped and counted; the
+ *          sample index in the frames shows the gap to the receiver.
+ *
+ *          Log output is sent in text frames from the log drain thread (log_async.c), which
+ *          waits for a buffer instead of dropping. It leaves one buffer free for samples.
+ *
+ * @author agent
+ * @license MIT
+ *
+ * Copyright agent, 2026
+ */
+
+#include "sample_stream.h"
+
+#if SAMPLE_STREAM
+
+#include <string.h>
+
+#include "cmsis_os2.h"
+#include "em_core.h"
+
+#include "checksum.h"
+
+#include "stream_uart.h"
+
+#define SAMPLE_STREAM_NONE      0xFF
+
+static uint8_t frames[SAMPLE_STREAM_BUFFERS][SAMPLE_STREAM_FRAME_MAX];
+static uint16_t frameLen[SAMPLE_STREAM_BUFFERS];
+
+// Free and queued frames, changed in critical sections
+static uint8_t freeList[SAMPLE_STREAM_BUFFERS];
+static uint8_t freeCount;
+static uint8_t txQueue[SAMPLE_STREAM_BUFFERS];
+static uint8_t txHead;
+static uint8_t txCount;
+static uint8_t txFrame = SAMPLE_STREAM_NONE;   // Frame being sent
+
+static uint8_t frameSeq;
+
+// Batch being filled by the acquisition thread
+static uint8_t fillFrame = SAMPLE_STREAM_NONE;
+static uint32_t fillCount;
+static uint32_t sampleIndex;
+
+static volatile uint32_t framesSent;
+static volatile uint32_t samplesDropped;
+
+static void sample_stream_tx_done(void);
+
+static void put_le16 (uint8_t * p, uint16_t v)
+{
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+}
+
+static void put_le32 (uint8_t * p, uint32_t v)
+{
+    put_le16(p, (uint16_t)v);
+    put_le16(p + 2, (uint16_t)(v >> 16));
+}
+
+/**
+ * @brief   Raise the baud rate and start streaming, call after RETARGET_SerialInit().
+ */
+void sample_stream_init (void)
+{
+    uint8_t i;
+
+    for (i = 0; i < SAMPLE_STREAM_BUFFERS; i++)
+    {
+        freeList[i] = i;
+    }
+    freeCount = SAMPLE_STREAM_BUFFERS;
+    stream_uart_init(SAMPLE_STREAM_BAUDRATE, sample_stream_tx_done);
+}
+
+/**
+ * @brief   Take a free frame if more than reserve frames are free.
+ */
+static uint8_t frame_get (uint8_t reserve)
+{
+    uint8_t f = SAMPLE_STREAM_NONE;
+    CORE_DECLARE_IRQ_STATE;
+
+    CORE_ENTER_CRITICAL();
+    if (freeCount > reserve)
+    {
+        f = freeList[--freeCount];
+    }
+    CORE_EXIT_CRITICAL();
+    return f;
+}
+
+/**
+ * @brief   Add header and CRC to a frame with len bytes of payload and queue it.
+ */
+static void frame_send (uint8_t f, uint8_t type, uint16_t len)
+{
+    uint8_t * p = frames[f];
+    CORE_DECLARE_IRQ_STATE;
+
+    p[0] = SAMPLE_STREAM_SYNC0;
+    p[1] = SAMPLE_STREAM_SYNC1;
+    p[2] = type;
+    put_le16(&p[4], len);
+    frameLen[f] = SAMPLE_STREAM_HDR_LEN + len + SAMPLE_STREAM_CRC_LEN;
+
+    CORE_ENTER_CRITICAL();
+    // Sequence in the order the frames go out, the CRC covers it
+    p[3] = frameSeq++;
+    put_le16(&p[SAMPLE_STREAM_HDR_LEN + len], crc_ccitt_ffff(&p[2], SAMPLE_STREAM_HDR_LEN - 2 + len));
+    if (txFrame == SAMPLE_STREAM_NONE)
+    {
+        txFrame = f;
+        stream_uart_send(p, frameLen[f]);
+    }
+    else
+    {
+        txQueue[(txHead + txCount) % SAMPLE_STREAM_BUFFERS] = f;
+        txCount++;
+    }
+    CORE_EXIT_CRITICAL();
+}
+
+/**
+ * @brief   Frame sent (interrupt), free it and start the next one.
+ */
+static void sample_stream_tx_done (void)
+{
+    freeList[freeCount++] = txFrame;
+    framesSent++;
+    if (txCount > 0)
+    {
+        txFrame = txQueue[txHead];
+        txHead = (txHead + 1) % SAMPLE_STREAM_BUFFERS;
+        txCount--;
+        stream_uart_send(frames[txFrame], frameLen[txFrame]);
+    }
+    else
+    {
+        txFrame = SAMPLE_STREAM_NONE;
+    }
+}
+
+/**
+ * @brief   Add a sample (acquisition thread), the frame is sent when the batch is full.
+ *
+ * @param   x, y, z Counts, -512 ... 511.
+ * @param   resolution Sample resolution in bits.
+ * @param   odrMhz Output data rate the sample was taken at.
+ */
+void sample_stream_add (int16_t x, int16_t y, int16_t z, uint8_t resolution, uint32_t odrMhz)
+{
+    uint8_t * p;
+
+    if (fillCount == 0)
+    {
+        fillFrame = frame_get(0);
+        if (fillFrame != SAMPLE_STREAM_NONE)
+        {
+            p = &frames[fillFrame][SAMPLE_STREAM_HDR_LEN];
+            put_le32(&p[0], sampleIndex);
+            put_le32(&p[4], (uint32_t)((uint64_t)osKernelGetTickCount() * 1000 / osKernelGetTickFreq()));
+            put_le32(&p[8], odrMhz);
+            p[13] = resolution;
+        }
+    }
+
+    if (fillFrame != SAMPLE_STREAM_NONE)
+    {
+        p = &frames[fillFrame][SAMPLE_STREAM_HDR_LEN + SAMPLE_STREAM_BATCH_HDR_LEN +
+                               (fillCount * SAMPLE_STREAM_SAMPLE_LEN)];
+        put_le32(p, ((uint32_t)x & 0x3FF) | (((uint32_t)y & 0x3FF) << 10) | (((uint32_t)z & 0x3FF) << 20));
+    }
+    else
+    {
+        samplesDropped++;
+    }
+    sampleIndex++;
+    fillCount++;
+
+    if (fillCount == SAMPLE_STREAM_BATCH)
+    {
+        if (fillFrame != SAMPLE_STREAM_NONE)
+        {
+            frames[fillFrame][SAMPLE_STREAM_HDR_LEN + 12] = SAMPLE_STREAM_BATCH;
+            frame_send(fillFrame, SAMPLE_STREAM_TYPE_SAMPLES, SAMPLE_STREAM_PAYLOAD_MAX);
+        }
+        fillFrame = SAMPLE_STREAM_NONE;
+        fillCount = 0;
+    }
+}
+
+/**
+ * @brief   log_output_f for log_async_init(), sends log output in text frames (log drain
+ *          thread). Waits for a free frame, one frame is always left for samples.
+ */
+int sample_stream_log (const char * ptr, int len)
+{
+    int sent = 0;
+
+    while (sent < len)
+    {
+        uint16_t n = (uint16_t)(((len - sent) < SAMPLE_STREAM_PAYLOAD_MAX) ? (len - sent) : SAMPLE_STREAM_PAYLOAD_MAX);
+        uint8_t f;
+
+        while ((f = frame_get(1)) == SAMPLE_STREAM_NONE)
+        {
+            osDelay(1);
+        }
+        memcpy(&frames[f][SAMPLE_STREAM_HDR_LEN], &ptr[sent], n);
+        frame_send(f, SAMPLE_STREAM_TYPE_TEXT, n);
+        sent += n;
+    }
+    return len;
+}
+
+/**
+ * @brief   Frames sent completely.
+ */
+uint32_t sample_stream_frames (void)
+{
+    return framesSent;
+}
+
+/**
+ * @brief   Samples dropped because no frame buffer was free.
+ */
+uint32_t sample_stream_dropped (void)
+{
+    return samplesDropped;
+}
+
+#endif // SAMPLE_STREAM
@@ -0,0 +1,60 @@
+/**
+ * @file sample_stream.h
+ *
+ * @brief   Streaming of the raw x/y/z samples over the serial port in CRC protected frames.
+ *
+ * @details Frame: SYNC0 SYNC1 type seq len(LE16) payload crc(LE16). seq counts frames
+ *          modulo 256, crc is CRC-CCITT (0xFFFF) over type, seq, len and payload.
+ *
+ *          Samples payload: index of the first sample (LE32, counts every sample given to
+ *          the stream, dropped ones included), time of the first sample in ms (LE32),
+ *          output data rate in mHz (LE32), sample count, resolution, then 4 bytes per
+ *          sample with x in bits 0-9, y in bits 10-19 and z in bits 20-29 (LE32, counts as
+ *          10 bit two's complement).
+ *
+ *          Text payload: log output. With the stream on, log output is sent in text frames
+ *          so that it does not break up the sample frames.
+ *
+ * @author agent
+ * @license MIT
+ *
+ * Copyright agent, 2026
+ */
+
+#ifndef SAMPLE_STREAM_H_
+#define SAMPLE_STREAM_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifndef SAMPLE_STREAM
+#define SAMPLE_STREAM                   0       // Set from the Makefile
+#endif
+
+#ifndef SAMPLE_STREAM_BAUDRATE
+#define SAMPLE_STREAM_BAUDRATE          921600  // Set from the Makefile
+#endif
+
+#define SAMPLE_STREAM_SYNC0             0xA5
+#define SAMPLE_STREAM_SYNC1             0x5A
+#define SAMPLE_STREAM_TYPE_SAMPLES      0x01
+#define SAMPLE_STREAM_TYPE_TEXT         0x02
+
+#define SAMPLE_STREAM_BATCH             16      // Samples per frame
+#define SAMPLE_STREAM_BUFFERS           4       // Frames being filled, queued or sent
+#define SAMPLE_STREAM_HDR_LEN           6
+#define SAMPLE_STREAM_CRC_LEN           2
+#define SAMPLE_STREAM_BATCH_HDR_LEN     14
+#define SAMPLE_STREAM_SAMPLE_LEN        4
+#define SAMPLE_STREAM_PAYLOAD_MAX       (SAMPLE_STREAM_BATCH_HDR_LEN + (SAMPLE_STREAM_BATCH * SAMPLE_STREAM_SAMPLE_LEN))
+#define SAMPLE_STREAM_FRAME_MAX         (SAMPLE_STREAM_HDR_LEN + SAMPLE_STREAM_PAYLOAD_MAX + SAMPLE_STREAM_CRC_LEN)
+
+// Public functions
+void sample_stream_init(void);
+void sample_stream_add(int16_t x, int16_t y, int16_t z, uint8_t resolution, uint32_t odrMhz);
+int sample_stream_log(const char * ptr, int len);
+
+uint32_t sample_stream_frames(void);
+uint32_t sample_stream_dropped(void);
+
+#endif // SAMPLE_STREAM_H_
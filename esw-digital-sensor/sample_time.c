@@ -0,0 +1,179 @@
+/**
+ * @file sample_time.c
+ *
+ * @brief   Sample timestamps from the RTCC and an estimator of the actual output data rate.
+ *
+ * @details Each interval between two stamps is compared with the configured data rate. An
+ *          interval of about k periods means k - 1 samples were missed (gaps), one shorter
+ *          than half a period means the same sample was taken twice or the interrupt fired
+ *          twice (duplicates). Single period intervals give the mean rate and the jitter
+ *          since the previous sample_time_stats() call. The long-term rate counts every
+ *          interval with its number of periods, so a missed sample does not bias it.
+ *
+ *          With 30.5 us ticks the jitter has a floor of about 9 us RMS.
+ *
+ * EFR32MG12 Wireless Gecko Reference Manual (RTCC p474)
+ * https://www.silabs.com/documents/public/reference-manuals/efr32xg12-rm.pdf
+ *
+ * @author agent
+ * @license MIT
+ *
+ * Copyright agent, 2026
+ */
+
+#include <math.h>
+
+#include "em_cmu.h"
+#include "em_core.h"
+
+#include "sample_time.h"
+
+#define SAMPLE_TIME_MIN_INTERVALS   8   // Before the long-term rate is reported
+
+static uint32_t lastStamp;
+static bool haveStamp;
+
+// Since the previous sample_time_stats(), Welford's running mean and variance in ticks
+static uint32_t intervals;
+static float mean;
+static float m2;
+static uint32_t minTicks;
+static uint32_t maxTicks;
+
+// Since start
+static uint64_t totalTicks;
+static uint32_t totalPeriods;
+static uint32_t gaps;
+static uint32_t duplicates;
+
+/**
+ * @brief   Start the RTCC counting at SAMPLE_TIME_HZ.
+ */
+void sample_time_init (void)
+{
+    RTCC_Init_TypeDef init = RTCC_INIT_DEFAULT;
+
+    CMU_OscillatorEnable(cmuOsc_LFXO, true, true);
+    CMU_ClockSelectSet(cmuClock_LFE, cmuSelect_LFXO);
+    CMU_ClockEnable(cmuClock_HFLE, true);
+    CMU_ClockEnable(cmuClock_RTCC, true);
+
+    init.presc = rtccCntPresc_1;
+    init.debugRun = true;
+    RTCC_Init(&init);
+}
+
+/**
+ * @brief   Account for the stamp of the next sample (acquisition thread).
+ *
+ * @param   stamp sample_time_now() at the data ready interrupt.
+ * @param   odrMhz Configured output data rate.
+ */
+void sample_time_update (uint32_t stamp, uint32_t odrMhz)
+{
+    uint32_t dt = stamp - lastStamp;
+    uint32_t periods = 1;
+    CORE_DECLARE_IRQ_STATE;
+
+    if (odrMhz != 0)
+    {
+        // Nearest whole number of periods
+        periods = (uint32_t)(((uint64_t)dt * odrMhz + (SAMPLE_TIME_HZ * 1000 / 2)) / (SAMPLE_TIME_HZ * 1000));
+    }
+
+    CORE_ENTER_CRITICAL();
+    if (haveStamp)
+    {
+        if ((periods == 0) && (odrMhz != 0))
+        {
+            duplicates++;
+        }
+        else
+        {
+            totalTicks += dt;
+            totalPeriods += periods;
+            if (periods > 1)
+            {
+                gaps += periods - 1;
+            }
+            else
+            {
+                float delta = (float)dt - mean;
+
+                intervals++;
+                mean += delta / intervals;
+                m2 += delta * ((float)dt - mean);
+                if ((intervals == 1) || (dt < minTicks))
+                {
+                    minTicks = dt;
+                }
+                if ((intervals == 1) || (dt > maxTicks))
+                {
+                    maxTicks = dt;
+                }
+            }
+        }
+    }
+    lastStamp = stamp;
+    haveStamp = true;
+    CORE_EXIT_CRITICAL();
+}
+
+/**
+ * @brief   Samples stopped for a while, do not count the pause as missing samples.
+ */
+void sample_time_restart (void)
+{
+    CORE_DECLARE_IRQ_STATE;
+
+    CORE_ENTER_CRITICAL();
+    haveStamp = false;
+    CORE_EXIT_CRITICAL();
+}
+
+/**
+ * @brief   Rate and jitter since the previous call, gaps and duplicates since start.
+ */
+void sample_time_stats (sample_time_stats_t * stats)
+{
+    uint32_t n;
+    float meanTicks, var;
+    uint32_t ppTicks;
+    CORE_DECLARE_IRQ_STATE;
+
+    CORE_ENTER_CRITICAL();
+    n = intervals;
+    meanTicks = mean;
+    var = (n > 1) ? m2 / (n - 1) : 0.0f;
+    ppTicks = (n > 0) ? maxTicks - minTicks : 0;
+    stats->gaps = gaps;
+    stats->duplicates = duplicates;
+    intervals = 0;
+    mean = m2 = 0.0f;
+    CORE_EXIT_CRITICAL();
+
+    stats->odrMhz = (n > 0) ? (uint32_t)(SAMPLE_TIME_HZ * 1000.0f / meanTicks + 0.5f) : 0;
+    stats->jitterRmsUs = (uint32_t)(sqrtf(var) * 1000000.0f / SAMPLE_TIME_HZ + 0.5f);
+    stats->jitterPpUs = (uint32_t)(((uint64_t)ppTicks * 1000000 + SAMPLE_TIME_HZ / 2) / SAMPLE_TIME_HZ);
+}
+
+/**
+ * @brief   Output data rate measured since start, 0 until a few samples have been stamped.
+ */
+uint32_t sample_time_odr_mhz (void)
+{
+    uint64_t ticks;
+    uint32_t periods;
+    CORE_DECLARE_IRQ_STATE;
+
+    CORE_ENTER_CRITICAL();
+    ticks = totalTicks;
+    periods = totalPeriods;
+    CORE_EXIT_CRITICAL();
+
+    if ((periods < SAMPLE_TIME_MIN_INTERVALS) || (ticks == 0))
+    {
+        return 0;
+    }
+    return (uint32_t)(((uint64_t)periods * SAMPLE_TIME_HZ * 1000 + ticks / 2) / ticks);
+}
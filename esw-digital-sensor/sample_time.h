@@ -0,0 +1,53 @@
+/**
+ * @file sample_time.h
+ *
+ * @brief   Sample timestamps from the RTCC and an estimator of the actual output data rate.
+ *
+ * @details The RTCC runs free at 32768 Hz from the LFXO, also in EM2, and wraps after 36
+ *          hours. Stamps are differences of the counter, one tick is 30.5 us.
+ *
+ * @author agent
+ * @license MIT
+ *
+ * Copyright agent, 2026
+ */
+
+#ifndef SAMPLE_TIME_H_
+#define SAMPLE_TIME_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "em_rtcc.h"
+
+#ifndef SAMPLE_TIME_CORRECT
+#define SAMPLE_TIME_CORRECT     0       // Set from the Makefile
+#endif
+
+#define SAMPLE_TIME_HZ          32768UL // Stamp ticks per second
+
+typedef struct
+{
+    uint32_t odrMhz;        // Mean rate over the intervals since the previous call, 0 if none
+    uint32_t jitterRmsUs;   // Standard deviation of those intervals
+    uint32_t jitterPpUs;    // Longest minus shortest of those intervals
+    uint32_t gaps;          // Samples missing between stamps, since start
+    uint32_t duplicates;    // Stamps less than half an interval after the previous one, since start
+} sample_time_stats_t;
+
+/**
+ * @brief   Timestamp for a sample, take it as early as possible in the data ready interrupt.
+ */
+static inline uint32_t sample_time_now (void)
+{
+    return RTCC_CounterGet();
+}
+
+// Public functions
+void sample_time_init(void);
+void sample_time_update(uint32_t stamp, uint32_t odrMhz);
+void sample_time_restart(void);
+void sample_time_stats(sample_time_stats_t * stats);
+uint32_t sample_time_odr_mhz(void);
+
+#endif // SAMPLE_TIME_H_
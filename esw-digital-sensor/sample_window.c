@@ -0,0 +1,242 @@
+/**
+ * @file sample_window.c
+ *
+ * @brief   Pool of analysis windows handed between the acquisition and the analysis thread.
+ *
+ * @details The acquisition thread fills one window while the analysis thread works on
+ *          another. Ownership is passed by pointer through two SPSC rings, full windows
+ *          go to the analysis thread and processed windows come back to the free ring,
+ *          sample data is never copied. Per-axis statistics are updated as each sample
+ *          is added, so they are ready when the window is handed over.
+ *
+ *          Windows have room for SAMPLE_WINDOW_LENGTH samples, the number of samples per
+ *          window can be changed at run time with sample_window_set_length() and applies
+ *          from the next window started. Analysis takes the length from the window count.
+ *
+ *          If the analysis thread still holds all other windows when a new window should
+ *          be started, incoming samples are dropped and every window length of dropped
+ *          samples counts as one missed window. Missed windows are counted as the samples
+ *          are dropped, with the length in effect then, so a later length change does
+ *          not change the count.
+ *
+ * @author agent
+ * @license MIT
+ *
+ * Copyright agent, 2026
+ */
+
+#include "spsc_ring.h"
+#include "sample_window.h"
+
+static sample_window_t windows[SAMPLE_WINDOW_DEPTH];
+static sample_window_t * freeStorage[SAMPLE_WINDOW_DEPTH];
+static sample_window_t * fullStorage[SAMPLE_WINDOW_DEPTH];
+static spsc_ring_t freeRing;    // Analysis -> acquisition
+static spsc_ring_t fullRing;    // Acquisition -> analysis
+
+static sample_window_t * fillWindow;   // Window being filled by the acquisition thread
+static uint16_t fillLength;            // Samples in fillWindow when full
+static uint32_t windowSeq;
+static volatile uint16_t windowLength; // For windows started from now on
+
+static volatile uint32_t swaps;     // Windows handed to analysis
+static volatile uint32_t dropped;   // Samples dropped for lack of a free window
+static volatile uint32_t missed;    // Window lengths of dropped samples
+static uint16_t missedPart;         // Dropped samples not yet counted in missed
+
+#if STAGE_TRACE
+static uint32_t nextTraceT0;        // Stamp of the sample about to be put
+#endif
+
+/**
+ * @brief   Initialize window pool, all windows are free.
+ *
+ * @param   tID Analysis thread, signalled when a full window is available.
+ * @param   tFlag Thread flag to set for tID.
+ */
+void sample_window_init (osThreadId_t tID, uint32_t tFlag)
+{
+    uint32_t i;
+
+    spsc_ring_init(&freeRing, freeStorage, SAMPLE_WINDOW_DEPTH, sizeof(sample_window_t *));
+    spsc_ring_init(&fullRing, fullStorage, SAMPLE_WINDOW_DEPTH, sizeof(sample_window_t *));
+    spsc_ring_set_notify(&fullRing, tID, tFlag, 1);
+
+    for (i = 0; i < SAMPLE_WINDOW_DEPTH; i++)
+    {
+        sample_window_t * w = &windows[i];
+        spsc_ring_push(&freeRing, &w);
+    }
+    fillWindow = NULL;
+    windowSeq = 0;
+    windowLength = SAMPLE_WINDOW_LENGTH;
+    swaps = dropped = missed = 0;
+    missedPart = 0;
+}
+
+/**
+ * @brief   Set the number of samples per window, any thread. The window being filled keeps
+ *          its length.
+ *
+ * @param   length Power of two, SAMPLE_WINDOW_MIN_LENGTH ... SAMPLE_WINDOW_LENGTH.
+ *
+ * @return  -1 if length is not allowed
+ *           0 otherwise
+ */
+int8_t sample_window_set_length (uint16_t length)
+{
+    if ((length < SAMPLE_WINDOW_MIN_LENGTH) || (length > SAMPLE_WINDOW_LENGTH) || ((length & (length - 1)) != 0))
+    {
+        return -1;
+    }
+    windowLength = length;
+    return 0;
+}
+
+/**
+ * @brief   Number of samples per window for windows started from now on.
+ */
+uint16_t sample_window_length (void)
+{
+    return windowLength;
+}
+
+/**
+ * @brief   Add a sample to the window being filled, hand the window to analysis when full
+ *          (acquisition thread).
+ *
+ * @return  false if the sample was dropped because no free window was available
+ */
+bool sample_window_put (int16_t x, int16_t y, int16_t z, uint8_t resolution)
+{
+    sample_window_t * w = fillWindow;
+
+    if (w == NULL)
+    {
+        if (!spsc_ring_pop(&freeRing, &w))
+        {
+            dropped++;
+            if (++missedPart >= windowLength)
+            {
+                missedPart = 0;
+                missed++;
+            }
+            return false;
+        }
+        w->seq = windowSeq++;
+        w->count = 0;
+        w->resolution = resolution;
+        fillLength = windowLength;
+        signal_stats_q_reset(&w->xStats);
+        signal_stats_q_reset(&w->yStats);
+        signal_stats_q_reset(&w->zStats);
+        fillWindow = w;
+    }
+
+    w->x[w->count] = x;
+    w->y[w->count] = y;
+    w->z[w->count] = z;
+#if STAGE_TRACE
+    w->traceT0 = nextTraceT0;
+#endif
+    w->count++;
+    signal_stats_q_add(&w->xStats, x);
+    signal_stats_q_add(&w->yStats, y);
+    signal_stats_q_add(&w->zStats, z);
+
+    if (w->count >= fillLength)
+    {
+        // Cannot fail, there are only SAMPLE_WINDOW_DEPTH windows.
+        spsc_ring_push(&fullRing, &w);
+        fillWindow = NULL;
+        swaps++;
+    }
+    return true;
+}
+
+/**
+ * @brief   Drop the samples of the window being filled, the next sample starts a window
+ *          (acquisition thread). For a break in the samples.
+ *
+ * @return  Number of samples dropped.
+ */
+uint32_t sample_window_discard (void)
+{
+    sample_window_t * w = fillWindow;
+    uint32_t n;
+
+    if (w == NULL)
+    {
+        return 0;
+    }
+    n = w->count;
+    w->count = 0;
+    signal_stats_q_reset(&w->xStats);
+    signal_stats_q_reset(&w->yStats);
+    signal_stats_q_reset(&w->zStats);
+    return n;
+}
+
+#if STAGE_TRACE
+/**
+ * @brief   Stamp of the sample given to the next sample_window_put() (acquisition thread).
+ */
+void sample_window_trace_t0 (uint32_t t0)
+{
+    nextTraceT0 = t0;
+}
+#endif
+
+/**
+ * @brief   Wait for a full window (analysis thread).
+ *
+ * @param   timeout Kernel ticks to wait.
+ *
+ * @return  Full window, NULL on timeout. Give it back with sample_window_release().
+ */
+sample_window_t * sample_window_wait (uint32_t timeout)
+{
+    sample_window_t * w;
+
+    if (!spsc_ring_pop(&fullRing, &w))
+    {
+        spsc_ring_wait(&fullRing, timeout);
+        if (!spsc_ring_pop(&fullRing, &w))
+        {
+            return NULL;
+        }
+    }
+    return w;
+}
+
+/**
+ * @brief   Return a processed window to the free pool (analysis thread).
+ */
+void sample_window_release (sample_window_t * w)
+{
+    spsc_ring_push(&freeRing, &w);
+}
+
+/**
+ * @brief   Number of windows handed from acquisition to analysis.
+ */
+uint32_t sample_window_swaps (void)
+{
+    return swaps;
+}
+
+/**
+ * @brief   Number of windows lost because analysis did not keep up.
+ */
+uint32_t sample_window_missed (void)
+{
+    return missed;
+}
+
+/**
+ * @brief   Number of samples lost because analysis did not keep up.
+ */
+uint32_t sample_window_dropped (void)
+{
+    return dropped;
+}
@@ -0,0 +1,62 @@
+/**
+ * @file sample_window.h
+ *
+ * @author agent
+ * @license MIT
+ *
+ * Copyright agent, 2026
+ */
+
+#ifndef SAMPLE_WINDOW_H_
+#define SAMPLE_WINDOW_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "cmsis_os2.h"
+#include "signal_stats.h"
+#include "stage_trace.h"
+
+#ifndef SAMPLE_WINDOW_LENGTH
+#define SAMPLE_WINDOW_LENGTH    32  // Longest analysis window, power of two, set from the Makefile
+#endif
+#define SAMPLE_WINDOW_MIN_LENGTH 8  // Shortest window, 2 * FFT_BANDS
+#define SAMPLE_WINDOW_DEPTH     2   // Number of windows (2 - ping-pong), must be a power of two
+
+typedef struct
+{
+    uint32_t seq;                       // Window sequence number, gaps mean missed windows
+    uint16_t count;                     // Samples in window
+    uint8_t resolution;                 // Valid bits of sensor data
+    int16_t x[SAMPLE_WINDOW_LENGTH];    // Counts, count of them valid
+    int16_t y[SAMPLE_WINDOW_LENGTH];
+    int16_t z[SAMPLE_WINDOW_LENGTH];
+    signal_stats_q_t xStats;            // Updated as samples are added
+    signal_stats_q_t yStats;
+    signal_stats_q_t zStats;
+#if STAGE_TRACE
+    uint32_t traceT0;                   // STAGE_TRACE_NOW() stamp of the last sample
+#endif
+} sample_window_t;
+
+// Public functions
+void sample_window_init(osThreadId_t tID, uint32_t tFlag);
+int8_t sample_window_set_length(uint16_t length);
+uint16_t sample_window_length(void);
+
+// Acquisition side
+bool sample_window_put(int16_t x, int16_t y, int16_t z, uint8_t resolution);
+uint32_t sample_window_discard(void);
+#if STAGE_TRACE
+void sample_window_trace_t0(uint32_t t0);
+#endif
+
+// Analysis side
+sample_window_t * sample_window_wait(uint32_t timeout);
+void sample_window_release(sample_window_t * w);
+
+uint32_t sample_window_swaps(void);
+uint32_t sample_window_missed(void);
+uint32_t sample_window_dropped(void);
+
+#endif // SAMPLE_WINDOW_H_
@@ -0,0 +1,108 @@
+/**
+ * @file scratch_arena.c
+ *
+ * @brief   Bump allocator for the scratch buffers of one processing step.
+ *
+ * @details Buffers are taken from a fixed block one after another and all given back at
+ *          once with scratch_arena_reset(), there is no per-buffer free. Stages that run
+ *          one after another share the block, so it is sized for the largest set of buffers
+ *          in use at the same time instead of the sum of every stage's worst case. The peak
+ *          counter tells how much of the block was needed.
+ *
+ *          An arena has one owner thread, the functions do not lock. The counters can be
+ *          read from other threads.
+ *
+ * @author agent
+ * @license MIT
+ *
+ * Copyright agent, 2026
+ */
+
+#include <stddef.h>
+
+#include "scratch_arena.h"
+
+/**
+ * @brief   Initialize arena, nothing allocated.
+ *
+ * @param   a Arena.
+ * @param   mem Memory for size bytes, aligned to SCRATCH_ARENA_ALIGN.
+ * @param   size Bytes.
+ *
+ * @return  -1 if mem is not aligned
+ *           0 otherwise
+ */
+int8_t scratch_arena_init (scratch_arena_t * a, void * mem, uint32_t size)
+{
+    if (((uintptr_t)mem % SCRATCH_ARENA_ALIGN) != 0)
+    {
+        return -1;
+    }
+
+    a->mem = mem;
+    a->size = size;
+    a->used = 0;
+    a->peak = 0;
+    a->failures = 0;
+    return 0;
+}
+
+/**
+ * @brief   Take a buffer from the arena, valid until the next scratch_arena_reset().
+ *
+ * @param   a Arena.
+ * @param   bytes Buffer size.
+ *
+ * @return  Buffer aligned to SCRATCH_ARENA_ALIGN, NULL if it does not fit
+ */
+void * scratch_arena_alloc (scratch_arena_t * a, uint32_t bytes)
+{
+    uint32_t need = SCRATCH_ARENA_BYTES(bytes);
+    void * p;
+
+    if (need > a->size - a->used)
+    {
+        a->failures++;
+        return NULL;
+    }
+
+    p = &a->mem[a->used];
+    a->used += need;
+    if (a->used > a->peak)
+    {
+        a->peak = a->used;
+    }
+    return p;
+}
+
+/**
+ * @brief   Give back all buffers taken from the arena.
+ */
+void scratch_arena_reset (scratch_arena_t * a)
+{
+    a->used = 0;
+}
+
+/**
+ * @brief   Size of the arena in bytes.
+ */
+uint32_t scratch_arena_size (const scratch_arena_t * a)
+{
+    return a->size;
+}
+
+/**
+ * @brief   Most bytes allocated between two resets since init.
+ */
+uint32_t scratch_arena_peak (const scratch_arena_t * a)
+{
+    return a->peak;
+}
+
+/**
+ * @brief   Number of allocations that did not fit since init.
+ */
+uint32_t scratch_arena_failures (const scratch_arena_t * a)
+{
+    return a->failures;
+}
@@ -0,0 +1,38 @@
+/**
+ * @file scratch_arena.h
+ *
+ * @author agent
+ * @license MIT
+ *
+ * Copyright agent, 2026
+ */
+
+#ifndef SCRATCH_ARENA_H_
+#define SCRATCH_ARENA_H_
+
+#include <stdint.h>
+
+#define SCRATCH_ARENA_ALIGN     8   // Bytes, every allocation starts at this alignment
+
+// Bytes an allocation takes from the arena, for sizing it
+#define SCRATCH_ARENA_BYTES(bytes) ((((bytes) + SCRATCH_ARENA_ALIGN - 1) / SCRATCH_ARENA_ALIGN) * SCRATCH_ARENA_ALIGN)
+
+typedef struct
+{
+    uint8_t * mem;
+    uint32_t size;          // Bytes
+    uint32_t used;          // Bytes allocated since the last reset
+    uint32_t peak;          // Most bytes allocated between two resets, since init
+    uint32_t failures;      // Allocations that did not fit, since init
+} scratch_arena_t;
+
+// Public functions
+int8_t scratch_arena_init(scratch_arena_t * a, void * mem, uint32_t size);
+void * scratch_arena_alloc(scratch_arena_t * a, uint32_t bytes);
+void scratch_arena_reset(scratch_arena_t * a);
+
+uint32_t scratch_arena_size(const scratch_arena_t * a);
+uint32_t scratch_arena_peak(const scratch_arena_t * a);
+uint32_t scratch_arena_failures(const scratch_arena_t * a);
+
+#endif // SCRATCH_ARENA_H_
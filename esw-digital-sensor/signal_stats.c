@@ -0,0 +1,130 @@
+/**
+ * @file signal_stats.c
+ *
+ * @brief   Single-pass mean, energy and variance of a sample stream.
+ *
+ * @details Samples are added one at a time in O(1), results can be read at any point,
+ *          so there is no processing spike at the end of a window. Accumulators are plain
+ *          structs, one per stream, the functions are reentrant.
+ *
+ *          Energy is calculated as the sum of squared deviations from the mean. It is small
+ *          if there is no signal (just measurement noise) and larger when a signal is
+ *          present. It indicates the presence or absence of a signal (and its relative
+ *          strength), not the actual energy in joules.
+ *          https://www.gaussianwaves.com/2013/12/power-and-energy-of-a-signal/
+ *
+ *          The floating point accumulator uses Welford's update of the running mean and
+ *          squared deviations, which does not lose precision when the mean is large
+ *          compared to the signal (e.g. gravity on one axis).
+ *
+ *          The fixed-point accumulator keeps exact integer sums instead. Integer sums do
+ *          not round, so sumSq - sum^2 / n has no cancellation error and is cheaper per
+ *          sample than a fixed-point Welford update. Results are Q16 (SIGNAL_STATS_Q
+ *          fractional bits), rounded toward zero. Up to SIGNAL_STATS_MAX_N samples of any
+ *          int16 value can be added.
+ *
+ * @author agent
+ * @license MIT
+ *
+ * Copyright agent, 2026
+ */
+
+#include "signal_stats.h"
+
+void signal_stats_q_reset (signal_stats_q_t * s)
+{
+    s->n = 0;
+    s->sum = 0;
+    s->sumSq = 0;
+}
+
+void signal_stats_q_add (signal_stats_q_t * s, int16_t x)
+{
+    s->n++;
+    s->sum += x;
+    s->sumSq += (int32_t)x * x;
+}
+
+/**
+ * @return  Mean in Q16, 0 if no samples.
+ */
+int32_t signal_stats_q_mean (const signal_stats_q_t * s)
+{
+    if (s->n == 0)
+    {
+        return 0;
+    }
+    return (int32_t)(((int64_t)s->sum * (1 << SIGNAL_STATS_Q)) / (int64_t)s->n);
+}
+
+/**
+ * @return  Sum of squared deviations from the mean in Q16, 0 if no samples.
+ */
+int64_t signal_stats_q_energy (const signal_stats_q_t * s)
+{
+    int64_t sq, q, r;
+
+    if (s->n == 0)
+    {
+        return 0;
+    }
+
+    // sumSq - sum^2 / n, the division is split into quotient and remainder to stay in 64 bits.
+    sq = (int64_t)s->sum * s->sum;
+    q = sq / s->n;
+    r = sq % s->n;
+    return ((s->sumSq - q) * (1 << SIGNAL_STATS_Q)) - ((r * (1 << SIGNAL_STATS_Q)) / s->n);
+}
+
+/**
+ * @return  Population variance in Q16, 0 if no samples.
+ */
+int64_t signal_stats_q_variance (const signal_stats_q_t * s)
+{
+    if (s->n == 0)
+    {
+        return 0;
+    }
+    return signal_stats_q_energy(s) / s->n;
+}
+
+void signal_stats_f_reset (signal_stats_f_t * s)
+{
+    s->n = 0;
+    s->mean = 0.0f;
+    s->m2 = 0.0f;
+}
+
+void signal_stats_f_add (signal_stats_f_t * s, float x)
+{
+    float delta = x - s->mean;
+
+    s->n++;
+    s->mean += delta / (float)s->n;
+    s->m2 += delta * (x - s->mean);
+}
+
+float signal_stats_f_mean (const signal_stats_f_t * s)
+{
+    return s->mean;
+}
+
+/**
+ * @return  Sum of squared deviations from the mean.
+ */
+float signal_stats_f_energy (const signal_stats_f_t * s)
+{
+    return s->m2;
+}
+
+/**
+ * @return  Population variance, 0 if no samples.
+ */
+float signal_stats_f_variance (const signal_stats_f_t * s)
+{
+    if (s->n == 0)
+    {
+        return 0.0f;
+    }
+    return s->m2 / (float)s->n;
+}
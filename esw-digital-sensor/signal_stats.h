@@ -0,0 +1,47 @@
+/**
+ * @file signal_stats.h
+ *
+ * @author agent
+ * @license MIT
+ *
+ * Copyright agent, 2026
+ */
+
+#ifndef SIGNAL_STATS_H_
+#define SIGNAL_STATS_H_
+
+#include <stdint.h>
+
+#define SIGNAL_STATS_Q          16      // Fractional bits of fixed-point results
+#define SIGNAL_STATS_MAX_N      65535   // Samples per fixed-point accumulator before sums may overflow
+
+// Fixed-point accumulator for int16 samples
+typedef struct
+{
+    uint32_t n;         // Number of samples
+    int32_t sum;        // Sum of samples
+    int64_t sumSq;      // Sum of squared samples
+} signal_stats_q_t;
+
+// Floating point accumulator (Welford)
+typedef struct
+{
+    uint32_t n;         // Number of samples
+    float mean;         // Running mean
+    float m2;           // Sum of squared deviations from the running mean
+} signal_stats_f_t;
+
+// Public functions
+void signal_stats_q_reset(signal_stats_q_t * s);
+void signal_stats_q_add(signal_stats_q_t * s, int16_t x);
+int32_t signal_stats_q_mean(const signal_stats_q_t * s);
+int64_t signal_stats_q_energy(const signal_stats_q_t * s);
+int64_t signal_stats_q_variance(const signal_stats_q_t * s);
+
+void signal_stats_f_reset(signal_stats_f_t * s);
+void signal_stats_f_add(signal_stats_f_t * s, float x);
+float signal_stats_f_mean(const signal_stats_f_t * s);
+float signal_stats_f_energy(const signal_stats_f_t * s);
+float signal_stats_f_variance(const signal_stats_f_t * s);
+
+#endif // SIGNAL_STATS_H_
@@ -0,0 +1,211 @@
+/**
+ * @file spsc_ring.c
+ *
+ * @brief   Lock-free single-producer/single-consumer ring of fixed size elements.
+ *
+ * @details The producer (typically an interrupt) writes into the slot returned by
+ *          spsc_ring_reserve() and publishes it with spsc_ring_commit(), so data can be
+ *          placed in the ring without copying (e.g. by DMA). The consumer thread is
+ *          signalled once per batch of elements instead of once per element, and can
+ *          wait with a timeout to pick up a partial batch.
+ *
+ *          head is written only by the producer, tail only by the consumer. Both are
+ *          free-running counters, capacity must be a power of two. Ordering between slot
+ *          contents and indices uses GCC __atomic builtins (acquire/release), which work
+ *          on the Cortex-M4 target and on the host.
+ *
+ * @author agent
+ * @license MIT
+ *
+ * Copyright agent, 2026
+ */
+
+#include <string.h>
+
+#include "spsc_ring.h"
+
+/**
+ * @brief   Initialize ring.
+ *
+ * @param   r Ring.
+ * @param   storage Memory for capacity * elemSize bytes.
+ * @param   capacity Number of elements, must be a power of two.
+ * @param   elemSize Size of one element in bytes.
+ *
+ * @return  -1 if capacity is not a power of two
+ *           0 otherwise
+ */
+int8_t spsc_ring_init (spsc_ring_t * r, void * storage, uint32_t capacity, uint32_t elemSize)
+{
+    if ((capacity == 0) || ((capacity & (capacity - 1)) != 0))
+    {
+        return -1;
+    }
+
+    memset(r, 0, sizeof(*r));
+    r->buf = storage;
+    r->mask = capacity - 1;
+    r->elemSize = elemSize;
+    r->batch = 1;
+    return 0;
+}
+
+/**
+ * @brief   Signal a consumer thread when elements are waiting.
+ *
+ * @param   tID Consumer thread, NULL to disable signalling.
+ * @param   tFlag Thread flag to set.
+ * @param   batch Signal when at least this many elements are waiting.
+ */
+void spsc_ring_set_notify (spsc_ring_t * r, osThreadId_t tID, uint32_t tFlag, uint32_t batch)
+{
+    r->consumerThreadId = tID;
+    r->consumerThreadFlag = tFlag;
+    r->batch = (batch == 0) ? 1 : batch;
+}
+
+/**
+ * @brief   Get the next free slot (producer).
+ *
+ * @return  Slot to fill, NULL if ring is full (counted as overrun).
+ */
+void * spsc_ring_reserve (spsc_ring_t * r)
+{
+    uint32_t head = r->prod.head;
+    uint32_t tail = __atomic_load_n(&r->cons.tail, __ATOMIC_ACQUIRE);
+
+    if ((head - tail) > r->mask)
+    {
+        r->prod.overruns++;
+        return NULL;
+    }
+    return &r->buf[(head & r->mask) * r->elemSize];
+}
+
+/**
+ * @brief   Publish the slot returned by spsc_ring_reserve() (producer).
+ */
+void spsc_ring_commit (spsc_ring_t * r)
+{
+    uint32_t head = r->prod.head + 1;
+    uint32_t count;
+
+    __atomic_store_n(&r->prod.head, head, __ATOMIC_RELEASE);
+
+    count = head - __atomic_load_n(&r->cons.tail, __ATOMIC_ACQUIRE);
+    if (count > r->prod.highWater)
+    {
+        r->prod.highWater = count;
+    }
+
+    if ((count >= r->batch) && !r->prod.notifyPending && (r->consumerThreadId != NULL))
+    {
+        r->prod.notifyPending = true;
+        osThreadFlagsSet(r->consumerThreadId, r->consumerThreadFlag);
+    }
+}
+
+/**
+ * @brief   Copy an element into the ring (producer).
+ *
+ * @return  false if ring is full
+ */
+bool spsc_ring_push (spsc_ring_t * r, const void * elem)
+{
+    void * slot = spsc_ring_reserve(r);
+
+    if (slot == NULL)
+    {
+        return false;
+    }
+    memcpy(slot, elem, r->elemSize);
+    spsc_ring_commit(r);
+    return true;
+}
+
+/**
+ * @brief   Get the oldest element without removing it (consumer).
+ *
+ * @return  Element, NULL if ring is empty.
+ */
+void * spsc_ring_peek (spsc_ring_t * r)
+{
+    uint32_t tail = r->cons.tail;
+    uint32_t head = __atomic_load_n(&r->prod.head, __ATOMIC_ACQUIRE);
+
+    if (head == tail)
+    {
+        return NULL;
+    }
+    return &r->buf[(tail & r->mask) * r->elemSize];
+}
+
+/**
+ * @brief   Remove the element returned by spsc_ring_peek() (consumer).
+ */
+void spsc_ring_release (spsc_ring_t * r)
+{
+    __atomic_store_n(&r->cons.tail, r->cons.tail + 1, __ATOMIC_RELEASE);
+}
+
+/**
+ * @brief   Copy the oldest element out of the ring (consumer).
+ *
+ * @return  false if ring is empty
+ */
+bool spsc_ring_pop (spsc_ring_t * r, void * elem)
+{
+    void * slot = spsc_ring_peek(r);
+
+    if (slot == NULL)
+    {
+        return false;
+    }
+    memcpy(elem, slot, r->elemSize);
+    spsc_ring_release(r);
+    return true;
+}
+
+/**
+ * @brief   Wait until a batch of elements is waiting or timeout expires (consumer).
+ *
+ * @note    The consumer should drain the ring after this returns, the producer signals
+ *          again only after that.
+ *
+ * @param   timeout Timeout in kernel ticks, osWaitForever to wait for a full batch.
+ *
+ * @return  Number of elements waiting.
+ */
+uint32_t spsc_ring_wait (spsc_ring_t * r, uint32_t timeout)
+{
+    if (spsc_ring_count(r) < r->batch)
+    {
+        osThreadFlagsWait(r->consumerThreadFlag, osFlagsWaitAny, timeout);
+    }
+    else
+    {
+        osThreadFlagsClear(r->consumerThreadFlag);
+    }
+    r->prod.notifyPending = false;
+    return spsc_ring_count(r);
+}
+
+uint32_t spsc_ring_count (spsc_ring_t * r)
+{
+    return __atomic_load_n(&r->prod.head, __ATOMIC_ACQUIRE) - __atomic_load_n(&r->cons.tail, __ATOMIC_ACQUIRE);
+}
+
+uint32_t spsc_ring_capacity (spsc_ring_t * r)
+{
+    return r->mask + 1;
+}
+
+uint32_t spsc_ring_high_water (spsc_ring_t * r)
+{
+    return r->prod.highWater;
+}
+
+uint32_t spsc_ring_overruns (spsc_ring_t * r)
+{
+    return r->prod.overruns;
+}
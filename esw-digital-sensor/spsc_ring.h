@@ -0,0 +1,70 @@
+/**
+ * @file spsc_ring.h
+ *
+ * @author agent
+ * @license MIT
+ *
+ * Copyright agent, 2026
+ */
+
+#ifndef SPSC_RING_H_
+#define SPSC_RING_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "cmsis_os2.h"
+
+#ifndef SPSC_RING_CACHE_LINE
+#define SPSC_RING_CACHE_LINE    32  // Producer and consumer indices are kept on separate lines
+#endif
+
+typedef struct
+{
+    // Producer side, written by the producer. notifyPending is the exception: the producer
+    // sets it when it signals the consumer, the consumer clears it in spsc_ring_wait().
+    struct
+    {
+        volatile uint32_t head;         // Next element to write
+        uint32_t overruns;              // Elements dropped because the ring was full
+        uint32_t highWater;             // Highest fill level seen
+        volatile bool notifyPending;    // Written by both sides, see above
+    } __attribute__((aligned(SPSC_RING_CACHE_LINE))) prod;
+
+    // Consumer side, written only by the consumer
+    struct
+    {
+        volatile uint32_t tail;         // Next element to read
+    } __attribute__((aligned(SPSC_RING_CACHE_LINE))) cons;
+
+    // Set up once at init
+    uint8_t * buf;
+    uint32_t mask;                      // Capacity - 1
+    uint32_t elemSize;
+    osThreadId_t consumerThreadId;
+    uint32_t consumerThreadFlag;
+    uint32_t batch;                     // Signal consumer when this many elements are waiting
+} spsc_ring_t;
+
+// Public functions
+int8_t spsc_ring_init(spsc_ring_t * r, void * storage, uint32_t capacity, uint32_t elemSize);
+void spsc_ring_set_notify(spsc_ring_t * r, osThreadId_t tID, uint32_t tFlag, uint32_t batch);
+
+// Producer
+void * spsc_ring_reserve(spsc_ring_t * r);
+void spsc_ring_commit(spsc_ring_t * r);
+bool spsc_ring_push(spsc_ring_t * r, const void * elem);
+
+// Consumer
+void * spsc_ring_peek(spsc_ring_t * r);
+void spsc_ring_release(spsc_ring_t * r);
+bool spsc_ring_pop(spsc_ring_t * r, void * elem);
+uint32_t spsc_ring_wait(spsc_ring_t * r, uint32_t timeout);
+
+// Either side
+uint32_t spsc_ring_count(spsc_ring_t * r);
+uint32_t spsc_ring_capacity(spsc_ring_t * r);
+uint32_t spsc_ring_high_water(spsc_ring_t * r);
+uint32_t spsc_ring_overruns(spsc_ring_t * r);
+
+#endif // SPSC_RING_H_
@@ -0,0 +1,198 @@
+/**
+ * @file stage_trace.c
+ *
+ * @brief   Per-stage latency tracing of the sample path with the DWT cycle counter.
+ *
+ * @details stage_trace_mark() can be called from interrupts and threads. It keeps the
+ *          event in a ring of the last STAGE_TRACE_EVENTS events (for inspection with a
+ *          debugger or stage_trace_dump_events()) and adds the latency to the histogram of
+ *          the stage. Histogram buckets are 4 per power of two (the two bits after the
+ *          leading one), so percentiles are within 25% of the true value while the whole
+ *          range of CYCCNT fits in STAGE_TRACE_BUCKETS counters per stage.
+ *
+ *          stage_trace_dump() logs count, min, median, 90th and 99th percentile and max
+ *          of every stage in microseconds. In the host simulation CYCCNT follows the host
+ *          clock.
+ *
+ * @author agent
+ * @license MIT
+ *
+ * Copyright agent, 2026
+ */
+
+#include "stage_trace.h"
+
+#if STAGE_TRACE
+
+#include <inttypes.h>
+#include <string.h>
+
+#include "em_device.h"
+#include "em_core.h"
+
+#include "loglevels.h"
+#define __MODUUL__ "trace"
+#define __LOG_LEVEL__ (LOG_LEVEL_main & BASE_LOG_LEVEL)
+#include "log.h"
+
+typedef struct
+{
+    uint32_t count;
+    uint32_t min;
+    uint32_t max;
+    uint32_t hist[STAGE_TRACE_BUCKETS];
+} stage_trace_hist_t;
+
+static stage_trace_event_t events[STAGE_TRACE_EVENTS];
+static uint32_t eventCount;
+static stage_trace_hist_t stageHist[STAGE_TRACE_STAGES];
+
+static const char * const stageNames[STAGE_TRACE_STAGES] = { "irq", "read", "wake", "window", "publish" };
+
+// 0 ... 3 map to themselves, larger values to 4 buckets per power of two
+static uint32_t bucket_of (uint32_t v)
+{
+    uint32_t msb;
+
+    if (v < 4)
+    {
+        return v;
+    }
+    msb = 31 - __CLZ(v);
+    return 4 * (msb - 1) + ((v >> (msb - 2)) & 3);
+}
+
+// Largest value in bucket b
+static uint32_t bucket_max (uint32_t b)
+{
+    uint32_t msb;
+
+    if (b < 4)
+    {
+        return b;
+    }
+    msb = b / 4 + 1;
+    return (((4 + (b & 3) + 1) << (msb - 2)) - 1);
+}
+
+void stage_trace_init (void)
+{
+    // Cycle counter, enabling it again does not disturb other users
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+    stage_trace_reset();
+}
+
+void stage_trace_reset (void)
+{
+    uint32_t s;
+    CORE_DECLARE_IRQ_STATE;
+
+    CORE_ENTER_ATOMIC();
+    memset(stageHist, 0, sizeof(stageHist));
+    for (s = 0; s < STAGE_TRACE_STAGES; s++)
+    {
+        stageHist[s].min = UINT32_MAX;
+    }
+    eventCount = 0;
+    CORE_EXIT_ATOMIC();
+}
+
+/**
+ * @brief   Record that a sample stamped at t0 (STAGE_TRACE_NOW()) reached stage.
+ */
+void stage_trace_mark (stage_trace_stage_t stage, uint32_t t0)
+{
+    uint32_t now = DWT->CYCCNT;
+    uint32_t latency = now - t0;
+    stage_trace_event_t * e;
+    stage_trace_hist_t * h = &stageHist[stage];
+    CORE_DECLARE_IRQ_STATE;
+
+    CORE_ENTER_ATOMIC();
+    e = &events[eventCount++ & (STAGE_TRACE_EVENTS - 1)];
+    e->t = now;
+    e->latency = latency;
+    e->stage = (uint8_t)stage;
+
+    h->count++;
+    h->hist[bucket_of(latency)]++;
+    if (latency < h->min)
+    {
+        h->min = latency;
+    }
+    if (latency > h->max)
+    {
+        h->max = latency;
+    }
+    CORE_EXIT_ATOMIC();
+}
+
+static uint32_t cycles_to_us (uint32_t cycles)
+{
+    return (uint32_t)(((uint64_t)cycles * 1000000) / SystemCoreClock);
+}
+
+// Upper bound of the bucket holding the pct percentile, at most max
+static uint32_t percentile (const stage_trace_hist_t * h, uint32_t pct)
+{
+    uint32_t rank = (uint32_t)(((uint64_t)h->count * pct + 99) / 100);
+    uint32_t seen = 0;
+    uint32_t b;
+
+    for (b = 0; b < STAGE_TRACE_BUCKETS; b++)
+    {
+        seen += h->hist[b];
+        if (seen >= rank)
+        {
+            return (bucket_max(b) < h->max) ? bucket_max(b) : h->max;
+        }
+    }
+    return h->max;
+}
+
+/**
+ * @brief   Log latency statistics of all stages, in microseconds since the sample was stamped.
+ */
+void stage_trace_dump (void)
+{
+    static stage_trace_hist_t h;    // Copy, too large for a thread stack
+    uint32_t s;
+    CORE_DECLARE_IRQ_STATE;
+
+    for (s = 0; s < STAGE_TRACE_STAGES; s++)
+    {
+        CORE_ENTER_ATOMIC();
+        h = stageHist[s];
+        CORE_EXIT_ATOMIC();
+
+        if (h.count == 0)
+        {
+            continue;
+        }
+        info1("%-7s n %"PRIu32" us min %"PRIu32" p50 %"PRIu32" p90 %"PRIu32" p99 %"PRIu32" max %"PRIu32,
+              stageNames[s], h.count, cycles_to_us(h.min), cycles_to_us(percentile(&h, 50)),
+              cycles_to_us(percentile(&h, 90)), cycles_to_us(percentile(&h, 99)), cycles_to_us(h.max));
+    }
+}
+
+/**
+ * @brief   Log the last STAGE_TRACE_EVENTS events, oldest first.
+ */
+void stage_trace_dump_events (void)
+{
+    stage_trace_event_t e;
+    uint32_t end = eventCount;
+    uint32_t i = (end > STAGE_TRACE_EVENTS) ? end - STAGE_TRACE_EVENTS : 0;
+    CORE_DECLARE_IRQ_STATE;
+
+    for (; i < end; i++)
+    {
+        CORE_ENTER_ATOMIC();
+        e = events[i & (STAGE_TRACE_EVENTS - 1)];
+        CORE_EXIT_ATOMIC();
+        info1("%10"PRIu32" %-7s +%"PRIu32" us", e.t, stageNames[e.stage], cycles_to_us(e.latency));
+    }
+}
+
+#endif // STAGE_TRACE
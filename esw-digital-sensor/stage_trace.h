@@ -0,0 +1,67 @@
+/**
+ * @file stage_trace.h
+ *
+ * @brief   Per-stage latency tracing of the sample path with the DWT cycle counter.
+ *
+ * @details Each sample is stamped when the data ready interrupt starts reading it
+ *          (STAGE_TRACE_NOW()). The stamp travels with the sample, later stages record the
+ *          cycles elapsed since then. With STAGE_TRACE=0 (the default) all macros are empty
+ *          and the trace fields are not compiled in.
+ *
+ * @author agent
+ * @license MIT
+ *
+ * Copyright agent, 2026
+ */
+
+#ifndef STAGE_TRACE_H_
+#define STAGE_TRACE_H_
+
+#include <stdint.h>
+
+#ifndef STAGE_TRACE
+#define STAGE_TRACE             0   // Set from the Makefile
+#endif
+
+#define STAGE_TRACE_EVENTS      64  // Last events kept in RAM, power of two
+#define STAGE_TRACE_BUCKETS     124 // Latency histogram buckets, 4 per power of two up to 2^32 cycles
+
+typedef enum
+{
+    STAGE_TRACE_IRQ,        // Data ready interrupt started the burst read
+    STAGE_TRACE_READ,       // Burst read complete, sample in acquisition ring
+    STAGE_TRACE_WAKE,       // Acquisition thread took the sample from the ring
+    STAGE_TRACE_WINDOW,     // Sample converted and stored in the analysis window
+    STAGE_TRACE_PUBLISH,    // Analysis of the window results logged (last sample of the window)
+    STAGE_TRACE_STAGES
+} stage_trace_stage_t;
+
+typedef struct
+{
+    uint32_t t;             // CYCCNT when the stage was reached
+    uint32_t latency;       // Cycles since the sample was stamped
+    uint8_t stage;
+} stage_trace_event_t;
+
+#if STAGE_TRACE
+
+#include "em_device.h"
+
+#define STAGE_TRACE_NOW()               (DWT->CYCCNT)
+#define STAGE_TRACE_MARK(stage, t0)     stage_trace_mark((stage), (t0))
+
+// Public functions
+void stage_trace_init(void);
+void stage_trace_mark(stage_trace_stage_t stage, uint32_t t0);
+void stage_trace_dump(void);
+void stage_trace_dump_events(void);
+void stage_trace_reset(void);
+
+#else
+
+#define STAGE_TRACE_NOW()               0
+#define STAGE_TRACE_MARK(stage, t0)     ((void)0)
+
+#endif // STAGE_TRACE
+
+#endif // STAGE_TRACE_H_
@@ -0,0 +1,107 @@
+/**
+ * @file stream_uart.c
+ *
+ * @brief   Frame transmission on the retarget serial USART with LDMA.
+ *
+ * @details RETARGET_SerialInit() sets the USART up, only the baud rate is raised here. LDMA
+ *          moves a frame to TXDATA on the TXBL request. The end of the frame is taken from
+ *          the USART TX complete interrupt instead of the LDMA done interrupt, so the
+ *          callback runs when the last byte is on the wire and LDMA_IRQHandler stays with
+ *          acq_ldma.
+ *
+ * @note    Nothing else may write to the USART while a frame is being sent, log output
+ *          goes through sample_stream_log() when the stream is on.
+ *
+ * EFR32MG12 Wireless Gecko Reference Manual (USART p548, LDMA p266)
+ * https://www.silabs.com/documents/public/reference-manuals/efr32xg12-rm.pdf
+ *
+ * @author agent
+ * @license MIT
+ *
+ * Copyright agent, 2026
+ */
+
+#include "sample_stream.h"
+
+#if SAMPLE_STREAM
+
+#include "em_cmu.h"
+#include "em_usart.h"
+#include "em_ldma.h"
+
+#include "stream_uart.h"
+
+// Retarget serial USART of tsb0
+#define STREAM_UART                 USART0
+#define STREAM_UART_TX_SIGNAL       ldmaPeripheralSignal_USART0_TXBL
+#define STREAM_UART_TX_IRQn         USART0_TX_IRQn
+#define STREAM_UART_TX_IRQHandler   USART0_TX_IRQHandler
+
+static stream_uart_done_f doneCb;
+static LDMA_TransferCfg_t ldmaCfg;
+static LDMA_Descriptor_t ldmaDesc;
+
+/**
+ * @brief   Set the baud rate and prepare LDMA, call after RETARGET_SerialInit().
+ *
+ * @param   baudrate Bits per second.
+ * @param   done Called from interrupt when a frame has been sent.
+ */
+void stream_uart_init (uint32_t baudrate, stream_uart_done_f done)
+{
+    LDMA_TransferCfg_t cfg = LDMA_TRANSFER_CFG_PERIPHERAL(STREAM_UART_TX_SIGNAL);
+    LDMA_Descriptor_t desc = LDMA_DESCRIPTOR_SINGLE_M2P_BYTE(NULL, &STREAM_UART->TXDATA, 1);
+
+    doneCb = done;
+
+    // 0 - use the current peripheral clock as reference
+    USART_BaudrateAsyncSet(STREAM_UART, 0, baudrate, usartOVS16);
+
+#if !MMA_ACQ_LDMA
+    // Otherwise acq_ldma_init() has done this
+    LDMA_Init_t init = LDMA_INIT_DEFAULT;
+
+    CMU_ClockEnable(cmuClock_LDMA, true);
+    LDMA_Init(&init);
+#endif
+
+    ldmaCfg = cfg;
+    ldmaDesc = desc;
+    ldmaDesc.xfer.doneIfs = 0;  // End of frame comes from USART TXC
+
+    USART_IntDisable(STREAM_UART, USART_IEN_TXC);
+    USART_IntClear(STREAM_UART, USART_IFC_TXC);
+    NVIC_ClearPendingIRQ(STREAM_UART_TX_IRQn);
+    NVIC_EnableIRQ(STREAM_UART_TX_IRQn);
+}
+
+/**
+ * @brief   Start sending a frame, the previous one must be done. buf must stay valid until
+ *          the done callback.
+ */
+void stream_uart_send (const uint8_t * buf, uint16_t len)
+{
+    ldmaDesc.xfer.srcAddr = (uint32_t)buf;
+    ldmaDesc.xfer.xferCnt = len - 1;    // xferCnt is count-1
+
+    USART_IntClear(STREAM_UART, USART_IFC_TXC);
+    LDMA_StartTransfer(STREAM_UART_LDMA_CHANNEL, &ldmaCfg, &ldmaDesc);
+    USART_IntEnable(STREAM_UART, USART_IEN_TXC);
+}
+
+void STREAM_UART_TX_IRQHandler (void)
+{
+    if (USART_IntGetEnabled(STREAM_UART) & USART_IF_TXC)
+    {
+        USART_IntClear(STREAM_UART, USART_IFC_TXC);
+
+        // TXC is also set if LDMA falls behind in the middle of a frame
+        if (LDMA_TransferDone(STREAM_UART_LDMA_CHANNEL))
+        {
+            USART_IntDisable(STREAM_UART, USART_IEN_TXC);
+            doneCb();
+        }
+    }
+}
+
+#endif // SAMPLE_STREAM
@@ -0,0 +1,26 @@
+/**
+ * @file stream_uart.h
+ *
+ * @brief   Frame transmission on the retarget serial USART with LDMA.
+ *
+ * @author agent
+ * @license MIT
+ *
+ * Copyright agent, 2026
+ */
+
+#ifndef STREAM_UART_H_
+#define STREAM_UART_H_
+
+#include <stdint.h>
+
+#define STREAM_UART_LDMA_CHANNEL    1   // Channel 0 is used by acq_ldma
+
+// Called from interrupt when the last byte of a frame has been sent
+typedef void (*stream_uart_done_f)(void);
+
+// Public functions
+void stream_uart_init(uint32_t baudrate, stream_uart_done_f done);
+void stream_uart_send(const uint8_t * buf, uint16_t len);
+
+#endif // STREAM_UART_H_
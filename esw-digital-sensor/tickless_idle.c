@@ -0,0 +1,279 @@
+/**
+ * @file tickless_idle.c
+ *
+ * @brief   RTOS tick from the RTCC and tickless idle in EM2.
+ *
+ * @details Built with configUSE_TICKLESS_IDLE=1 and configOVERRIDE_DEFAULT_TICK_CONFIGURATION=1,
+ *          the FreeRTOS port then takes vPortSetupTimerInterrupt() and
+ *          vPortSuppressTicksAndSleep() from here. The RTCC is shared with sample_time.c,
+ *          it must be running (sample_time_init()) before the kernel starts and its counter
+ *          is never written.
+ *
+ *          The tick interrupt counts every tick boundary the counter has passed since the
+ *          last counted one, so a late interrupt or a sleep that overran its compare loses no
+ *          time. In idle the compare is moved to the tick the kernel wants to run at next,
+ *          after waking the kernel is stepped by the ticks that have passed, up to one less
+ *          than expected: the last one is left to the tick interrupt, which unblocks the
+ *          waiting task. Interrupts are masked while sleeping, the core still wakes on them
+ *          and their handlers run once the tick count is right.
+ *
+ *          The clock functions are independent of the hardware and the kernel, the host
+ *          build checks the sleep and tick logic against a simulated RTCC with them
+ *          (host/tickless_sim.c).
+ *
+ * EFR32MG12 Wireless Gecko Reference Manual (EMU p151, RTCC p474)
+ * https://www.silabs.com/documents/public/reference-manuals/efr32xg12-rm.pdf
+ * FreeRTOS low power support
+ * https://www.freertos.org/low-power-tickless-rtos.html
+ *
+ * @author agent
+ * @license MIT
+ *
+ * Copyright agent, 2026
+ */
+
+#include <stdbool.h>
+
+#include "tickless_idle.h"
+
+void tickless_clock_init (tickless_clock_t * clock, uint32_t cnt, uint32_t tickHz)
+{
+    clock->cnt = cnt;
+    clock->frac = 0;
+    clock->tickHz = tickHz;
+}
+
+/**
+ * @brief   Counter value of the tick ticks after the last counted one.
+ */
+uint32_t tickless_clock_at (const tickless_clock_t * clock, uint32_t ticks)
+{
+    return clock->cnt + (uint32_t)((clock->frac + (uint64_t)ticks * TICKLESS_CLOCK_HZ) / clock->tickHz);
+}
+
+/**
+ * @brief   Ticks whose counter value has been reached at cnt, since the last counted one.
+ */
+uint32_t tickless_clock_elapsed (const tickless_clock_t * clock, uint32_t cnt)
+{
+    uint64_t d = (uint64_t)(cnt - clock->cnt) + 1;
+
+    return (uint32_t)((d * clock->tickHz - clock->frac - 1) / TICKLESS_CLOCK_HZ);
+}
+
+/**
+ * @brief   Count ticks, the fraction of a counter step is carried.
+ */
+void tickless_clock_advance (tickless_clock_t * clock, uint32_t ticks)
+{
+    uint64_t t = clock->frac + (uint64_t)ticks * TICKLESS_CLOCK_HZ;
+
+    clock->cnt += (uint32_t)(t / clock->tickHz);
+    clock->frac = (uint32_t)(t % clock->tickHz);
+}
+
+#if TICKLESS_IDLE
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include "em_device.h"
+#include "em_core.h"
+#include "em_emu.h"
+#include "em_rtcc.h"
+#include "em_usart.h"
+
+#define TICKLESS_UART           USART0  // Retarget serial USART of tsb0, log output and sample stream
+#define TICKLESS_COMPARE_AHEAD  2       // Counts a compare must be ahead of the counter to match
+
+static tickless_clock_t tickClock;
+static volatile uint32_t em2Blocks;
+
+static uint32_t tickIrqs;
+static uint32_t sleeps;
+static uint32_t em2Sleeps;
+static uint32_t suppressed;
+static uint32_t sleepCounts;
+static uint32_t timerWakes;
+static uint32_t latencyWakes;       // Since the previous tickless_stats()
+static uint32_t latencyTotal;
+static uint32_t latencyMax;
+
+// Compare on counter value cnt or, if that is too close to match for sure, a little later.
+// The tick interrupt counts the ticks it finds passed, so a late compare loses no time.
+static void compare_set (uint32_t cnt)
+{
+    uint32_t now = RTCC_CounterGet();
+
+    if ((int32_t)(cnt - now) < TICKLESS_COMPARE_AHEAD)
+    {
+        cnt = now + TICKLESS_COMPARE_AHEAD;
+    }
+    RTCC_ChannelCCVSet(TICKLESS_RTCC_CHANNEL, cnt);
+}
+
+/**
+ * @brief   Start the tick, called by the kernel when the scheduler starts.
+ */
+void vPortSetupTimerInterrupt (void)
+{
+    RTCC_CCChConf_TypeDef compare = RTCC_CH_INIT_COMPARE_DEFAULT;
+
+    RTCC_ChannelInit(TICKLESS_RTCC_CHANNEL, &compare);
+    tickless_clock_init(&tickClock, RTCC_CounterGet(), configTICK_RATE_HZ);
+
+    RTCC_IntClear(RTCC_IF_CC1);
+    compare_set(tickless_clock_at(&tickClock, 1));
+    RTCC_IntEnable(RTCC_IEN_CC1);
+
+    // Lowest priority like SysTick, the kernel may be entered from here
+    NVIC_ClearPendingIRQ(RTCC_IRQn);
+    NVIC_SetPriority(RTCC_IRQn, (1UL << __NVIC_PRIO_BITS) - 1);
+    NVIC_EnableIRQ(RTCC_IRQn);
+}
+
+void RTCC_IRQHandler (void)
+{
+    UBaseType_t mask;
+    BaseType_t switchNeeded = pdFALSE;
+    uint32_t n;
+
+    RTCC_IntClear(RTCC_IF_CC1);
+
+    mask = portSET_INTERRUPT_MASK_FROM_ISR();
+    n = tickless_clock_elapsed(&tickClock, RTCC_CounterGet());
+    tickless_clock_advance(&tickClock, n);
+    compare_set(tickless_clock_at(&tickClock, 1));
+    tickIrqs++;
+    while (n > 0)
+    {
+        if (xTaskIncrementTick() != pdFALSE)
+        {
+            switchNeeded = pdTRUE;
+        }
+        n--;
+    }
+    portCLEAR_INTERRUPT_MASK_FROM_ISR(mask);
+
+    portYIELD_FROM_ISR(switchNeeded);
+}
+
+/**
+ * @brief   Sleep through the idle time, called by the idle task with the scheduler suspended.
+ *
+ * @param   xExpectedIdleTime Ticks until a task times out.
+ */
+void vPortSuppressTicksAndSleep (TickType_t xExpectedIdleTime)
+{
+    uint32_t expected = xExpectedIdleTime;
+    uint32_t wakeCnt, sleepCnt, now, n;
+
+    if (expected > TICKLESS_MAX_IDLE_TICKS)
+    {
+        expected = TICKLESS_MAX_IDLE_TICKS;
+    }
+
+    __disable_irq();
+    __DSB();
+    __ISB();
+
+    // A tick or a task made ready since the idle task decided to sleep
+    if ((RTCC_IntGet() & RTCC_IF_CC1) || (eTaskConfirmSleepModeStatus() == eAbortSleep))
+    {
+        __enable_irq();
+        return;
+    }
+
+    wakeCnt = tickless_clock_at(&tickClock, expected);
+    compare_set(wakeCnt);
+
+    sleepCnt = RTCC_CounterGet();
+    if ((em2Blocks == 0) && (USART_StatusGet(TICKLESS_UART) & USART_STATUS_TXIDLE))
+    {
+        EMU_EnterEM2(true);
+        em2Sleeps++;
+    }
+    else
+    {
+        EMU_EnterEM1();
+    }
+    now = RTCC_CounterGet();
+
+    n = tickless_clock_elapsed(&tickClock, now);
+    if (n >= expected)
+    {
+        // The tick interrupt counts the last tick and any after it
+        uint32_t latency = now - wakeCnt;
+
+        n = expected - 1;
+        RTCC_IntSet(RTCC_IF_CC1);
+        timerWakes++;
+        latencyWakes++;
+        latencyTotal += latency;
+        if (latency > latencyMax)
+        {
+            latencyMax = latency;
+        }
+    }
+    tickless_clock_advance(&tickClock, n);
+    if (n < expected - 1)
+    {
+        // Woken early, back to one tick at a time
+        compare_set(tickless_clock_at(&tickClock, 1));
+    }
+    vTaskStepTick(n);
+
+    sleeps++;
+    suppressed += n;
+    sleepCounts += now - sleepCnt;
+
+    __enable_irq();
+}
+
+/**
+ * @brief   Keep the idle task out of EM2, while a high frequency peripheral is in use.
+ *          Calls nest, can be called from interrupt context.
+ */
+void tickless_em2_block (void)
+{
+    CORE_DECLARE_IRQ_STATE;
+
+    CORE_ENTER_ATOMIC();
+    em2Blocks++;
+    CORE_EXIT_ATOMIC();
+}
+
+void tickless_em2_unblock (void)
+{
+    CORE_DECLARE_IRQ_STATE;
+
+    CORE_ENTER_ATOMIC();
+    if (em2Blocks > 0)
+    {
+        em2Blocks--;
+    }
+    CORE_EXIT_ATOMIC();
+}
+
+/**
+ * @brief   Counters since start, wake-up latency since the previous call.
+ */
+void tickless_stats (tickless_stats_t * stats)
+{
+    CORE_DECLARE_IRQ_STATE;
+
+    CORE_ENTER_ATOMIC();
+    stats->ticks = tickIrqs;
+    stats->sleeps = sleeps;
+    stats->em2Sleeps = em2Sleeps;
+    stats->suppressed = suppressed;
+    stats->sleepCounts = sleepCounts;
+    stats->timerWakes = timerWakes;
+    stats->wakeLatencyMaxUs = (uint32_t)((uint64_t)latencyMax * 1000000 / TICKLESS_CLOCK_HZ);
+    stats->wakeLatencyMeanUs = (latencyWakes > 0) ?
+        (uint32_t)((uint64_t)latencyTotal * 1000000 / TICKLESS_CLOCK_HZ / latencyWakes) : 0;
+    latencyWakes = latencyTotal = latencyMax = 0;
+    CORE_EXIT_ATOMIC();
+}
+
+#endif // TICKLESS_IDLE
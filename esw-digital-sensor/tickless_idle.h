@@ -0,0 +1,81 @@
+/**
+ * @file tickless_idle.h
+ *
+ * @brief   RTOS tick from the RTCC and tickless idle in EM2.
+ *
+ * @details With TICKLESS_IDLE=1 the FreeRTOS tick comes from RTCC compare channel 1 instead
+ *          of SysTick. When the idle task runs, the ticks until the next timeout are
+ *          suppressed: the compare is moved to the end of the idle time and the core sleeps
+ *          in EM2, where the RTCC keeps counting and GPIO edges (sensor INT1) still wake it.
+ *          After waking, the kernel tick count is stepped by the whole ticks slept.
+ *
+ *          EM2 stops the high frequency peripherals. While one of them is busy the idle task
+ *          sleeps in EM1: I2C transfers and claims (i2c_handler.c) and other users block EM2
+ *          with tickless_em2_block(), the serial port is checked for transmission in progress.
+ *
+ *          With TICKLESS_IDLE=0 the block calls compile to nothing and the FreeRTOS port
+ *          runs the SysTick tick with EM1 sleep in idle.
+ *
+ * @author agent
+ * @license MIT
+ *
+ * Copyright agent, 2026
+ */
+
+#ifndef TICKLESS_IDLE_H_
+#define TICKLESS_IDLE_H_
+
+#include <stdint.h>
+
+#ifndef TICKLESS_IDLE
+#define TICKLESS_IDLE               0       // Set from the Makefile
+#endif
+
+#define TICKLESS_CLOCK_HZ           32768UL // RTCC, the counter of sample_time.h
+#define TICKLESS_RTCC_CHANNEL       1
+#define TICKLESS_MAX_IDLE_TICKS     60000   // Longest sleep, well within half the counter range
+
+/**
+ * @brief   Position of the last counted RTOS tick on the RTCC. A tick is a non-integer
+ *          number of counts (32.768 at 1000 Hz), the fraction is carried so the RTOS time
+ *          does not drift from the RTCC.
+ */
+typedef struct
+{
+    uint32_t cnt;           // Count at or just before the tick
+    uint32_t frac;          // Rest of the tick position in 1/tickHz counts, 0...tickHz-1
+    uint32_t tickHz;
+} tickless_clock_t;
+
+typedef struct
+{
+    uint32_t ticks;             // Tick interrupts
+    uint32_t sleeps;            // Idle sleeps, EM2 and EM1
+    uint32_t em2Sleeps;
+    uint32_t suppressed;        // Ticks that passed without an interrupt
+    uint32_t sleepCounts;       // RTCC counts asleep
+    uint32_t wakeLatencyMaxUs;  // Compare to running again, timer wakes since the previous call
+    uint32_t wakeLatencyMeanUs;
+    uint32_t timerWakes;        // Sleep ended at the expected time
+} tickless_stats_t;
+
+void tickless_clock_init(tickless_clock_t * clock, uint32_t cnt, uint32_t tickHz);
+uint32_t tickless_clock_at(const tickless_clock_t * clock, uint32_t ticks);
+uint32_t tickless_clock_elapsed(const tickless_clock_t * clock, uint32_t cnt);
+void tickless_clock_advance(tickless_clock_t * clock, uint32_t ticks);
+
+#if TICKLESS_IDLE
+
+// Public functions
+void tickless_em2_block(void);
+void tickless_em2_unblock(void);
+void tickless_stats(tickless_stats_t * stats);
+
+#else
+
+#define tickless_em2_block()        ((void)0)
+#define tickless_em2_unblock()      ((void)0)
+
+#endif // TICKLESS_IDLE
+
+#endif // TICKLESS_IDLE_H_